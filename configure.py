@@ -1125,6 +1125,12 @@ def _tests(cfg):
     return ["$(MESON) " + _cmd_join("test", "-C", _get_builddir(cfg, "tests"))]
 
 
+@_block("bench", [_ngl_tools_install])
+def _bench(cfg):
+    ngl_bench = op.join(cfg.venv_bin_path, "ngl-bench")
+    return [_cmd_join(ngl_bench, "-o", op.join(_get_builddir(cfg, "ngl-tools"), "bench.json"))]
+
+
 @_block("htmldoc-deps-install")
 def _htmldoc_deps_install(cfg):
     return ["$(PIP) " + _cmd_join("install", "-r", op.join(".", "doc", "requirements.txt"))]
@@ -1478,6 +1484,7 @@ def _run():
     if _is_local(cfg.host):
         blocks += [
             _tests,
+            _bench,
             _nopegl_updatedoc,
             _nopegl_updatespecs,
             _nopegl_updateglwrappers,
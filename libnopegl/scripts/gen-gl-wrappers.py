@@ -47,6 +47,8 @@ cmds_optional = [
     "glBufferStorageEXT",
     # GL_KHR_Debug
     "glDebugMessageCallback",
+    # GL_KHR_parallel_shader_compile
+    "glMaxShaderCompilerThreadsKHR",
     # GL_ARB_timer_query
     "glBeginQuery",
     "glEndQuery",
@@ -38,6 +38,7 @@
 #endif
 
 #include "distmap.h"
+#include "distmap_cache.h"
 #include "internal.h"
 #include "log.h"
 #include "math_utils.h"
@@ -66,6 +67,8 @@ NGLI_STATIC_ASSERT(sizeof(enum ngl_capture_buffer_type) == sizeof(int32_t), "32-
 # define DEFAULT_BACKEND NGL_BACKEND_OPENGL
 #endif
 
+#define NB_PREFETCH_WORKERS 2
+
 extern const struct api_impl api_gl;
 extern const struct api_impl api_vk;
 
@@ -224,6 +227,7 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 static void reset_scene(struct ngl_ctx *s, int action)
 {
     ngli_hud_freep(&s->hud);
+    ngli_gpu_timings_freep(&s->gpu_timings);
     if (s->scene) {
         ngli_node_detach_ctx(s->scene->params.root, s);
         if (action == NGLI_ACTION_UNREF_SCENE)
@@ -263,6 +267,9 @@ static struct ngpu_viewport compute_scene_viewport(const struct ngl_scene *scene
 int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
 {
     ngpu_ctx_wait_idle(s->gpu_ctx);
+
+    /* Keep the distance maps of the previous scene available to the new one */
+    ngli_distmap_cache_hold(s->distmap_cache);
     reset_scene(s, NGLI_ACTION_UNREF_SCENE);
 
     ngli_rnode_init(&s->rnode);
@@ -271,8 +278,10 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
     s->rnode_pos->rendertarget_layout = *ngpu_ctx_get_default_rendertarget_layout(s->gpu_ctx);
 
     int ret = ngpu_ctx_begin_update(s->gpu_ctx);
-    if (ret < 0)
+    if (ret < 0) {
+        ngli_distmap_cache_purge(s->distmap_cache);
         return ret;
+    }
 
     if (scene) {
         if (!scene->params.root) {
@@ -303,6 +312,18 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
     s->scissor = (struct ngpu_scissor){0, 0, width, height};
 
     const struct ngl_config *config = &s->config;
+    if (config->gpu_timings && (s->gpu_ctx->features & NGPU_FEATURE_TIMESTAMP_QUERY)) {
+        s->gpu_timings = ngli_gpu_timings_create(s);
+        if (!s->gpu_timings) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+
+        ret = ngli_gpu_timings_init(s->gpu_timings);
+        if (ret < 0)
+            goto fail;
+    }
+
     if (config->hud) {
         s->hud = ngli_hud_create(s);
         if (!s->hud) {
@@ -315,12 +336,23 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
             goto fail;
     }
 
+    /* Drop the distance maps of the previous scene not used by the new one */
+    ret = ngli_distmap_cache_purge(s->distmap_cache);
+    if (ret < 0)
+        goto fail;
+
+    /* Pipelines are compiled concurrently while the scene is being prepared */
+    ret = ngpu_ctx_wait_pipelines(s->gpu_ctx);
+    if (ret < 0)
+        goto fail;
+
     ngpu_ctx_end_update(s->gpu_ctx);
     return 0;
 
 fail:
     ngpu_ctx_end_update(s->gpu_ctx);
     reset_scene(s, NGLI_ACTION_UNREF_SCENE);
+    ngli_distmap_cache_purge(s->distmap_cache);
     return ret;
 }
 
@@ -336,6 +368,11 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
     ngli_android_ctx_reset(&s->android_ctx);
 #endif
     ngli_hmap_freep(&s->text_builtin_atlasses);
+    ngli_distmap_cache_freep(&s->distmap_cache);
+    ngli_rtt_pool_freep(&s->rtt_pool);
+    ngli_texture_pool_freep(&s->texture_pool);
+    ngli_workpool_freep(&s->prefetch_workpool);
+    ngli_media_cache_freep(&s->media_cache);
 #if HAVE_TEXT_LIBRARIES
     FT_Done_FreeType(s->ft_library);
 #endif
@@ -361,6 +398,16 @@ int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config)
     if (ret < 0)
         return ret;
 
+    /* The tracer outlives the configurations so the timeline is kept intact
+     * across reconfigurations of the context */
+    if (s->config.trace_filename && !s->tracer) {
+        s->tracer = ngli_tracer_create(s->config.trace_filename);
+        if (!s->tracer) {
+            ngli_config_reset(&s->config);
+            return NGL_ERROR_MEMORY;
+        }
+    }
+
     s->gpu_ctx = ngpu_ctx_create(&s->config);
     if (!s->gpu_ctx) {
         ngli_config_reset(&s->config);
@@ -382,6 +429,16 @@ int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config)
     }
     ngli_hmap_set_free_func(s->text_builtin_atlasses, ngli_free_text_builtin_atlas, NULL);
 
+    s->texture_pool = ngli_texture_pool_create(s);
+    s->rtt_pool = ngli_rtt_pool_create(s);
+    s->prefetch_workpool = ngli_workpool_create(NB_PREFETCH_WORKERS);
+    s->media_cache = ngli_media_cache_create();
+    s->distmap_cache = ngli_distmap_cache_create();
+    if (!s->texture_pool || !s->rtt_pool || !s->prefetch_workpool || !s->media_cache || !s->distmap_cache) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
 #if HAVE_TEXT_LIBRARIES
     FT_Error ft_error = FT_Init_FreeType(&s->ft_library);
     if (ft_error) {
@@ -469,9 +526,10 @@ int ngli_ctx_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return 0;
 }
 
-int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
+static int prepare_draw(struct ngl_ctx *s, double t)
 {
-    const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
+    const int measure_times = s->hud || s->config.stats;
+    const int64_t start_time = measure_times ? ngli_gettime_relative() : 0;
 
     uint32_t frame_index = ngpu_ctx_advance_frame(s->gpu_ctx);
     LOG(DEBUG, "start frame @ index=%u t=%f", frame_index, t);
@@ -488,7 +546,9 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     struct ngl_node *root = scene->params.root;
     LOG(DEBUG, "prepare scene %s @ t=%f", root->label, t);
 
+    const int64_t trace_start = ngli_tracer_begin(s->tracer);
     ret = ngli_node_honor_release_prefetch(root, t);
+    ngli_tracer_end(s->tracer, "honor_release_prefetch", NULL, trace_start);
     if (ret < 0)
         return ret;
 
@@ -500,22 +560,42 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
-    s->cpu_update_time = s->hud ? ngli_gettime_relative() - start_time : 0;
+    s->cpu_update_time = measure_times ? ngli_gettime_relative() - start_time : 0;
 
     return 0;
 }
 
+int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
+{
+    const int64_t trace_start = ngli_tracer_begin(s->tracer);
+    int ret = prepare_draw(s, t);
+    ngli_tracer_end(s->tracer, "prepare_draw", NULL, trace_start);
+    return ret;
+}
+
 int ngli_ctx_draw(struct ngl_ctx *s, double t)
 {
     int ret = ngli_ctx_prepare_draw(s, t);
     if (ret < 0)
         return ret;
 
+    const int64_t trace_start = ngli_tracer_begin(s->tracer);
     ret = ngpu_ctx_begin_draw(s->gpu_ctx);
+    ngli_tracer_end(s->tracer, "begin_draw", NULL, trace_start);
     if (ret < 0)
         return ret;
 
-    const int64_t cpu_start_time = s->hud ? ngli_gettime_relative() : 0;
+    ngli_texture_pool_begin_frame(s->texture_pool);
+    ngli_rtt_pool_begin_frame(s->rtt_pool);
+
+    if (s->gpu_timings) {
+        ret = ngli_gpu_timings_begin_frame(s->gpu_timings);
+        if (ret < 0)
+            return ret;
+    }
+
+    const int measure_times = s->hud || s->config.stats;
+    const int64_t cpu_start_time = measure_times ? ngli_gettime_relative() : 0;
 
     struct ngpu_rendertarget *rt = ngpu_ctx_get_default_rendertarget(s->gpu_ctx, NGPU_LOAD_OP_CLEAR);
     struct ngpu_rendertarget *rt_resume = ngpu_ctx_get_default_rendertarget(s->gpu_ctx, NGPU_LOAD_OP_LOAD);
@@ -526,14 +606,16 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     struct ngl_scene *scene = s->scene;
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->params.root->label, t);
+        const int64_t draw_start = ngli_tracer_begin(s->tracer);
         ngli_node_draw(scene->params.root);
+        ngli_tracer_end(s->tracer, "draw_scene", NULL, draw_start);
     }
 
     if (!ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
         ngpu_ctx_begin_render_pass(s->gpu_ctx, s->current_rendertarget);
     }
 
-    if (s->hud) {
+    if (measure_times) {
         s->cpu_draw_time = ngli_gettime_relative() - cpu_start_time;
 
         if (ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
@@ -542,14 +624,18 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
         }
         ngpu_ctx_query_draw_time(s->gpu_ctx, &s->gpu_draw_time);
 
-        ngli_hud_draw(s->hud);
+        if (s->hud)
+            ngli_hud_draw(s->hud);
     }
 
     if (ngpu_ctx_is_render_pass_active(s->gpu_ctx)) {
         ngpu_ctx_end_render_pass(s->gpu_ctx);
     }
 
-    return ngpu_ctx_end_draw(s->gpu_ctx, t);
+    const int64_t end_draw_start = ngli_tracer_begin(s->tracer);
+    ret = ngpu_ctx_end_draw(s->gpu_ctx, t);
+    ngli_tracer_end(s->tracer, "end_draw", s->config.capture_buffer ? "capture" : NULL, end_draw_start);
+    return ret;
 }
 
 int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
@@ -873,6 +959,27 @@ int ngl_gl_wrap_framebuffer(struct ngl_ctx *s, uint32_t framebuffer)
     return 0;
  }
 
+int ngl_stats_get(struct ngl_ctx *s, struct ngl_stats *stats)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the statistics");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    const struct ngpu_ctx_stats *gpu_stats = &s->gpu_ctx->stats;
+    *stats = (struct ngl_stats){
+        .cpu_update_time = s->cpu_update_time * 1000,
+        .cpu_draw_time   = s->cpu_draw_time * 1000,
+        .gpu_draw_time   = s->gpu_draw_time,
+        .nb_allocations  = ngli_memory_get_nb_allocations(),
+        .nb_pipelines    = gpu_stats->nb_pipelines,
+        .buffer_memory   = gpu_stats->buffer_memory,
+        .texture_memory  = gpu_stats->texture_memory,
+    };
+
+    return 0;
+}
+
 void ngl_freep(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -893,6 +1000,14 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+
+    if (s->tracer) {
+        int ret = ngli_tracer_dump(s->tracer);
+        if (ret < 0)
+            LOG(ERROR, "unable to write trace: %s", NGLI_RET_STR(ret));
+        ngli_tracer_freep(&s->tracer);
+    }
+
     ngli_freep(ss);
 }
 
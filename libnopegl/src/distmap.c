@@ -20,12 +20,14 @@
  * under the License.
  */
 
+#include <float.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
 #include "distmap.h"
+#include "distmap_cache.h"
 #include "distmap_frag.h"
 #include "distmap_vert.h"
 #include "internal.h"
@@ -51,6 +53,12 @@
  */
 #define PCENT_PADDING 80
 
+/*
+ * Each shape is rendered in tiles of at most TILE_SIZE×TILE_SIZE texels, each
+ * of them only evaluating the bézier curves which can affect it.
+ */
+#define TILE_SIZE 64
+
 struct bezier3 {
     float p0, p1, p2, p3;
 };
@@ -59,6 +67,20 @@ struct shape {
     int32_t width, height;
 };
 
+struct bbox {
+    float x0, y0, x1, y1;
+};
+
+struct tile {
+    int32_t shape_id;
+    int32_t x0, y0, x1, y1;     // texel boundaries within the padded shape
+    int32_t bezier_start;       // index in tile_bezier_x and tile_bezier_y
+    int32_t bezier_count;
+    int32_t counts_start;       // index in tile_bezier_counts and tile_distance_counts
+    int32_t beziergroup_start;  // index in beziergroup_areas
+    int32_t beziergroup_count;
+};
+
 struct distmap {
     struct ngl_ctx *ctx;
 
@@ -74,6 +96,16 @@ struct distmap {
     struct darray bezier_y;            // struct bezier3
     struct darray bezier_counts;       // int32_t
     struct darray beziergroup_counts;  // int32_t
+    struct darray beziergroup_areas;   // float
+
+    struct darray tiles;                // struct tile
+    struct darray tile_bezier_x;        // struct bezier3
+    struct darray tile_bezier_y;        // struct bezier3
+    struct darray tile_bezier_counts;   // int32_t
+    struct darray tile_distance_counts; // int32_t
+
+    uint8_t *content; // serialized shapes and béziers, used as cache key
+    size_t content_size;
 
     struct ngpu_texture *texture;
     struct ngpu_rendertarget *rt;
@@ -98,6 +130,12 @@ struct distmap *ngli_distmap_create(struct ngl_ctx *ctx)
     ngli_darray_init(&s->bezier_y, sizeof(struct bezier3), 0);
     ngli_darray_init(&s->bezier_counts, sizeof(int32_t), 0);
     ngli_darray_init(&s->beziergroup_counts, sizeof(int32_t), 0);
+    ngli_darray_init(&s->beziergroup_areas, sizeof(float), 0);
+    ngli_darray_init(&s->tiles, sizeof(struct tile), 0);
+    ngli_darray_init(&s->tile_bezier_x, sizeof(struct bezier3), 0);
+    ngli_darray_init(&s->tile_bezier_y, sizeof(struct bezier3), 0);
+    ngli_darray_init(&s->tile_bezier_counts, sizeof(int32_t), 0);
+    ngli_darray_init(&s->tile_distance_counts, sizeof(int32_t), 0);
     return s;
 }
 
@@ -204,44 +242,217 @@ int ngli_distmap_add_shape(struct distmap *s, int32_t shape_w, int32_t shape_h,
     return 0;
 }
 
-static int32_t get_beziergroup_start(const struct distmap *s, int32_t shape_id)
+static struct bbox get_bezier_bbox(const struct bezier3 *x, const struct bezier3 *y)
 {
-    const int32_t *group_counts = ngli_darray_data(&s->beziergroup_counts);
-    int32_t group_count = 0;
-    for (int32_t i = 0; i < shape_id; i++)
-        group_count += group_counts[i];
-    return group_count;
+    /* A bézier curve is always contained in the convex hull of its control points */
+    const struct bbox bbox = {
+        .x0 = NGLI_MIN(NGLI_MIN(x->p0, x->p1), NGLI_MIN(x->p2, x->p3)),
+        .y0 = NGLI_MIN(NGLI_MIN(y->p0, y->p1), NGLI_MIN(y->p2, y->p3)),
+        .x1 = NGLI_MAX(NGLI_MAX(x->p0, x->p1), NGLI_MAX(x->p2, x->p3)),
+        .y1 = NGLI_MAX(NGLI_MAX(y->p0, y->p1), NGLI_MAX(y->p2, y->p3)),
+    };
+    return bbox;
 }
 
-static int32_t sum_bezier_counts(const struct distmap *s, int32_t start, int32_t count)
+/* Smallest squared distance between any 2 points of the boxes */
+static float get_bbox_min_sq_dist(struct bbox a, struct bbox b)
 {
-    const int32_t *counts = ngli_darray_data(&s->bezier_counts);
-    int32_t sum = 0;
-    for (int32_t i = start; i < count; i++)
-        sum += abs(counts[i]);
-    return sum;
+    const float dx = NGLI_MAX(NGLI_MAX(b.x0 - a.x1, a.x0 - b.x1), 0.f);
+    const float dy = NGLI_MAX(NGLI_MAX(b.y0 - a.y1, a.y0 - b.y1), 0.f);
+    return dx * dx + dy * dy;
+}
+
+/* Largest squared distance between a point and any point of the box */
+static float get_point_max_sq_dist(struct bbox a, float x, float y)
+{
+    const float dx = NGLI_MAX(fabsf(x - a.x0), fabsf(x - a.x1));
+    const float dy = NGLI_MAX(fabsf(y - a.y0), fabsf(y - a.y1));
+    return dx * dx + dy * dy;
+}
+
+static int push_tile_bezier(struct distmap *s, const struct bezier3 *bezier_x, const struct bezier3 *bezier_y)
+{
+    if (!ngli_darray_push(&s->tile_bezier_x, bezier_x) ||
+        !ngli_darray_push(&s->tile_bezier_y, bezier_y))
+        return NGL_ERROR_MEMORY;
+    return 0;
 }
 
 /*
- * Get the maximum number of beziers across all shapes. This is useful to
- * get how large the bezier uniform buffer must be (it will be re-used for
- * each shape).
+ * Select the bézier curves of a group that can affect the texels of a tile.
+ *
+ * The distance to the group is the distance to its closest curve: every point
+ * of the tile is at most at max_sq_dist of an end point of some curve, so the
+ * curves whose bounding box is further away than that from the tile can not be
+ * the closest one and are skipped.
+ *
+ * The winding number is obtained by casting a horizontal ray: only the curves
+ * overlapping vertically with the tile can be crossed, so the other ones are
+ * skipped as well. These are stored after the ones used for the distance.
  */
-static int32_t get_max_beziers_per_shape(const struct distmap *s)
+static int add_tile_beziergroup(struct distmap *s, struct bbox tile_bbox,
+                                const struct bezier3 *bezier_x, const struct bezier3 *bezier_y,
+                                int32_t bezier_count, int closed, int32_t *nb_beziersp)
 {
-    int32_t max_beziers = 0;
-    const int32_t *counts = ngli_darray_data(&s->bezier_counts);
-    const int32_t *group_counts = ngli_darray_data(&s->beziergroup_counts);
-    for (size_t i = 0; i < ngli_darray_count(&s->beziergroup_counts); i++) {
-        const int32_t group_count = group_counts[i];
+    float max_sq_dist = FLT_MAX;
+    for (int32_t i = 0; i < bezier_count; i++) {
+        const float d0 = get_point_max_sq_dist(tile_bbox, bezier_x[i].p0, bezier_y[i].p0);
+        const float d3 = get_point_max_sq_dist(tile_bbox, bezier_x[i].p3, bezier_y[i].p3);
+        max_sq_dist = NGLI_MIN(max_sq_dist, NGLI_MIN(d0, d3));
+    }
 
-        int32_t sum = 0;
-        for (int32_t j = 0; j < group_count; j++)
-            sum += abs(counts[j]);
-        counts += group_count;
+    /* Relative margin to stay conservative despite float inaccuracies */
+    max_sq_dist *= 1.001f;
+
+    int32_t nb_distance = 0, nb_winding = 0;
+    for (int32_t i = 0; i < bezier_count; i++) {
+        const struct bbox bbox = get_bezier_bbox(&bezier_x[i], &bezier_y[i]);
+        if (get_bbox_min_sq_dist(tile_bbox, bbox) > max_sq_dist)
+            continue;
+        int ret = push_tile_bezier(s, &bezier_x[i], &bezier_y[i]);
+        if (ret < 0)
+            return ret;
+        nb_distance++;
+    }
 
-        max_beziers = NGLI_MAX(max_beziers, sum);
+    if (closed) {
+        for (int32_t i = 0; i < bezier_count; i++) {
+            const struct bbox bbox = get_bezier_bbox(&bezier_x[i], &bezier_y[i]);
+            if (get_bbox_min_sq_dist(tile_bbox, bbox) <= max_sq_dist)
+                continue; // already added
+            if (bbox.y1 < tile_bbox.y0 || bbox.y0 > tile_bbox.y1)
+                continue;
+            int ret = push_tile_bezier(s, &bezier_x[i], &bezier_y[i]);
+            if (ret < 0)
+                return ret;
+            nb_winding++;
+        }
     }
+
+    /* Pass down the closing flag to the shader using negative integers */
+    const int32_t nb_beziers = nb_distance + nb_winding;
+    const int32_t tile_bezier_count = (closed ? -1 : 1) * nb_beziers;
+    if (!ngli_darray_push(&s->tile_bezier_counts, &tile_bezier_count) ||
+        !ngli_darray_push(&s->tile_distance_counts, &nb_distance))
+        return NGL_ERROR_MEMORY;
+
+    *nb_beziersp = nb_beziers;
+    return 0;
+}
+
+/*
+ * The orientation of each group depends on all its curves, so it is
+ * computed once here instead of in every tile.
+ */
+static int compute_beziergroup_areas(struct distmap *s)
+{
+    const int32_t *bezier_counts = ngli_darray_data(&s->bezier_counts);
+    const struct bezier3 *bezier_x = ngli_darray_data(&s->bezier_x);
+    const struct bezier3 *bezier_y = ngli_darray_data(&s->bezier_y);
+
+    for (size_t j = 0; j < ngli_darray_count(&s->bezier_counts); j++) {
+        const int32_t bezier_count = abs(bezier_counts[j]);
+        float area = 0.f;
+        for (int32_t i = 0; i < bezier_count; i++) {
+            const struct bezier3 x = bezier_x[i];
+            const struct bezier3 y = bezier_y[i];
+            area += (x.p1 - x.p0) * (y.p1 + y.p0);
+            area += (x.p2 - x.p1) * (y.p2 + y.p1);
+            area += (x.p3 - x.p2) * (y.p3 + y.p2);
+        }
+        if (!ngli_darray_push(&s->beziergroup_areas, &area))
+            return NGL_ERROR_MEMORY;
+        bezier_x += bezier_count;
+        bezier_y += bezier_count;
+    }
+
+    return 0;
+}
+
+static int build_tiles(struct distmap *s)
+{
+    const int32_t *bezier_counts = ngli_darray_data(&s->bezier_counts);
+    const int32_t *beziergroup_counts = ngli_darray_data(&s->beziergroup_counts);
+    const struct bezier3 *bezier_x = ngli_darray_data(&s->bezier_x);
+    const struct bezier3 *bezier_y = ngli_darray_data(&s->bezier_y);
+
+    int32_t beziergroup_start = 0;
+    for (int32_t shape_id = 0; shape_id < (int32_t)ngli_darray_count(&s->shapes); shape_id++) {
+        const struct shape *shape = ngli_darray_get(&s->shapes, shape_id);
+        const int32_t beziergroup_count = beziergroup_counts[shape_id];
+        const int32_t padded_w = 2*s->pad + shape->width + 1;
+        const int32_t padded_h = 2*s->pad + shape->height + 1;
+
+        /* Same mapping as the fragment shader, see load_buffers_data() */
+        const float pad_w = ((float)s->pad + .5f) / (float)shape->width;
+        const float pad_h = ((float)s->pad + .5f) / (float)shape->height;
+        const float scale_w = (float)shape->width * s->scale;
+        const float scale_h = (float)shape->height * s->scale;
+        const float texel_w = (1.f + 2.f * pad_w) * scale_w / (float)padded_w;
+        const float texel_h = (1.f + 2.f * pad_h) * scale_h / (float)padded_h;
+
+        for (int32_t y = 0; y < padded_h; y += TILE_SIZE) {
+            for (int32_t x = 0; x < padded_w; x += TILE_SIZE) {
+                struct tile tile = {
+                    .shape_id          = shape_id,
+                    .x0                = x,
+                    .y0                = y,
+                    .x1                = NGLI_MIN(x + TILE_SIZE, padded_w),
+                    .y1                = NGLI_MIN(y + TILE_SIZE, padded_h),
+                    .bezier_start      = (int32_t)ngli_darray_count(&s->tile_bezier_x),
+                    .counts_start      = (int32_t)ngli_darray_count(&s->tile_bezier_counts),
+                    .beziergroup_start = beziergroup_start,
+                    .beziergroup_count = beziergroup_count,
+                };
+
+                /* Tile boundaries in the normalized bézier space, with a texel of margin */
+                const struct bbox tile_bbox = {
+                    .x0 = NGLI_MIX_F32(-pad_w, 1.f + pad_w, (float)tile.x0 / (float)padded_w) * scale_w - texel_w,
+                    .y0 = NGLI_MIX_F32(-pad_h, 1.f + pad_h, (float)tile.y0 / (float)padded_h) * scale_h - texel_h,
+                    .x1 = NGLI_MIX_F32(-pad_w, 1.f + pad_w, (float)tile.x1 / (float)padded_w) * scale_w + texel_w,
+                    .y1 = NGLI_MIX_F32(-pad_h, 1.f + pad_h, (float)tile.y1 / (float)padded_h) * scale_h + texel_h,
+                };
+
+                const struct bezier3 *group_x = bezier_x;
+                const struct bezier3 *group_y = bezier_y;
+                for (int32_t j = 0; j < beziergroup_count; j++) {
+                    const int32_t bezier_count = bezier_counts[beziergroup_start + j];
+                    int32_t nb_beziers;
+                    int ret = add_tile_beziergroup(s, tile_bbox, group_x, group_y,
+                                                   abs(bezier_count), bezier_count < 0, &nb_beziers);
+                    if (ret < 0)
+                        return ret;
+                    tile.bezier_count += nb_beziers;
+                    group_x += abs(bezier_count);
+                    group_y += abs(bezier_count);
+                }
+
+                if (!ngli_darray_push(&s->tiles, &tile))
+                    return NGL_ERROR_MEMORY;
+            }
+        }
+
+        for (int32_t j = 0; j < beziergroup_count; j++) {
+            bezier_x += abs(bezier_counts[beziergroup_start + j]);
+            bezier_y += abs(bezier_counts[beziergroup_start + j]);
+        }
+        beziergroup_start += beziergroup_count;
+    }
+
+    return 0;
+}
+
+/*
+ * Get the maximum number of beziers across all tiles. This is useful to get
+ * how large the bezier uniform buffer must be (it will be re-used for each
+ * tile).
+ */
+static int32_t get_max_beziers_per_tile(const struct distmap *s)
+{
+    int32_t max_beziers = 0;
+    const struct tile *tiles = ngli_darray_data(&s->tiles);
+    for (size_t i = 0; i < ngli_darray_count(&s->tiles); i++)
+        max_beziers = NGLI_MAX(max_beziers, tiles[i].bezier_count);
     return max_beziers;
 }
 
@@ -264,91 +475,86 @@ enum {
     BEZIER_X_BUF_INDEX,
     BEZIER_Y_BUF_INDEX,
     BEZIER_COUNTS_INDEX,
+    DISTANCE_COUNTS_INDEX,
+    BEZIERGROUP_AREAS_INDEX,
     BEZIERGROUP_COUNT_INDEX,
 };
 
 static void load_buffers_data(struct distmap *s, uint8_t *vert_data, uint8_t *frag_data)
 {
-    const int32_t *bezier_counts = ngli_darray_data(&s->bezier_counts);
-    const int32_t *beziergroup_counts = ngli_darray_data(&s->beziergroup_counts);
-    const struct bezier3 *bezier_x = ngli_darray_data(&s->bezier_x);
-    const struct bezier3 *bezier_y = ngli_darray_data(&s->bezier_y);
-
-    const float qw = 1.f / (float)s->nb_cols;
-    const float qh = 1.f / (float)s->nb_rows;
-
-    const int32_t nb_shapes = (int32_t)ngli_darray_count(&s->shapes);
-    int32_t shape_id = 0;
-
-    for (int32_t y = 0; y < s->nb_rows; y++) {
-        for (int32_t x = 0; x < s->nb_cols; x++) {
-            if (shape_id == nb_shapes)
-                return;
-
-            const int32_t beziergroup_start_idx = get_beziergroup_start(s, shape_id);
-            const int32_t beziergroup_count     = beziergroup_counts[shape_id];
-
-            const int32_t bezier_start_idx = sum_bezier_counts(s, 0, beziergroup_start_idx);
-            const int32_t bezier_count     = sum_bezier_counts(s, beziergroup_start_idx, beziergroup_start_idx + beziergroup_count);
-
-            const struct shape *shape = ngli_darray_get(&s->shapes, shape_id);
-
-            /*
-             * Defines the quad coordinates of the atlas into which the glyph
-             * distance must be drawn. The geometry respects the proportions of
-             * the shape and is located on a grid of cells of the maximum size.
-             */
-            const int32_t padded_w = 2*s->pad + shape->width + 1;
-            const int32_t padded_h = 2*s->pad + shape->height + 1;
-            const float xr = (float)padded_w / (float)s->max_shape_padded_w;
-            const float yr = (float)padded_h / (float)s->max_shape_padded_h;
-            const float x0 = (float)x * qw;
-            const float y0 = (float)y * qh;
-            const float x1 = x0 + qw * xr;
-            const float y1 = y0 + qh * yr;
-            const float vertices[] = {x0, y0, x1, y1};
-
-            /*
-             * Given p for padding and m for pixel width or height, we have:
-             * x₀ = p      (start of the shape, in pixels, without padding)
-             * x₁ = p + m  (end of the shape, in pixels, without padding)
-             *
-             * If we consider 0 to be the start of the padded shape, and 1 its
-             * width or height (basically the UV of the geometry), we can
-             * identify the boundaries of the shape without padding:
-             *
-             * start = linear(x₀,x₁,0)    = -p/m
-             * end   = linear(x₀,x₁,m+2p) = 1+p/m
-             *
-             * The +0.5 is used to take into account the extra texel used for
-             * safe picking.
-             */
-            const float pad_w = ((float)s->pad + .5f) / (float)shape->width;
-            const float pad_h = ((float)s->pad + .5f) / (float)shape->height;
-            const float coords[] = {-pad_w, -pad_h, 1.f + pad_w, 1.f + pad_h};
-
-            const float scale[] = {(float)shape->width * s->scale, (float)shape->height * s->scale};
-
-            const struct ngpu_block_field_data vert_data_src[] = {
-                [VERTICES_INDEX] = {.data=vertices},
-            };
-
-            const struct ngpu_block_field_data frag_data_src[] = {
-                [COORDS_INDEX]            = {.data = coords},
-                [SCALE_INDEX]             = {.data = scale},
-                [BEZIER_X_BUF_INDEX]      = {.data = bezier_x + bezier_start_idx, .count = bezier_count},
-                [BEZIER_Y_BUF_INDEX]      = {.data = bezier_y + bezier_start_idx, .count = bezier_count},
-                [BEZIER_COUNTS_INDEX]     = {.data = bezier_counts + beziergroup_start_idx, .count = beziergroup_count},
-                [BEZIERGROUP_COUNT_INDEX] = {.data = &beziergroup_count},
-            };
-
-            ngpu_block_desc_fields_copy(&s->vert_block, vert_data_src, vert_data);
-            vert_data += s->vert_offset;
-            ngpu_block_desc_fields_copy(&s->frag_block, frag_data_src, frag_data);
-            frag_data += s->frag_offset;
-
-            shape_id++;
-        }
+    const int32_t *bezier_counts = ngli_darray_data(&s->tile_bezier_counts);
+    const int32_t *distance_counts = ngli_darray_data(&s->tile_distance_counts);
+    const float *beziergroup_areas = ngli_darray_data(&s->beziergroup_areas);
+    const struct bezier3 *bezier_x = ngli_darray_data(&s->tile_bezier_x);
+    const struct bezier3 *bezier_y = ngli_darray_data(&s->tile_bezier_y);
+    const struct tile *tiles = ngli_darray_data(&s->tiles);
+
+    for (size_t i = 0; i < ngli_darray_count(&s->tiles); i++) {
+        const struct tile *tile = &tiles[i];
+        const struct shape *shape = ngli_darray_get(&s->shapes, tile->shape_id);
+
+        /*
+         * Defines the quad coordinates of the atlas into which the tile of
+         * the glyph distance must be drawn. The shapes are located on a grid
+         * of cells of the maximum size.
+         */
+        const int32_t col = tile->shape_id % s->nb_cols;
+        const int32_t row = tile->shape_id / s->nb_cols;
+        const int32_t cell_x = col * s->max_shape_padded_w;
+        const int32_t cell_y = row * s->max_shape_padded_h;
+        const float x0 = (float)(cell_x + tile->x0) / (float)s->texture_w;
+        const float y0 = (float)(cell_y + tile->y0) / (float)s->texture_h;
+        const float x1 = (float)(cell_x + tile->x1) / (float)s->texture_w;
+        const float y1 = (float)(cell_y + tile->y1) / (float)s->texture_h;
+        const float vertices[] = {x0, y0, x1, y1};
+
+        /*
+         * Given p for padding and m for pixel width or height, we have:
+         * x₀ = p      (start of the shape, in pixels, without padding)
+         * x₁ = p + m  (end of the shape, in pixels, without padding)
+         *
+         * If we consider 0 to be the start of the padded shape, and 1 its
+         * width or height (basically the UV of the geometry), we can
+         * identify the boundaries of the shape without padding:
+         *
+         * start = linear(x₀,x₁,0)    = -p/m
+         * end   = linear(x₀,x₁,m+2p) = 1+p/m
+         *
+         * The +0.5 is used to take into account the extra texel used for
+         * safe picking. The coordinates are then restricted to the tile.
+         */
+        const int32_t padded_w = 2*s->pad + shape->width + 1;
+        const int32_t padded_h = 2*s->pad + shape->height + 1;
+        const float pad_w = ((float)s->pad + .5f) / (float)shape->width;
+        const float pad_h = ((float)s->pad + .5f) / (float)shape->height;
+        const float coords[] = {
+            NGLI_MIX_F32(-pad_w, 1.f + pad_w, (float)tile->x0 / (float)padded_w),
+            NGLI_MIX_F32(-pad_h, 1.f + pad_h, (float)tile->y0 / (float)padded_h),
+            NGLI_MIX_F32(-pad_w, 1.f + pad_w, (float)tile->x1 / (float)padded_w),
+            NGLI_MIX_F32(-pad_h, 1.f + pad_h, (float)tile->y1 / (float)padded_h),
+        };
+
+        const float scale[] = {(float)shape->width * s->scale, (float)shape->height * s->scale};
+
+        const struct ngpu_block_field_data vert_data_src[] = {
+            [VERTICES_INDEX] = {.data=vertices},
+        };
+
+        const struct ngpu_block_field_data frag_data_src[] = {
+            [COORDS_INDEX]            = {.data = coords},
+            [SCALE_INDEX]             = {.data = scale},
+            [BEZIER_X_BUF_INDEX]      = {.data = bezier_x + tile->bezier_start, .count = tile->bezier_count},
+            [BEZIER_Y_BUF_INDEX]      = {.data = bezier_y + tile->bezier_start, .count = tile->bezier_count},
+            [BEZIER_COUNTS_INDEX]     = {.data = bezier_counts + tile->counts_start, .count = tile->beziergroup_count},
+            [DISTANCE_COUNTS_INDEX]   = {.data = distance_counts + tile->counts_start, .count = tile->beziergroup_count},
+            [BEZIERGROUP_AREAS_INDEX] = {.data = beziergroup_areas + tile->beziergroup_start, .count = tile->beziergroup_count},
+            [BEZIERGROUP_COUNT_INDEX] = {.data = &tile->beziergroup_count},
+        };
+
+        ngpu_block_desc_fields_copy(&s->vert_block, vert_data_src, vert_data);
+        vert_data += s->vert_offset;
+        ngpu_block_desc_fields_copy(&s->frag_block, frag_data_src, frag_data);
+        frag_data += s->frag_offset;
     }
 }
 
@@ -376,9 +582,10 @@ end:
 }
 
 /*
- * Multiple draw calls (one for each shape) are executed instead of just a big
+ * Multiple draw calls (one for each tile) are executed instead of just a big
  * one wrapping them all because the number of beziers in the array can be
- * too large on certain platforms.
+ * too large on certain platforms, and to only evaluate the beziers relevant
+ * to each tile.
  */
 static int draw_glyphs(struct distmap *s)
 {
@@ -389,21 +596,12 @@ static int draw_glyphs(struct distmap *s)
     ngli_pipeline_compat_update_buffer(s->pipeline_compat, 0, s->vert_buffer, 0, (int)s->vert_offset);
     ngli_pipeline_compat_update_buffer(s->pipeline_compat, 1, s->frag_buffer, 0, (int)s->frag_offset);
 
-    const int32_t nb_shapes = (int32_t)ngli_darray_count(&s->shapes);
-    int32_t shape_id = 0;
-
-    for (int32_t y = 0; y < s->nb_rows; y++) {
-        for (int32_t x = 0; x < s->nb_cols; x++) {
-            if (shape_id == nb_shapes)
-                return 0;
-
-            const uint32_t offsets[] = {shape_id * (uint32_t)s->vert_offset, shape_id * (uint32_t)s->frag_offset};
-            ret = ngli_pipeline_compat_update_dynamic_offsets(s->pipeline_compat, offsets, NGLI_ARRAY_NB(offsets));
-            if (ret < 0)
-                return ret;
-            ngli_pipeline_compat_draw(s->pipeline_compat, 3, 1, 0);
-            shape_id++;
-        }
+    for (size_t i = 0; i < ngli_darray_count(&s->tiles); i++) {
+        const uint32_t offsets[] = {(uint32_t)(i * s->vert_offset), (uint32_t)(i * s->frag_offset)};
+        ret = ngli_pipeline_compat_update_dynamic_offsets(s->pipeline_compat, offsets, NGLI_ARRAY_NB(offsets));
+        if (ret < 0)
+            return ret;
+        ngli_pipeline_compat_draw(s->pipeline_compat, 6, 1, 0);
     }
 
     return 0;
@@ -415,6 +613,14 @@ static void reset_tmp_data(struct distmap *s)
     ngli_darray_reset(&s->bezier_y);
     ngli_darray_reset(&s->bezier_counts);
     ngli_darray_reset(&s->beziergroup_counts);
+    ngli_darray_reset(&s->beziergroup_areas);
+    ngli_darray_reset(&s->tiles);
+    ngli_darray_reset(&s->tile_bezier_x);
+    ngli_darray_reset(&s->tile_bezier_y);
+    ngli_darray_reset(&s->tile_bezier_counts);
+    ngli_darray_reset(&s->tile_distance_counts);
+    ngli_freep(&s->content);
+    s->content_size = 0;
 
     ngli_pipeline_compat_freep(&s->pipeline_compat);
     ngpu_block_desc_reset(&s->vert_block);
@@ -446,6 +652,47 @@ static void normalize_coordinates(struct distmap *s)
     }
 }
 
+static uint8_t *append_darray(uint8_t *dst, const struct darray *array)
+{
+    const size_t count = ngli_darray_count(array);
+    memcpy(dst, &count, sizeof(count));
+    dst += sizeof(count);
+    const size_t size = count * array->element_size;
+    if (size)
+        memcpy(dst, ngli_darray_data(array), size);
+    return dst + size;
+}
+
+/*
+ * Serialize everything the generated texture depends on, the texture format
+ * being the same for all the distance maps of a context.
+ */
+static int serialize_content(struct distmap *s)
+{
+    const struct darray *arrays[] = {
+        &s->shapes,
+        &s->beziergroup_counts,
+        &s->bezier_counts,
+        &s->bezier_x,
+        &s->bezier_y,
+    };
+
+    size_t size = 0;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(arrays); i++)
+        size += sizeof(size_t) + ngli_darray_count(arrays[i]) * arrays[i]->element_size;
+
+    s->content = ngli_malloc(size);
+    if (!s->content)
+        return NGL_ERROR_MEMORY;
+    s->content_size = size;
+
+    uint8_t *dst = s->content;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(arrays); i++)
+        dst = append_darray(dst, arrays[i]);
+
+    return 0;
+}
+
 #define DISTMAP_FEATURES (NGPU_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |               \
                           NGPU_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT | \
                           NGPU_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT)
@@ -512,6 +759,23 @@ int ngli_distmap_finalize(struct distmap *s)
     s->max_shape_padded_w = s->max_shape_w + 2 * s->pad + 1;
     s->max_shape_padded_h = s->max_shape_h + 2 * s->pad + 1;
 
+    s->texture_w = s->max_shape_padded_w * s->nb_cols;
+    s->texture_h = s->max_shape_padded_h * s->nb_rows;
+
+    /*
+     * The layout above only depends on the shapes, so a texture generated
+     * from the same content can be reused as is.
+     */
+    int ret = serialize_content(s);
+    if (ret < 0)
+        return ret;
+
+    s->texture = ngli_distmap_cache_get(s->ctx->distmap_cache, s->content, s->content_size);
+    if (s->texture) {
+        reset_tmp_data(s);
+        return 0;
+    }
+
     /*
      * We normalize the coordinates with regards to the container shape so that
      * distances are within [0,1] while remaining proportionnal against each
@@ -519,8 +783,9 @@ int ngli_distmap_finalize(struct distmap *s)
      */
     normalize_coordinates(s);
 
-    s->texture_w = s->max_shape_padded_w * s->nb_cols;
-    s->texture_h = s->max_shape_padded_h * s->nb_rows;
+    if ((ret = compute_beziergroup_areas(s)) < 0 ||
+        (ret = build_tiles(s)) < 0)
+        return ret;
 
     /*
      * Build pipeline and execute the computation of the complete signed
@@ -545,7 +810,7 @@ int ngli_distmap_finalize(struct distmap *s)
     if (!s->texture)
         return NGL_ERROR_MEMORY;
 
-    int ret = ngpu_texture_init(s->texture, &tex_params);
+    ret = ngpu_texture_init(s->texture, &tex_params);
     if (ret < 0)
         return ret;
 
@@ -566,7 +831,7 @@ int ngli_distmap_finalize(struct distmap *s)
     if (ret < 0)
         return ret;
 
-    const int32_t bezier_max_count = get_max_beziers_per_shape(s);
+    const int32_t bezier_max_count = get_max_beziers_per_tile(s);
     const int32_t beziergroup_max_count = get_max_beziergroups_per_shape(s);
 
     const struct ngpu_block_field vert_fields[] = {
@@ -579,6 +844,8 @@ int ngli_distmap_finalize(struct distmap *s)
         [BEZIER_X_BUF_INDEX]      = {.name="bezier_x_buf",      .type=NGPU_TYPE_VEC4, .count=bezier_max_count},
         [BEZIER_Y_BUF_INDEX]      = {.name="bezier_y_buf",      .type=NGPU_TYPE_VEC4, .count=bezier_max_count},
         [BEZIER_COUNTS_INDEX]     = {.name="bezier_counts",     .type=NGPU_TYPE_I32,  .count=beziergroup_max_count},
+        [DISTANCE_COUNTS_INDEX]   = {.name="distance_counts",   .type=NGPU_TYPE_I32,  .count=beziergroup_max_count},
+        [BEZIERGROUP_AREAS_INDEX] = {.name="beziergroup_areas", .type=NGPU_TYPE_F32,  .count=beziergroup_max_count},
         [BEZIERGROUP_COUNT_INDEX] = {.name="beziergroup_count", .type=NGPU_TYPE_I32},
     };
 
@@ -598,8 +865,9 @@ int ngli_distmap_finalize(struct distmap *s)
     s->frag_offset = ngpu_block_desc_get_aligned_size(&s->frag_block, 0);
 
     static const uint32_t usage = NGPU_BUFFER_USAGE_UNIFORM_BUFFER_BIT | NGPU_BUFFER_USAGE_MAP_WRITE;
-    if ((ret = ngpu_buffer_init(s->vert_buffer, nb_shapes * s->vert_offset, usage)) < 0 ||
-        (ret = ngpu_buffer_init(s->frag_buffer, nb_shapes * s->frag_offset, usage)) < 0)
+    const size_t nb_tiles = ngli_darray_count(&s->tiles);
+    if ((ret = ngpu_buffer_init(s->vert_buffer, nb_tiles * s->vert_offset, usage)) < 0 ||
+        (ret = ngpu_buffer_init(s->frag_buffer, nb_tiles * s->frag_offset, usage)) < 0)
         return ret;
 
     const struct ngpu_pgcraft_block crafter_blocks[] = {
@@ -670,6 +938,10 @@ int ngli_distmap_finalize(struct distmap *s)
 
     ngpu_ctx_end_render_pass(gpu_ctx);
 
+    ret = ngli_distmap_cache_set(s->ctx->distmap_cache, s->content, s->content_size, s->texture);
+    if (ret < 0)
+        return ret;
+
     /*
      * Now that the distmap is rendered, the pipeline and other related
      * allocations are not needed anymore, we just have to keep the texture.
@@ -716,6 +988,6 @@ void ngli_distmap_freep(struct distmap **dp)
     reset_tmp_data(s);
 
     ngli_darray_reset(&s->shapes);
-    ngpu_texture_freep(&s->texture);
+    ngli_distmap_cache_release(s->ctx->distmap_cache, &s->texture);
     ngli_freep(dp);
 }
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "distmap_cache.h"
+#include "log.h"
+#include "ngpu/texture.h"
+#include "nopegl.h"
+#include "utils/crc32.h"
+#include "utils/darray.h"
+#include "utils/hmap.h"
+#include "utils/memory.h"
+#include "utils/refcount.h"
+#include "utils/utils.h"
+
+/* Maximum number of entries kept while not used by any distance map */
+#define MAX_UNUSED_ENTRIES 8
+
+struct distmap_cache_entry {
+    uint8_t *data;
+    size_t size;
+    struct ngpu_texture *texture;
+    size_t nb_users;
+    uint64_t release_id;
+};
+
+struct distmap_cache {
+    struct hmap *entries; /* struct distmap_cache_entry */
+    size_t nb_unused_entries;
+    uint64_t release_id;
+    int hold; /* released entries are not evicted until the next purge */
+};
+
+static void free_entry(void *user_arg, void *data)
+{
+    struct distmap_cache_entry *entry = data;
+    ngpu_texture_freep(&entry->texture);
+    ngli_freep(&entry->data);
+    ngli_free(entry);
+}
+
+struct distmap_cache *ngli_distmap_cache_create(void)
+{
+    struct distmap_cache *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->entries = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
+    if (!s->entries) {
+        ngli_freep(&s);
+        return NULL;
+    }
+    ngli_hmap_set_free_func(s->entries, free_entry, NULL);
+
+    return s;
+}
+
+/*
+ * The key is only a hint: in case of collision, the content of the entry is
+ * compared as well and the new content is simply not cached.
+ */
+static uint64_t get_key(const uint8_t *data, size_t size)
+{
+    return (uint64_t)size << 32 | ngli_crc32_mem(data, size);
+}
+
+static struct distmap_cache_entry *get_entry(struct distmap_cache *s, uint64_t key,
+                                             const uint8_t *data, size_t size)
+{
+    struct distmap_cache_entry *entry = ngli_hmap_get_u64(s->entries, key);
+    if (!entry || entry->size != size || memcmp(entry->data, data, size))
+        return NULL;
+    return entry;
+}
+
+struct ngpu_texture *ngli_distmap_cache_get(struct distmap_cache *s, const uint8_t *data, size_t size)
+{
+    struct distmap_cache_entry *entry = get_entry(s, get_key(data, size), data, size);
+    if (!entry)
+        return NULL;
+    if (!entry->nb_users)
+        s->nb_unused_entries--;
+    entry->nb_users++;
+    return NGLI_RC_REF(entry->texture);
+}
+
+int ngli_distmap_cache_set(struct distmap_cache *s, const uint8_t *data, size_t size, struct ngpu_texture *texture)
+{
+    const uint64_t key = get_key(data, size);
+    if (ngli_hmap_get_u64(s->entries, key))
+        return 0;
+
+    struct distmap_cache_entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+
+    entry->data = ngli_memdup(data, size);
+    if (!entry->data) {
+        ngli_free(entry);
+        return NGL_ERROR_MEMORY;
+    }
+    entry->size = size;
+    entry->texture = NGLI_RC_REF(texture);
+    entry->nb_users = 1;
+
+    int ret = ngli_hmap_set_u64(s->entries, key, entry);
+    if (ret < 0) {
+        free_entry(NULL, entry);
+        return ret;
+    }
+
+    return 0;
+}
+
+static void drop_least_recently_released(struct distmap_cache *s)
+{
+    uint64_t key = 0;
+    const struct distmap_cache_entry *oldest = NULL;
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(s->entries, e))) {
+        const struct distmap_cache_entry *entry = e->data;
+        if (!entry->nb_users && (!oldest || entry->release_id < oldest->release_id)) {
+            oldest = entry;
+            key = e->key.u64;
+        }
+    }
+    ngli_assert(oldest);
+    ngli_hmap_set_u64(s->entries, key, NULL);
+    s->nb_unused_entries--;
+}
+
+void ngli_distmap_cache_release(struct distmap_cache *s, struct ngpu_texture **texturep)
+{
+    const struct ngpu_texture *texture = *texturep;
+    if (!texture)
+        return;
+
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(s->entries, e))) {
+        struct distmap_cache_entry *entry = e->data;
+        if (entry->texture != texture)
+            continue;
+        ngli_assert(entry->nb_users > 0);
+        if (--entry->nb_users == 0) {
+            entry->release_id = s->release_id++;
+            s->nb_unused_entries++;
+        }
+        break;
+    }
+
+    ngpu_texture_freep(texturep);
+
+    if (!s->hold && s->nb_unused_entries > MAX_UNUSED_ENTRIES)
+        drop_least_recently_released(s);
+}
+
+void ngli_distmap_cache_hold(struct distmap_cache *s)
+{
+    s->hold = 1;
+}
+
+int ngli_distmap_cache_purge(struct distmap_cache *s)
+{
+    s->hold = 0;
+
+    struct darray keys;
+    ngli_darray_init(&keys, sizeof(uint64_t), 0);
+
+    int ret = 0;
+    const struct hmap_entry *e = NULL;
+    while ((e = ngli_hmap_next(s->entries, e))) {
+        const struct distmap_cache_entry *entry = e->data;
+        if (!entry->nb_users && !ngli_darray_push(&keys, &e->key.u64)) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+    }
+
+    const uint64_t *keysp = ngli_darray_data(&keys);
+    for (size_t i = 0; i < ngli_darray_count(&keys); i++)
+        ngli_hmap_set_u64(s->entries, keysp[i], NULL);
+    s->nb_unused_entries -= ngli_darray_count(&keys);
+
+    if (ngli_darray_count(&keys))
+        LOG(DEBUG, "purged %zu unused distance map(s), %zu left in cache",
+            ngli_darray_count(&keys), ngli_hmap_count(s->entries));
+
+end:
+    ngli_darray_reset(&keys);
+    return ret;
+}
+
+void ngli_distmap_cache_freep(struct distmap_cache **sp)
+{
+    struct distmap_cache *s = *sp;
+    if (!s)
+        return;
+    ngli_hmap_freep(&s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DISTMAP_CACHE_H
+#define DISTMAP_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Cache of distance map textures, shared by all the distance maps of a
+ * rendering context.
+ *
+ * Entries are addressed by the content the texture has been generated from
+ * (shapes dimensions and bézier curves), so that identical paths and glyph
+ * sets reuse a single texture, within a scene and across scene changes.
+ *
+ * The cache keeps track of the distance maps using each entry. Entries
+ * released by their last user are kept for a potential reuse, but only a few
+ * of them, the least recently released being dropped first. While a scene is
+ * being replaced, the cache is held so that all the entries released by the
+ * previous scene remain available to the new one; the ones it did not reuse
+ * are then dropped when purged.
+ */
+
+struct distmap_cache;
+struct ngpu_texture;
+
+struct distmap_cache *ngli_distmap_cache_create(void);
+
+/*
+ * Return a new reference on the texture generated for the content, or NULL if
+ * none. The reference must be released with ngli_distmap_cache_release().
+ */
+struct ngpu_texture *ngli_distmap_cache_get(struct distmap_cache *s, const uint8_t *data, size_t size);
+
+/*
+ * Register a texture generated for the content, the cache takes its own
+ * reference on it and the caller becomes its first user.
+ */
+int ngli_distmap_cache_set(struct distmap_cache *s, const uint8_t *data, size_t size, struct ngpu_texture *texture);
+
+/*
+ * Release a texture obtained from the cache or registered into it. Textures
+ * unknown to the cache are simply released.
+ */
+void ngli_distmap_cache_release(struct distmap_cache *s, struct ngpu_texture **texturep);
+
+/*
+ * Keep all the released entries (instead of only the most recently released
+ * ones) until the next call to ngli_distmap_cache_purge()
+ */
+void ngli_distmap_cache_hold(struct distmap_cache *s);
+
+/* Drop the entries which are not used by any distance map and release the hold */
+int ngli_distmap_cache_purge(struct distmap_cache *s);
+
+void ngli_distmap_cache_freep(struct distmap_cache **sp);
+
+#endif
@@ -19,9 +19,12 @@
  * under the License.
  */
 
+#include <inttypes.h>
+
 #include "geometry.h"
 #include "log.h"
 #include "ngpu/buffer.h"
+#include "ngpu/ctx.h"
 #include "ngpu/format.h"
 #include "ngpu/type.h"
 #include "nopegl.h"
@@ -117,22 +120,39 @@ int ngli_geometry_set_uvcoords(struct geometry *s, size_t n, const float *uvcoor
     return gen_vec2(s, &s->uvcoords_buffer, &s->uvcoords_layout, n, uvcoords);
 }
 
-int ngli_geometry_set_indices(struct geometry *s, size_t count, const uint16_t *indices)
+int ngli_geometry_set_indices(struct geometry *s, size_t count, const uint32_t *indices)
 {
     ngli_assert(!(s->buffer_ownership & OWN_INDICES));
     s->buffer_ownership |= OWN_INDICES;
-    const enum ngpu_format format = NGPU_FORMAT_R16_UNORM;
+
+    uint32_t max_indices = 0;
+    for (size_t i = 0; i < count; i++)
+        max_indices = NGLI_MAX(max_indices, indices[i]);
+    s->max_indices = max_indices;
+
+    /* Halve the index buffer size whenever the indices fit in 16-bit */
+    uint16_t *indices16 = NULL;
+    if (max_indices <= UINT16_MAX) {
+        indices16 = ngli_calloc(count, sizeof(*indices16));
+        if (!indices16)
+            return NGL_ERROR_MEMORY;
+        for (size_t i = 0; i < count; i++)
+            indices16[i] = (uint16_t)indices[i];
+    }
+
+    const enum ngpu_format format = indices16 ? NGPU_FORMAT_R16_UNORM : NGPU_FORMAT_R32_UINT;
     s->indices_layout = (struct buffer_layout){
-        .type   = NGPU_TYPE_NONE,
+        .type   = indices16 ? NGPU_TYPE_NONE : NGPU_TYPE_U32,
         .format = format,
         .stride = ngpu_format_get_bytes_per_pixel(format),
         .comp   = ngpu_format_get_nb_comp(format),
         .count  = count,
         .offset = 0,
     };
-    for (size_t i = 0; i < count; i++)
-        s->max_indices = NGLI_MAX(s->max_indices, indices[i]);
-    return gen_buffer(s, &s->indices_buffer, &s->indices_layout, indices, NGPU_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    const void *data = indices16 ? (const void *)indices16 : (const void *)indices;
+    int ret = gen_buffer(s, &s->indices_buffer, &s->indices_layout, data, NGPU_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    ngli_free(indices16);
+    return ret;
 }
 
 void ngli_geometry_set_vertices_buffer(struct geometry *s, struct ngpu_buffer *buffer, struct buffer_layout layout)
@@ -179,6 +199,13 @@ int ngli_geometry_init(struct geometry *s, enum ngpu_primitive_topology topology
         return NGL_ERROR_INVALID_ARG;
     }
 
+    const struct ngpu_limits *limits = &s->gpu_ctx->limits;
+    if (s->indices_buffer && s->max_indices > limits->max_draw_indexed_index_value) {
+        LOG(ERROR, "indices value (%" PRId64 ") exceeds device limits (%u)",
+            s->max_indices, limits->max_draw_indexed_index_value);
+        return NGL_ERROR_GRAPHICS_LIMIT_EXCEEDED;
+    }
+
     return 0;
 }
 
@@ -55,7 +55,7 @@ struct geometry *ngli_geometry_create(struct ngpu_ctx *gpu_ctx);
 int ngli_geometry_set_vertices(struct geometry *s, size_t n, const float *vertices);
 int ngli_geometry_set_uvcoords(struct geometry *s, size_t n, const float *uvcoords);
 int ngli_geometry_set_normals(struct geometry *s, size_t n, const float *indices);
-int ngli_geometry_set_indices(struct geometry *s, size_t n, const uint16_t *indices);
+int ngli_geometry_set_indices(struct geometry *s, size_t n, const uint32_t *indices);
 
 /* With the following functions, the user own the buffers already */
 void ngli_geometry_set_vertices_buffer(struct geometry *s, struct ngpu_buffer *buffer, struct buffer_layout layout);
@@ -374,7 +374,11 @@ vec3 root_find3_expected(int topology, float a, float b, float c, float d)
     return vec3(LARGE_FLOAT);
 }
 
-/* TODO: can we reduce the number of polynomial to evaluate for a given pixel? */
+/*
+ * Only the beziers that can affect the current tile are available: in each
+ * group, the first distance_counts[j] ones are candidates for the closest
+ * curve, and the others are only needed for the winding number.
+ */
 vec4 get_color(vec2 p)
 {
     float dist = LARGE_FLOAT;
@@ -389,11 +393,12 @@ vec4 get_color(vec2 p)
          */
         int bezier_count = abs(bezier_counts[j]);
         bool closed = bezier_counts[j] < 0;
+        int distance_count = distance_counts[j];
 
         int shape_winding_number = 0;
         float shape_min_dist = LARGE_FLOAT;
 
-        float shape_area = 0.f;
+        float shape_area = beziergroup_areas[j];
 
         for (int i = 0; i < bezier_count; i++) {
             vec4 bezier_x = bezier_x_buf[base + i];
@@ -403,10 +408,6 @@ vec4 get_color(vec2 p)
             vec2 p2 = vec2(bezier_x.z, bezier_y.z); // control point 2
             vec2 p3 = vec2(bezier_x.w, bezier_y.w); // end point
 
-            shape_area += (p1.x - p0.x) * (p1.y + p0.y);
-            shape_area += (p2.x - p1.x) * (p2.y + p1.y);
-            shape_area += (p3.x - p2.x) * (p3.y + p2.y);
-
             /* Bezier cubic points to polynomial coefficients */
             vec2 a = -p0 + 3.0*(p1 - p2) + p3;
             vec2 b = 3.0 * (p0 - 2.0*p1 + p2);
@@ -414,7 +415,7 @@ vec4 get_color(vec2 p)
             vec2 d = p0;
 
             /* Get smallest distance to current point */
-            if (shape_min_dist > 0.0) {
+            if (i < distance_count && shape_min_dist > 0.0) {
                 /*
                  * Calculate coefficients for the derivative D'(t) (degree 5) of D(t)
                  * where D(t) is the distance squared
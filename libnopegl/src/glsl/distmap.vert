@@ -20,7 +20,8 @@
  * under the License.
  */
 
-const vec2 uvs[] = vec2[](vec2(0.0, 0.0), vec2(0.0, 2.0), vec2(2.0, 0.0));
+const vec2 uvs[] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0),
+                          vec2(0.0, 1.0), vec2(1.0, 0.0), vec2(1.0, 1.0));
 
 void main()
 {
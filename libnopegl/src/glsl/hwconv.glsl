@@ -0,0 +1,28 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* Sample the source video for the destination image pixel at pos */
+vec4 hwconv_load(ivec2 pos)
+{
+    vec2 uv = (vec2(pos) + 0.5) / vec2(imageSize(dst));
+    vec2 tex_coord = (tex_coord_matrix * vec4(uv, 0.0, 1.0)).xy;
+    return ngl_texvideo(tex, tex_coord);
+}
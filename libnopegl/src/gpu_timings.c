@@ -0,0 +1,327 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gpu_timings.h"
+#include "internal.h"
+#include "log.h"
+#include "ngpu/ctx.h"
+#include "nopegl.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
+#include "utils/string.h"
+#include "utils/time.h"
+
+/*
+ * Each recorded entry uses 2 consecutive timestamp queries: the query 2*i
+ * marks the start of the entry i, and the query 2*i+1 its end.
+ */
+struct entry {
+    struct ngl_node *node;
+    int32_t pass;
+};
+
+struct scope {
+    struct ngl_node *node;
+    int32_t pass;
+    int32_t nb_passes;
+    int32_t entry; /* -1 if the entry could not be recorded */
+};
+
+struct gpu_timings {
+    struct ngl_ctx *ctx;
+    struct darray *frames; /* nb_in_flight_frames x struct darray of struct entry */
+    int64_t *frame_start_times; /* CPU time at which each in-flight frame started */
+    size_t nb_frames;
+    struct darray scopes;  /* struct scope */
+    struct darray results; /* struct gpu_timing */
+    uint64_t *timestamps;
+    int overflow_warned;
+};
+
+static const uint32_t timed_nodes[] = {
+    NGL_NODE_COMPUTE,
+    NGL_NODE_FASTGAUSSIANBLUR,
+    NGL_NODE_GAUSSIANBLUR,
+    NGL_NODE_HEXAGONALBLUR,
+    NGL_NODE_RENDERTOTEXTURE,
+};
+
+int ngli_gpu_timings_is_timed_node(const struct ngl_node *node)
+{
+    if (node->cls->category == NGLI_NODE_CATEGORY_DRAW)
+        return 1;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(timed_nodes); i++)
+        if (node->cls->id == timed_nodes[i])
+            return 1;
+    return 0;
+}
+
+struct gpu_timings *ngli_gpu_timings_create(struct ngl_ctx *ctx)
+{
+    struct gpu_timings *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    return s;
+}
+
+int ngli_gpu_timings_init(struct gpu_timings *s)
+{
+    struct ngpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+
+    s->nb_frames = gpu_ctx->nb_in_flight_frames;
+    s->frames = ngli_calloc(s->nb_frames, sizeof(*s->frames));
+    if (!s->frames)
+        return NGL_ERROR_MEMORY;
+    for (size_t i = 0; i < s->nb_frames; i++)
+        ngli_darray_init(&s->frames[i], sizeof(struct entry), 0);
+
+    s->frame_start_times = ngli_calloc(s->nb_frames, sizeof(*s->frame_start_times));
+    if (!s->frame_start_times)
+        return NGL_ERROR_MEMORY;
+
+    ngli_darray_init(&s->scopes, sizeof(struct scope), 0);
+    ngli_darray_init(&s->results, sizeof(struct gpu_timing), 0);
+
+    s->timestamps = ngli_calloc(NGPU_MAX_TIMESTAMP_QUERIES, sizeof(*s->timestamps));
+    if (!s->timestamps)
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+int ngli_gpu_timings_begin_frame(struct gpu_timings *s)
+{
+    struct ngpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+    struct darray *entries_array = &s->frames[gpu_ctx->current_frame_index];
+
+    ngli_darray_clear(&s->scopes);
+
+    const int64_t frame_start_time = s->frame_start_times[gpu_ctx->current_frame_index];
+    s->frame_start_times[gpu_ctx->current_frame_index] = ngli_gettime_relative();
+
+    /* Results from a previous frame must not be reported for this one */
+    ngli_darray_clear(&s->results);
+
+    const size_t nb_entries = ngli_darray_count(entries_array);
+    if (!nb_entries)
+        return 0;
+
+    const uint32_t nb_queries = (uint32_t)nb_entries * 2;
+    int ret = ngpu_ctx_read_timestamps(gpu_ctx, nb_queries, s->timestamps);
+    if (ret < 0) {
+        LOG(ERROR, "could not read back GPU timestamps");
+        ngli_darray_clear(entries_array);
+        return ret;
+    }
+
+    const struct entry *entries = ngli_darray_data(entries_array);
+    for (size_t i = 0; i < nb_entries; i++) {
+        const uint64_t start = s->timestamps[i * 2];
+        const uint64_t end = s->timestamps[i * 2 + 1];
+        const struct gpu_timing timing = {
+            .node = entries[i].node,
+            .pass = entries[i].pass,
+            .time = end > start ? (int64_t)(end - start) : 0,
+        };
+        if (!ngli_darray_push(&s->results, &timing)) {
+            ngli_darray_clear(entries_array);
+            return NGL_ERROR_MEMORY;
+        }
+
+        /*
+         * GPU timestamps are not in the CPU clock domain: the events are
+         * placed on the timeline relatively to the first timestamp of the
+         * frame, itself aligned with the CPU start time of the frame.
+         */
+        const int64_t offset = start > s->timestamps[0] ? (int64_t)(start - s->timestamps[0]) : 0;
+        ngli_tracer_add(s->ctx->tracer, NGLI_TRACER_TRACK_GPU,
+                        timing.pass == NGLI_GPU_TIMING_PASS_NONE ? "gpu_node" : "gpu_pass",
+                        timing.node->label,
+                        frame_start_time + offset / 1000, timing.time / 1000);
+    }
+
+    ngli_darray_clear(entries_array);
+
+    return 0;
+}
+
+static int32_t record_begin(struct gpu_timings *s, struct ngl_node *node, int32_t pass)
+{
+    struct ngpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+    struct darray *entries_array = &s->frames[gpu_ctx->current_frame_index];
+
+    const size_t index = ngli_darray_count(entries_array);
+    if ((index + 1) * 2 > NGPU_MAX_TIMESTAMP_QUERIES) {
+        if (!s->overflow_warned) {
+            LOG(WARNING, "maximum number of GPU timestamp queries (%d) reached, "
+                "some GPU timings will be missing", NGPU_MAX_TIMESTAMP_QUERIES);
+            s->overflow_warned = 1;
+        }
+        return -1;
+    }
+
+    const struct entry entry = {.node = node, .pass = pass};
+    if (!ngli_darray_push(entries_array, &entry))
+        return -1;
+
+    ngpu_ctx_write_timestamp(gpu_ctx, (uint32_t)index * 2);
+
+    return (int32_t)index;
+}
+
+static void record_end(struct gpu_timings *s, int32_t entry)
+{
+    if (entry < 0)
+        return;
+    ngpu_ctx_write_timestamp(s->ctx->gpu_ctx, (uint32_t)entry * 2 + 1);
+}
+
+void ngli_gpu_timings_begin_node(struct gpu_timings *s, struct ngl_node *node)
+{
+    const struct scope scope = {
+        .node  = node,
+        .pass  = NGLI_GPU_TIMING_PASS_NONE,
+        .entry = record_begin(s, node, NGLI_GPU_TIMING_PASS_NONE),
+    };
+    if (!ngli_darray_push(&s->scopes, &scope))
+        record_end(s, scope.entry);
+}
+
+void ngli_gpu_timings_end_node(struct gpu_timings *s)
+{
+    const struct scope *scope = ngli_darray_pop(&s->scopes);
+    ngli_assert(scope && scope->pass == NGLI_GPU_TIMING_PASS_NONE);
+    record_end(s, scope->entry);
+}
+
+static struct scope *get_node_scope(struct gpu_timings *s)
+{
+    struct scope *scopes = ngli_darray_data(&s->scopes);
+    for (size_t i = ngli_darray_count(&s->scopes); i > 0; i--) {
+        struct scope *scope = &scopes[i - 1];
+        if (scope->pass == NGLI_GPU_TIMING_PASS_NONE)
+            return scope;
+    }
+    return NULL;
+}
+
+void ngli_gpu_timings_begin_pass(struct gpu_timings *s)
+{
+    struct scope scope = {.entry = -1};
+    struct scope *node_scope = get_node_scope(s);
+    if (node_scope) {
+        scope.node = node_scope->node;
+        scope.pass = node_scope->nb_passes++;
+        scope.entry = record_begin(s, scope.node, scope.pass);
+    }
+    if (!ngli_darray_push(&s->scopes, &scope))
+        record_end(s, scope.entry);
+}
+
+void ngli_gpu_timings_end_pass(struct gpu_timings *s)
+{
+    const struct scope *scope = ngli_darray_pop(&s->scopes);
+    ngli_assert(scope && scope->pass != NGLI_GPU_TIMING_PASS_NONE);
+    record_end(s, scope->entry);
+}
+
+const struct gpu_timing *ngli_gpu_timings_get_results(const struct gpu_timings *s, size_t *nb_resultsp)
+{
+    *nb_resultsp = ngli_darray_count(&s->results);
+    return ngli_darray_data(&s->results);
+}
+
+void ngli_gpu_timings_freep(struct gpu_timings **sp)
+{
+    struct gpu_timings *s = *sp;
+    if (!s)
+        return;
+    for (size_t i = 0; i < s->nb_frames; i++)
+        ngli_darray_reset(&s->frames[i]);
+    ngli_freep(&s->frames);
+    ngli_freep(&s->frame_start_times);
+    ngli_darray_reset(&s->scopes);
+    ngli_darray_reset(&s->results);
+    ngli_freep(&s->timestamps);
+    ngli_freep(sp);
+}
+
+int ngl_gpu_timings_get(struct ngl_ctx *s, size_t *nb_timingsp, struct ngl_gpu_timing **timingsp)
+{
+    *timingsp = NULL;
+    *nb_timingsp = 0;
+
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the GPU timings");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (!s->config.gpu_timings) {
+        LOG(ERROR, "GPU timings must be enabled in the context configuration");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (!s->gpu_timings)
+        return 0;
+
+    size_t nb;
+    const struct gpu_timing *results = ngli_gpu_timings_get_results(s->gpu_timings, &nb);
+    if (!nb)
+        return 0;
+
+    /* +1 so that we know when to stop in ngl_gpu_timings_freep() */
+    struct ngl_gpu_timing *timings = ngli_calloc(nb + 1, sizeof(*timings));
+    if (!timings)
+        return NGL_ERROR_MEMORY;
+
+    for (size_t i = 0; i < nb; i++) {
+        const struct gpu_timing *result = &results[i];
+        struct ngl_gpu_timing *timing = &timings[i];
+        timing->node_type = result->node->cls->id;
+        timing->node = ngl_node_ref(result->node);
+        timing->label = ngli_strdup(result->node->label);
+        if (!timing->label) {
+            ngl_gpu_timings_freep(&timings);
+            return NGL_ERROR_MEMORY;
+        }
+        timing->pass = result->pass;
+        timing->time = result->time;
+    }
+
+    *timingsp = timings;
+    *nb_timingsp = nb;
+
+    return 0;
+}
+
+void ngl_gpu_timings_freep(struct ngl_gpu_timing **timingsp)
+{
+    struct ngl_gpu_timing *timings = *timingsp;
+    if (!timings)
+        return;
+    for (size_t i = 0; timings[i].node; i++) {
+        struct ngl_gpu_timing *timing = &timings[i];
+        ngl_node_unrefp(&timing->node);
+        ngli_freep(&timing->label);
+    }
+    ngli_freep(timingsp);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GPU_TIMINGS_H
+#define GPU_TIMINGS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+struct ngl_ctx;
+struct ngl_node;
+struct gpu_timings;
+
+#define NGLI_GPU_TIMING_PASS_NONE -1
+
+struct gpu_timing {
+    struct ngl_node *node;
+    int32_t pass; /* render pass index within the node, or NGLI_GPU_TIMING_PASS_NONE for the whole node */
+    int64_t time; /* nanoseconds */
+};
+
+struct gpu_timings *ngli_gpu_timings_create(struct ngl_ctx *ctx);
+int ngli_gpu_timings_init(struct gpu_timings *s);
+
+/*
+ * Resolve the timings recorded the last time the current frame index was used.
+ * Must be called right after ngpu_ctx_begin_draw().
+ */
+int ngli_gpu_timings_begin_frame(struct gpu_timings *s);
+
+int ngli_gpu_timings_is_timed_node(const struct ngl_node *node);
+void ngli_gpu_timings_begin_node(struct gpu_timings *s, struct ngl_node *node);
+void ngli_gpu_timings_end_node(struct gpu_timings *s);
+
+/* Render passes are attributed to the innermost node being timed */
+void ngli_gpu_timings_begin_pass(struct gpu_timings *s);
+void ngli_gpu_timings_end_pass(struct gpu_timings *s);
+
+const struct gpu_timing *ngli_gpu_timings_get_results(const struct gpu_timings *s, size_t *nb_resultsp);
+
+void ngli_gpu_timings_freep(struct gpu_timings **sp);
+
+#endif
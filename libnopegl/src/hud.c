@@ -40,6 +40,7 @@
 #include <sys/types.h>
 
 #include "drawutils.h"
+#include "gpu_timings.h"
 #include "hud.h"
 #include "internal.h"
 #include "log.h"
@@ -54,6 +55,7 @@
 #include "node_texture.h"
 #include "nopegl.h"
 #include "pipeline_compat.h"
+#include "utils/hmap.h"
 #include "utils/memory.h"
 #include "utils/time.h"
 
@@ -77,6 +79,9 @@ struct hud {
     uint32_t bg_color_u32;
     FILE *fp_export;
     struct bstr *csv_line;
+    struct darray gpu_timed_nodes;      /* struct ngl_node *, exported in the CSV when GPU timings are enabled */
+    struct hmap *gpu_timed_nodes_index; /* node -> index in gpu_timed_nodes (+1) */
+    int64_t *gpu_times;
     struct canvas canvas;
     double refresh_rate_interval;
     double last_refresh_time;
@@ -1048,6 +1053,70 @@ static void widgets_draw(struct hud *s)
     }
 }
 
+static int gpu_timings_csv_init(struct hud *s)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    const struct ngl_scene *scene = ctx->scene;
+
+    ngli_darray_init(&s->gpu_timed_nodes, sizeof(struct ngl_node *), 0);
+    if (!ctx->gpu_timings || !scene)
+        return 0;
+
+    s->gpu_timed_nodes_index = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
+    if (!s->gpu_timed_nodes_index)
+        return NGL_ERROR_MEMORY;
+
+    const struct ngl_node **nodes = ngli_darray_data(&scene->nodes);
+    for (size_t i = 0; i < ngli_darray_count(&scene->nodes); i++) {
+        const struct ngl_node *node = nodes[i];
+        if (!ngli_gpu_timings_is_timed_node(node))
+            continue;
+        if (!ngli_darray_push(&s->gpu_timed_nodes, &node))
+            return NGL_ERROR_MEMORY;
+        const size_t index = ngli_darray_count(&s->gpu_timed_nodes);
+        int ret = ngli_hmap_set_u64(s->gpu_timed_nodes_index, (uintptr_t)node, (void *)(uintptr_t)index);
+        if (ret < 0)
+            return ret;
+    }
+
+    s->gpu_times = ngli_calloc(ngli_darray_count(&s->gpu_timed_nodes), sizeof(*s->gpu_times));
+    if (!s->gpu_times && ngli_darray_count(&s->gpu_timed_nodes))
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+static void gpu_timings_csv_header(struct hud *s, struct bstr *dst)
+{
+    const struct ngl_node **nodes = ngli_darray_data(&s->gpu_timed_nodes);
+    for (size_t i = 0; i < ngli_darray_count(&s->gpu_timed_nodes); i++)
+        ngli_bstr_printf(dst, ",%s GPU", nodes[i]->label);
+}
+
+static void gpu_timings_csv_report(struct hud *s, struct bstr *dst)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    const size_t nb_nodes = ngli_darray_count(&s->gpu_timed_nodes);
+    if (!nb_nodes)
+        return;
+
+    memset(s->gpu_times, 0, nb_nodes * sizeof(*s->gpu_times));
+
+    size_t nb_results;
+    const struct gpu_timing *results = ngli_gpu_timings_get_results(ctx->gpu_timings, &nb_results);
+    for (size_t i = 0; i < nb_results; i++) {
+        const struct gpu_timing *result = &results[i];
+        if (result->pass != NGLI_GPU_TIMING_PASS_NONE)
+            continue;
+        const size_t index = (uintptr_t)ngli_hmap_get_u64(s->gpu_timed_nodes_index, (uintptr_t)result->node);
+        if (index)
+            s->gpu_times[index - 1] += result->time;
+    }
+
+    for (size_t i = 0; i < nb_nodes; i++)
+        ngli_bstr_printf(dst, ",%"PRId64, s->gpu_times[i]);
+}
+
 static int widgets_csv_header(struct hud *s)
 {
     s->fp_export = fopen(s->export_filename, "wb");
@@ -1069,6 +1138,7 @@ static int widgets_csv_header(struct hud *s)
         ngli_bstr_print(s->csv_line, i ? "," : "");
         widget_specs[widget->type].csv_header(s, widget, s->csv_line);
     }
+    gpu_timings_csv_header(s, s->csv_line);
 
     ngli_bstr_print(s->csv_line, "\n");
 
@@ -1110,6 +1180,7 @@ static void widgets_csv_report(struct hud *s)
         struct widget *widget = &widgets[i];
         widget_specs[widget->type].csv_report(s, widget, s->csv_line);
     }
+    gpu_timings_csv_report(s, s->csv_line);
     ngli_bstr_print(s->csv_line, "\n");
 
     const size_t len = ngli_bstr_len(s->csv_line);
@@ -1192,6 +1263,10 @@ int ngli_hud_init(struct hud *s)
         LOG(WARNING, "no locale support found, assuming C is currently in use");
 #endif
 
+        ret = gpu_timings_csv_init(s);
+        if (ret < 0)
+            return ret;
+
         return widgets_csv_header(s);
     }
 
@@ -1421,6 +1496,9 @@ void ngli_hud_freep(struct hud **sp)
         fclose(s->fp_export);
         ngli_bstr_freep(&s->csv_line);
     }
+    ngli_darray_reset(&s->gpu_timed_nodes);
+    ngli_hmap_freep(&s->gpu_timed_nodes_index);
+    ngli_freep(&s->gpu_times);
 
     ngli_freep(sp);
 }
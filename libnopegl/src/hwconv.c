@@ -35,27 +35,142 @@
 #include "utils/utils.h"
 
 /* GLSL fragments as string */
+#include "hdr_hlg2sdr_comp.h"
 #include "hdr_hlg2sdr_frag.h"
+#include "hdr_pq2sdr_comp.h"
 #include "hdr_pq2sdr_frag.h"
+#include "hwconv_comp.h"
 #include "hwconv_frag.h"
 #include "hwconv_vert.h"
 
+/*
+ * 8x8 invocations per workgroup stays below the minimum limits guaranteed by
+ * OpenGLES 3.1 and Vulkan (128 invocations per workgroup)
+ */
+#define WORKGROUP_SIZE 8
+
+enum {
+    TRANSFER_SDR,
+    TRANSFER_HLG,
+    TRANSFER_PQ,
+};
+
+static const struct {
+    const char *frag_base;
+    const char *comp_base;
+} shaders_map[] = {
+    [TRANSFER_SDR] = {hwconv_frag,      hwconv_comp},
+    [TRANSFER_HLG] = {hdr_hlg2sdr_frag, hdr_hlg2sdr_comp},
+    [TRANSFER_PQ]  = {hdr_pq2sdr_frag,  hdr_pq2sdr_comp},
+};
+
 static const struct ngpu_pgcraft_iovar vert_out_vars[] = {
     {.name = "tex_coord", .type = NGPU_TYPE_VEC2},
 };
 
-int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
-                     const struct image *dst_image,
-                     const struct image_params *src_params)
+static int get_transfer(const struct image_params *src_params)
 {
-    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
-    hwconv->ctx = ctx;
-    hwconv->src_params = *src_params;
-
-    if (dst_image->params.layout != NGLI_IMAGE_LAYOUT_DEFAULT) {
-        LOG(ERROR, "unsupported output image layout: 0x%x", dst_image->params.layout);
-        return NGL_ERROR_UNSUPPORTED;
+    const struct color_info *src_color_info = &src_params->color_info;
+    if (src_color_info->space == NMD_COL_SPC_BT2020_NCL) {
+        if (src_color_info->transfer == NMD_COL_TRC_ARIB_STD_B67) // HLG
+            return TRANSFER_HLG;
+        if (src_color_info->transfer == NMD_COL_TRC_SMPTE2084) // PQ
+            return TRANSFER_PQ;
     }
+    return TRANSFER_SDR;
+}
+
+static bool use_compute(const struct ngpu_ctx *gpu_ctx, const struct image_params *src_params)
+{
+    if (!(gpu_ctx->features & NGPU_FEATURE_COMPUTE))
+        return false;
+
+    /*
+     * External OES and rectangle samplers are not reliably usable from
+     * compute shaders, so these layouts stay on the render pass path
+     */
+    const enum image_layout src_layout = src_params->layout;
+    return src_layout == NGLI_IMAGE_LAYOUT_DEFAULT ||
+           src_layout == NGLI_IMAGE_LAYOUT_NV12 ||
+           src_layout == NGLI_IMAGE_LAYOUT_YUV;
+}
+
+uint32_t ngli_hwconv_get_dst_usage(const struct ngpu_ctx *gpu_ctx,
+                                   const struct image_params *src_params)
+{
+    if (use_compute(gpu_ctx, src_params))
+        return NGPU_TEXTURE_USAGE_STORAGE_BIT;
+    return NGPU_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT;
+}
+
+static int init_pipeline(struct hwconv *hwconv, const struct pipeline_compat_params *params)
+{
+    struct ngpu_ctx *gpu_ctx = hwconv->ctx->gpu_ctx;
+
+    hwconv->pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
+    if (!hwconv->pipeline_compat)
+        return NGL_ERROR_MEMORY;
+
+    return ngli_pipeline_compat_init(hwconv->pipeline_compat, params);
+}
+
+static int init_compute(struct hwconv *hwconv, const struct image *dst_image, int transfer)
+{
+    struct ngpu_ctx *gpu_ctx = hwconv->ctx->gpu_ctx;
+    struct ngpu_texture *texture = dst_image->planes[0];
+
+    const struct ngpu_pgcraft_texture textures[] = {
+        {
+            .name  = "tex",
+            .type  = NGPU_PGCRAFT_TEXTURE_TYPE_VIDEO,
+            .stage = NGPU_PROGRAM_STAGE_COMP,
+        }, {
+            .name     = "dst",
+            .type     = NGPU_PGCRAFT_TEXTURE_TYPE_IMAGE_2D,
+            .stage    = NGPU_PROGRAM_STAGE_COMP,
+            .writable = 1,
+            .format   = texture->params.format,
+            .texture  = texture,
+        },
+    };
+
+    const struct ngpu_pgcraft_params crafter_params = {
+        .program_label  = "nopegl/hwconv",
+        .comp_base      = shaders_map[transfer].comp_base,
+        .textures       = textures,
+        .nb_textures    = NGLI_ARRAY_NB(textures),
+        .workgroup_size = {WORKGROUP_SIZE, WORKGROUP_SIZE, 1},
+    };
+
+    hwconv->crafter = ngpu_pgcraft_create(gpu_ctx);
+    if (!hwconv->crafter)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngpu_pgcraft_craft(hwconv->crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    const struct pipeline_compat_params params = {
+        .type        = NGPU_PIPELINE_TYPE_COMPUTE,
+        .program     = ngpu_pgcraft_get_program(hwconv->crafter),
+        .layout_desc = ngpu_pgcraft_get_bindgroup_layout_desc(hwconv->crafter),
+        .resources   = ngpu_pgcraft_get_bindgroup_resources(hwconv->crafter),
+        .compat_info = ngpu_pgcraft_get_compat_info(hwconv->crafter),
+    };
+
+    ret = init_pipeline(hwconv, &params);
+    if (ret < 0)
+        return ret;
+
+    hwconv->nb_groups[0] = (uint32_t)(dst_image->params.width  + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+    hwconv->nb_groups[1] = (uint32_t)(dst_image->params.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+
+    return 0;
+}
+
+static int init_graphics(struct hwconv *hwconv, const struct image *dst_image, int transfer)
+{
+    struct ngpu_ctx *gpu_ctx = hwconv->ctx->gpu_ctx;
 
     struct ngpu_texture *texture = dst_image->planes[0];
     const struct ngpu_texture_params *texture_params = &texture->params;
@@ -81,36 +196,14 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
     if (ret < 0)
         return ret;
 
-    const enum image_layout src_layout = src_params->layout;
-    if (src_layout != NGLI_IMAGE_LAYOUT_DEFAULT &&
-        src_layout != NGLI_IMAGE_LAYOUT_NV12 &&
-        src_layout != NGLI_IMAGE_LAYOUT_YUV &&
-        src_layout != NGLI_IMAGE_LAYOUT_NV12_RECTANGLE &&
-        src_layout != NGLI_IMAGE_LAYOUT_MEDIACODEC) {
-        LOG(ERROR, "unsupported texture layout: 0x%x", src_layout);
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
     struct ngpu_pgcraft_texture textures[] = {
         {.name = "tex", .type = NGPU_PGCRAFT_TEXTURE_TYPE_VIDEO, .stage = NGPU_PROGRAM_STAGE_FRAG},
     };
 
-    const char *vert_base = hwconv_vert;
-    const char *frag_base = hwconv_frag;
-
-    const struct color_info *src_color_info = &src_params->color_info;
-    if (src_color_info->space == NMD_COL_SPC_BT2020_NCL) {
-        if (src_color_info->transfer == NMD_COL_TRC_ARIB_STD_B67) { // HLG
-            frag_base = hdr_hlg2sdr_frag;
-        } else if (src_color_info->transfer == NMD_COL_TRC_SMPTE2084)  { // PQ
-            frag_base = hdr_pq2sdr_frag;
-        }
-    }
-
     const struct ngpu_pgcraft_params crafter_params = {
         .program_label    = "nopegl/hwconv",
-        .vert_base        = vert_base,
-        .frag_base        = frag_base,
+        .vert_base        = hwconv_vert,
+        .frag_base        = shaders_map[transfer].frag_base,
         .textures         = textures,
         .nb_textures      = NGLI_ARRAY_NB(textures),
         .vert_out_vars    = vert_out_vars,
@@ -125,10 +218,6 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
     if (ret < 0)
         return ret;
 
-    hwconv->pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
-    if (!hwconv->pipeline_compat)
-        return NGL_ERROR_MEMORY;
-
     const struct pipeline_compat_params params = {
         .type         = NGPU_PIPELINE_TYPE_GRAPHICS,
         .graphics     = {
@@ -144,11 +233,43 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
         .compat_info      = ngpu_pgcraft_get_compat_info(hwconv->crafter),
     };
 
-    ret = ngli_pipeline_compat_init(hwconv->pipeline_compat, &params);
-    if (ret < 0)
-        return ret;
+    return init_pipeline(hwconv, &params);
+}
 
-    return 0;
+int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
+                     const struct image *dst_image,
+                     const struct image_params *src_params)
+{
+    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    hwconv->ctx = ctx;
+    hwconv->src_params = *src_params;
+
+    if (dst_image->params.layout != NGLI_IMAGE_LAYOUT_DEFAULT) {
+        LOG(ERROR, "unsupported output image layout: 0x%x", dst_image->params.layout);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    const enum image_layout src_layout = src_params->layout;
+    if (src_layout != NGLI_IMAGE_LAYOUT_DEFAULT &&
+        src_layout != NGLI_IMAGE_LAYOUT_NV12 &&
+        src_layout != NGLI_IMAGE_LAYOUT_YUV &&
+        src_layout != NGLI_IMAGE_LAYOUT_NV12_RECTANGLE &&
+        src_layout != NGLI_IMAGE_LAYOUT_MEDIACODEC) {
+        LOG(ERROR, "unsupported texture layout: 0x%x", src_layout);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    const int transfer = get_transfer(src_params);
+
+    /*
+     * The destination texture must have been created according to
+     * ngli_hwconv_get_dst_usage()
+     */
+    const uint32_t usage = dst_image->planes[0]->params.usage;
+    hwconv->use_compute = use_compute(gpu_ctx, src_params) && (usage & NGPU_TEXTURE_USAGE_STORAGE_BIT);
+    if (hwconv->use_compute)
+        return init_compute(hwconv, dst_image, transfer);
+    return init_graphics(hwconv, dst_image, transfer);
 }
 
 int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image)
@@ -157,10 +278,19 @@ int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image)
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
     ngli_assert(hwconv->src_params.layout == image->params.layout);
 
-    struct ngpu_rendertarget *rt = hwconv->rt;
     struct pipeline_compat *pipeline = hwconv->pipeline_compat;
 
-    ngpu_ctx_begin_render_pass(gpu_ctx, rt);
+    if (hwconv->use_compute) {
+        if (ngpu_ctx_is_render_pass_active(gpu_ctx))
+            ngpu_ctx_end_render_pass(gpu_ctx);
+
+        ngli_pipeline_compat_update_image(pipeline, 0, image);
+        ngli_pipeline_compat_dispatch(pipeline, hwconv->nb_groups[0], hwconv->nb_groups[1], 1);
+
+        return 0;
+    }
+
+    ngpu_ctx_begin_render_pass(gpu_ctx, hwconv->rt);
 
     ngli_pipeline_compat_update_image(pipeline, 0, image);
     ngli_pipeline_compat_draw(pipeline, 3, 1, 0);
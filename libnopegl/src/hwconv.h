@@ -22,22 +22,37 @@
 #ifndef HWCONV_H
 #define HWCONV_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "image.h"
 #include "ngpu/rendertarget.h"
 #include "pipeline_compat.h"
 #include "ngpu/pgcraft.h"
 
 struct ngl_ctx;
+struct ngpu_ctx;
 
 struct hwconv {
     struct ngl_ctx *ctx;
     struct image_params src_params;
 
+    bool use_compute;
+    uint32_t nb_groups[2];
+
     struct ngpu_rendertarget *rt;
     struct ngpu_pgcraft *crafter;
     struct pipeline_compat *pipeline_compat;
 };
 
+/*
+ * Return the usage flags the destination texture must be created with: the
+ * conversion is done with a compute dispatch writing directly into the
+ * texture when supported by the context, and with a render pass otherwise.
+ */
+uint32_t ngli_hwconv_get_dst_usage(const struct ngpu_ctx *gpu_ctx,
+                                   const struct image_params *src_params);
+
 int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
                      const struct image *dst_image,
                      const struct image_params *src_params);
@@ -77,7 +77,7 @@ static int init_hwconv(struct hwmap *hwmap)
         .mipmap_filter = params->texture_mipmap_filter,
         .wrap_s        = params->texture_wrap_s,
         .wrap_t        = params->texture_wrap_t,
-        .usage         = params->texture_usage | NGPU_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT,
+        .usage         = params->texture_usage | ngli_hwconv_get_dst_usage(gpu_ctx, &mapped_image->params),
     };
 
     hwmap->hwconv_texture = ngpu_texture_create(gpu_ctx);
@@ -270,6 +270,13 @@ end:
     return ret;
 }
 
+bool ngli_hwmap_is_image_shareable(const struct hwmap *hwmap)
+{
+    if (!hwmap->hwmap_class)
+        return false;
+    return hwmap->require_hwconv || !(hwmap->hwmap_class->flags & HWMAP_FLAG_FRAME_OWNER);
+}
+
 void ngli_hwmap_uninit(struct hwmap *hwmap)
 {
     hwmap_reset(hwmap);
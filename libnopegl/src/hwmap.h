@@ -78,6 +78,13 @@ int ngli_hwmap_is_image_layout_supported(enum ngl_backend_type backend, enum ima
 
 int ngli_hwmap_init(struct hwmap *hwmap, struct ngl_ctx *ctx, const struct hwmap_params *params);
 int ngli_hwmap_map_frame(struct hwmap *hwmap, struct nmd_frame *frame, struct image *image);
+
+/*
+ * Return whether the last mapped image only relies on the textures it
+ * references, and can thus be used by other nodes as long as they hold a
+ * reference on them.
+ */
+bool ngli_hwmap_is_image_shareable(const struct hwmap *hwmap);
 void ngli_hwmap_uninit(struct hwmap *hwmap);
 
 #endif /* HWUPLOAD_H */
@@ -29,14 +29,38 @@
 #include "internal.h"
 #include "log.h"
 #include "math_utils.h"
+#include "ngpu/ctx.h"
 #include "ngpu/format.h"
 #include "nopegl.h"
+#include "utils/memory.h"
+
+/* Keep the plane offsets within the staging buffers compatible with the
+ * buffer to texture copy requirements of every backend */
+#define STAGING_PLANE_ALIGNMENT 16
+
+/*
+ * When the GPU supports persistently mapped buffers, the planes are first
+ * copied into a staging buffer owned by the current in-flight frame and then
+ * transferred to the textures by the GPU, allowing the upload of a frame to
+ * overlap with the rendering of the previous ones. A staging buffer is only
+ * reused once the frame which used it previously is completed, which is
+ * guaranteed by the context when starting the update of its in-flight frame
+ * slot.
+ */
+struct staging {
+    struct ngpu_buffer *buffer;
+    uint8_t *data;
+};
 
 struct hwmap_common {
     int32_t width;
     int32_t height;
     size_t nb_planes;
     struct ngpu_texture *planes[4];
+    struct staging *stagings;
+    size_t nb_stagings;
+    size_t staging_size;
+    uint64_t last_frame_count;
 };
 
 static const struct format_desc {
@@ -238,6 +262,96 @@ static int common_init(struct hwmap *hwmap, struct nmd_frame *frame)
 
     hwmap->require_hwconv = !support_direct_rendering(hwmap, desc);
 
+    if (gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT) {
+        common->nb_stagings = gpu_ctx->nb_in_flight_frames;
+        common->stagings = ngli_calloc(common->nb_stagings, sizeof(*common->stagings));
+        if (!common->stagings)
+            return NGL_ERROR_MEMORY;
+        common->last_frame_count = UINT64_MAX;
+    }
+
+    return 0;
+}
+
+static void reset_stagings(struct hwmap_common *common)
+{
+    for (size_t i = 0; i < common->nb_stagings; i++) {
+        struct staging *staging = &common->stagings[i];
+        if (staging->data)
+            ngpu_buffer_unmap(staging->buffer);
+        staging->data = NULL;
+        ngpu_buffer_freep(&staging->buffer);
+    }
+    common->staging_size = 0;
+}
+
+static int init_staging(struct hwmap *hwmap, struct staging *staging, size_t size)
+{
+    struct ngpu_ctx *gpu_ctx = hwmap->ctx->gpu_ctx;
+
+    staging->buffer = ngpu_buffer_create(gpu_ctx);
+    if (!staging->buffer)
+        return NGL_ERROR_MEMORY;
+
+    const uint32_t usage = NGPU_BUFFER_USAGE_DYNAMIC_BIT |
+                           NGPU_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                           NGPU_BUFFER_USAGE_MAP_WRITE |
+                           NGPU_BUFFER_USAGE_MAP_PERSISTENT;
+    int ret = ngpu_buffer_init(staging->buffer, size, usage);
+    if (ret < 0)
+        return ret;
+
+    return ngpu_buffer_map(staging->buffer, 0, size, (void **)&staging->data);
+}
+
+/* Return the staging buffer size required by the frame, or 0 if the frame
+ * layout does not support the streaming path */
+static size_t get_staging_layout(const struct hwmap_common *common, const struct nmd_frame *frame, size_t *offsets)
+{
+    size_t size = 0;
+    for (size_t i = 0; i < common->nb_planes; i++) {
+        if (frame->linesizep[i] <= 0)
+            return 0;
+        const int32_t height = common->planes[i]->params.height;
+        offsets[i] = size;
+        size = NGLI_ALIGN(size + (size_t)frame->linesizep[i] * (size_t)height, STAGING_PLANE_ALIGNMENT);
+    }
+    return size;
+}
+
+static int map_frame_streaming(struct hwmap *hwmap, struct nmd_frame *frame, struct staging *staging,
+                               const size_t *offsets, size_t size)
+{
+    struct hwmap_common *common = hwmap->hwmap_priv_data;
+
+    if (size > common->staging_size) {
+        /* Buffers still in use by in-flight frames are kept alive by the
+         * backends until their completion */
+        reset_stagings(common);
+        for (size_t i = 0; i < common->nb_stagings; i++) {
+            int ret = init_staging(hwmap, &common->stagings[i], size);
+            if (ret < 0) {
+                reset_stagings(common);
+                return ret;
+            }
+        }
+        common->staging_size = size;
+    }
+
+    for (size_t i = 0; i < common->nb_planes; i++) {
+        struct ngpu_texture *plane = common->planes[i];
+        const size_t plane_size = (size_t)frame->linesizep[i] * (size_t)plane->params.height;
+        memcpy(staging->data + offsets[i], frame->datap[i], plane_size);
+    }
+
+    for (size_t i = 0; i < common->nb_planes; i++) {
+        struct ngpu_texture *plane = common->planes[i];
+        const int linesize = frame->linesizep[i] / (int)ngpu_format_get_bytes_per_pixel(plane->params.format);
+        int ret = ngpu_texture_upload_from_buffer(plane, staging->buffer, offsets[i], linesize);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
@@ -247,12 +361,33 @@ static void common_uninit(struct hwmap *hwmap)
 
     for (size_t i = 0; i < NGLI_ARRAY_NB(common->planes); i++)
         ngpu_texture_freep(&common->planes[i]);
+
+    if (common->stagings) {
+        reset_stagings(common);
+        ngli_freep(&common->stagings);
+    }
 }
 
 static int common_map_frame(struct hwmap *hwmap, struct nmd_frame *frame)
 {
+    struct ngpu_ctx *gpu_ctx = hwmap->ctx->gpu_ctx;
     struct hwmap_common *common = hwmap->hwmap_priv_data;
 
+    /*
+     * The staging buffer of the current in-flight frame can only be used once
+     * per frame, any other upload within the same frame falls back on the
+     * synchronous path.
+     */
+    if (common->stagings && common->last_frame_count != gpu_ctx->frame_count) {
+        size_t offsets[4] = {0};
+        const size_t size = get_staging_layout(common, frame, offsets);
+        if (size) {
+            struct staging *staging = &common->stagings[gpu_ctx->current_frame_index];
+            common->last_frame_count = gpu_ctx->frame_count;
+            return map_frame_streaming(hwmap, frame, staging, offsets, size);
+        }
+    }
+
     for (size_t i = 0; i < common->nb_planes; i++) {
         struct ngpu_texture *plane = common->planes[i];
         struct ngpu_texture_params *params = &plane->params;
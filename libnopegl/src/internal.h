@@ -40,15 +40,21 @@
 #include FT_OUTLINE_H
 #endif
 
+#include "gpu_timings.h"
 #include "hud.h"
+#include "media_cache.h"
 #include "ngpu/ctx.h"
 #include "ngpu/rendertarget.h"
 #include "nopegl.h"
 #include "params.h"
 #include "rnode.h"
+#include "rtt_pool.h"
+#include "texture_pool.h"
+#include "tracer.h"
 #include "utils/darray.h"
 #include "utils/hmap.h"
 #include "utils/pthread_compat.h"
+#include "utils/workpool.h"
 
 struct node_class;
 
@@ -92,6 +98,8 @@ struct ngl_ctx {
     struct ngpu_scissor scissor;
     struct ngpu_rendertarget *available_rendertargets[2];
     struct ngpu_rendertarget *current_rendertarget;
+    struct rtt_pool *rtt_pool;
+    struct texture_pool *texture_pool;
     float default_modelview_matrix[16];
     float default_projection_matrix[16];
     struct darray modelview_matrix_stack;
@@ -104,6 +112,12 @@ struct ngl_ctx {
      */
     struct darray activitycheck_nodes;
 
+    /* Worker threads executing the prefetch_async callbacks */
+    struct workpool *prefetch_workpool;
+
+    struct media_cache *media_cache;
+    struct distmap_cache *distmap_cache;
+
     struct hmap *text_builtin_atlasses; // struct text_builtin_atlas
 #if HAVE_TEXT_LIBRARIES
     FT_Library ft_library;
@@ -119,6 +133,8 @@ struct ngl_ctx {
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
+    struct gpu_timings *gpu_timings;
+    struct tracer *tracer;
 
     /* Shared fields */
     pthread_mutex_t lock;
@@ -155,7 +171,8 @@ enum node_state {
     NGLI_NODE_STATE_INIT_FAILED   = -1,
     NGLI_NODE_STATE_UNINITIALIZED = 0, /* post uninit(), default */
     NGLI_NODE_STATE_INITIALIZED   = 1, /* post init() or release() */
-    NGLI_NODE_STATE_READY         = 2, /* post prefetch() */
+    NGLI_NODE_STATE_PREFETCHING   = 2, /* prefetch_async() submitted to the prefetch workers */
+    NGLI_NODE_STATE_READY         = 3, /* post prefetch() */
 };
 
 struct ngl_node {
@@ -173,6 +190,8 @@ struct ngl_node {
 
     int draw_count;
 
+    struct workpool_job *prefetch_job;
+
     int refcount;
     int ctx_refcount;
 
@@ -312,6 +331,25 @@ struct node_class {
      */
     int (*prefetch)(struct ngl_node *node);
 
+    /*
+     * CPU side of the prefetch (file I/O, decoder startup, data conversion)
+     * executed on a prefetch worker thread as soon as the node becomes
+     * active, ahead of the prefetch callback. It must not access the GPU
+     * context, the tracer, or any other node. The prefetch callback is then
+     * called on the rendering thread once the job is completed, either during
+     * a later ngli_node_honor_release_prefetch() or when the node is needed
+     * for an update.
+     *
+     * If the job has been executed, the release callback is called even if
+     * the prefetch callback was not.
+     *
+     * reentrant: no (comparing state against NGLI_NODE_STATE_INITIALIZED)
+     * execution-order: any (concurrently with other prefetch_async jobs)
+     * dispatch: managed
+     * when: as part of ngli_node_honor_release_prefetch(), before the prefetch
+     */
+    int (*prefetch_async)(struct ngl_node *node);
+
     /*
      * Reset node update time (and other potential state used in the update) to
      * force an update during the next api draw call.
@@ -23,6 +23,7 @@
 #include <math.h>
 
 #include "math_utils.h"
+#include "utils/pthread_compat.h"
 #include "utils/utils.h"
 
 static const float zero_vec[4];
@@ -322,6 +323,58 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mat4_mul_batch_c(float *dst, const float *m1, const float *m2, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        ngli_mat4_mul_c(dst + i * 4 * 4, m1 + i * 4 * 4, m2 + i * 4 * 4);
+}
+
+void ngli_mat4_mul_vec4_batch_c(float *dst, const float *m, const float *v, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        ngli_mat4_mul_vec4_c(dst + i * 4, m + i * 4 * 4, v + i * 4);
+}
+
+#if defined(HAVE_X86_INTR)
+typedef void (*mat4_mul_batch_func)(float *dst, const float *m1, const float *m2, size_t n);
+typedef void (*mat4_mul_vec4_batch_func)(float *dst, const float *m, const float *v, size_t n);
+
+static pthread_once_t batch_funcs_once = PTHREAD_ONCE_INIT;
+static mat4_mul_batch_func mat4_mul_batch;
+static mat4_mul_vec4_batch_func mat4_mul_vec4_batch;
+
+static void init_batch_funcs(void)
+{
+    const int has_avx = ngli_cpu_has_avx();
+    mat4_mul_batch      = has_avx ? ngli_mat4_mul_batch_avx      : ngli_mat4_mul_batch_sse;
+    mat4_mul_vec4_batch = has_avx ? ngli_mat4_mul_vec4_batch_avx : ngli_mat4_mul_vec4_batch_sse;
+}
+#endif
+
+void ngli_mat4_mul_batch(float *dst, const float *m1, const float *m2, size_t n)
+{
+#if defined(ARCH_AARCH64)
+    ngli_mat4_mul_batch_aarch64(dst, m1, m2, n);
+#elif defined(HAVE_X86_INTR)
+    pthread_once(&batch_funcs_once, init_batch_funcs);
+    mat4_mul_batch(dst, m1, m2, n);
+#else
+    ngli_mat4_mul_batch_c(dst, m1, m2, n);
+#endif
+}
+
+void ngli_mat4_mul_vec4_batch(float *dst, const float *m, const float *v, size_t n)
+{
+#if defined(ARCH_AARCH64)
+    ngli_mat4_mul_vec4_batch_aarch64(dst, m, v, n);
+#elif defined(HAVE_X86_INTR)
+    pthread_once(&batch_funcs_once, init_batch_funcs);
+    mat4_mul_vec4_batch(dst, m, v, n);
+#else
+    ngli_mat4_mul_vec4_batch_c(dst, m, v, n);
+#endif
+}
+
 void ngli_mat4_look_at(float * restrict dst, float *eye, float *center, float *up)
 {
     float f[3] = NGLI_VEC3_SUB(center, eye);
@@ -22,6 +22,8 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include <stddef.h>
+
 #include "config.h"
 
 #define PI_F32 3.14159265358979323846f
@@ -161,6 +163,26 @@ void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v);
 
+/*
+ * Batch versions of the functions above, operating on n contiguous matrices
+ * and vectors which do not need to be aligned. dst can be the same pointer as
+ * any of the operands. The best implementation for the running CPU is picked
+ * at runtime.
+ */
+void ngli_mat4_mul_batch(float *dst, const float *m1, const float *m2, size_t n);
+void ngli_mat4_mul_vec4_batch(float *dst, const float *m, const float *v, size_t n);
+
+void ngli_mat4_mul_batch_c(float *dst, const float *m1, const float *m2, size_t n);
+void ngli_mat4_mul_vec4_batch_c(float *dst, const float *m, const float *v, size_t n);
+void ngli_mat4_mul_batch_aarch64(float *dst, const float *m1, const float *m2, size_t n);
+void ngli_mat4_mul_vec4_batch_aarch64(float *dst, const float *m, const float *v, size_t n);
+void ngli_mat4_mul_batch_sse(float *dst, const float *m1, const float *m2, size_t n);
+void ngli_mat4_mul_vec4_batch_sse(float *dst, const float *m, const float *v, size_t n);
+void ngli_mat4_mul_batch_avx(float *dst, const float *m1, const float *m2, size_t n);
+void ngli_mat4_mul_vec4_batch_avx(float *dst, const float *m, const float *v, size_t n);
+
+int ngli_cpu_has_avx(void);
+
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
 void ngli_quat_slerp(float * restrict dst, const float *q1, const float *q2, float t);
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "media_cache.h"
+#include "nopegl.h"
+#include "utils/hmap.h"
+#include "utils/memory.h"
+#include "utils/string.h"
+
+struct media_cache {
+    struct hmap *entries; /* struct media_cache_entry */
+};
+
+static void image_set(struct media_cache_image *s, const struct image *image)
+{
+    struct ngpu_texture *planes[NGLI_ARRAY_NB(s->planes)] = {0};
+    for (size_t i = 0; i < image->nb_planes; i++)
+        planes[i] = NGLI_RC_REF(image->planes[i]);
+
+    ngli_media_cache_image_reset(s);
+    s->image = *image;
+    memcpy(s->planes, planes, sizeof(s->planes));
+}
+
+void ngli_media_cache_image_reset(struct media_cache_image *s)
+{
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s->planes); i++)
+        ngpu_texture_freep(&s->planes[i]);
+    ngli_image_reset(&s->image);
+}
+
+struct media_cache *ngli_media_cache_create(void)
+{
+    struct media_cache *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->entries = ngli_hmap_create(NGLI_HMAP_TYPE_STR);
+    if (!s->entries) {
+        ngli_freep(&s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static void entry_freep(struct media_cache_entry **entryp)
+{
+    struct media_cache_entry *entry = *entryp;
+    if (!entry)
+        return;
+
+    nmd_freep(&entry->player);
+    ngli_media_cache_image_reset(&entry->image);
+    pthread_mutex_destroy(&entry->lock);
+    ngli_freep(&entry->key);
+    ngli_freep(entryp);
+}
+
+int ngli_media_cache_get(struct media_cache *s, const char *key, struct media_cache_entry **entryp)
+{
+    struct media_cache_entry *entry = ngli_hmap_get_str(s->entries, key);
+    if (entry) {
+        entry->refcount++;
+        *entryp = entry;
+        return 0;
+    }
+
+    entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+
+    if (pthread_mutex_init(&entry->lock, NULL)) {
+        ngli_freep(&entry);
+        return NGL_ERROR_EXTERNAL;
+    }
+
+    entry->key = ngli_strdup(key);
+    if (!entry->key) {
+        entry_freep(&entry);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = ngli_hmap_set_str(s->entries, key, entry);
+    if (ret < 0) {
+        entry_freep(&entry);
+        return ret;
+    }
+
+    entry->refcount = 1;
+    *entryp = entry;
+    return 0;
+}
+
+void ngli_media_cache_release(struct media_cache *s, struct media_cache_entry **entryp)
+{
+    struct media_cache_entry *entry = *entryp;
+    if (!entry)
+        return;
+    *entryp = NULL;
+
+    ngli_assert(entry->refcount > 0);
+    if (--entry->refcount)
+        return;
+
+    ngli_hmap_set_str(s->entries, entry->key, NULL);
+    entry_freep(&entry);
+}
+
+void ngli_media_cache_start(struct media_cache_entry *entry)
+{
+    pthread_mutex_lock(&entry->lock);
+    if (entry->nb_started++ == 0)
+        nmd_start(entry->player);
+    pthread_mutex_unlock(&entry->lock);
+}
+
+void ngli_media_cache_stop(struct media_cache_entry *entry)
+{
+    pthread_mutex_lock(&entry->lock);
+    ngli_assert(entry->nb_started > 0);
+    if (--entry->nb_started == 0) {
+        nmd_stop(entry->player);
+        entry->has_time = 0;
+        entry->image_frame_id = 0;
+        ngli_media_cache_image_reset(&entry->image);
+    }
+    pthread_mutex_unlock(&entry->lock);
+}
+
+void ngli_media_cache_publish_image(struct media_cache_entry *entry, const struct hwmap_params *params,
+                                    const struct image *image)
+{
+    image_set(&entry->image, image);
+    entry->image_params = *params;
+    entry->image_frame_id = entry->frame_id;
+}
+
+static int hwmap_params_are_compatible(const struct hwmap_params *a, const struct hwmap_params *b)
+{
+    return a->image_layouts         == b->image_layouts         &&
+           a->texture_min_filter    == b->texture_min_filter    &&
+           a->texture_mag_filter    == b->texture_mag_filter    &&
+           a->texture_mipmap_filter == b->texture_mipmap_filter &&
+           a->texture_wrap_s        == b->texture_wrap_s        &&
+           a->texture_wrap_t        == b->texture_wrap_t        &&
+           a->texture_usage         == b->texture_usage;
+}
+
+int ngli_media_cache_borrow_image(const struct media_cache_entry *entry, const struct hwmap_params *params,
+                                  struct media_cache_image *image)
+{
+    if (!entry->image_frame_id || entry->image_frame_id != entry->frame_id)
+        return 0;
+    if (!hwmap_params_are_compatible(&entry->image_params, params))
+        return 0;
+    image_set(image, &entry->image.image);
+    return 1;
+}
+
+void ngli_media_cache_freep(struct media_cache **sp)
+{
+    struct media_cache *s = *sp;
+    if (!s)
+        return;
+    ngli_assert(!ngli_hmap_count(s->entries));
+    ngli_hmap_freep(&s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef MEDIA_CACHE_H
+#define MEDIA_CACHE_H
+
+#include <stdint.h>
+#include <nopemd.h>
+
+#include "hwmap.h"
+#include "image.h"
+#include "utils/pthread_compat.h"
+
+/*
+ * Cache of media players, shared by all the Media nodes of a rendering context.
+ *
+ * Media nodes with the same key (file, decoding options and time remapping)
+ * share a single player: a time requested by a node is only forwarded to the
+ * player if it differs from the last one requested through the entry, and the
+ * nodes are notified of the new frames through the entry frame identifier.
+ *
+ * A new frame is only handed to the first node requesting it. The Texture
+ * mapping it publishes the resulting image in the entry, which is then
+ * borrowed by the other Textures instead of mapping (and uploading) the same
+ * frame again.
+ */
+
+/* Image holding a reference on its planes */
+struct media_cache_image {
+    struct image image;
+    struct ngpu_texture *planes[4];
+};
+
+void ngli_media_cache_image_reset(struct media_cache_image *s);
+
+struct media_cache_entry {
+    char *key;
+    size_t refcount;
+    struct nmd_ctx *player;
+    int nopemd_min_level; /* player logging level, part of the key */
+
+    pthread_mutex_t lock; /* protects nb_started, players are started from prefetch workers */
+    size_t nb_started;
+
+    int has_time;
+    double time;       /* last time requested to the player */
+    uint64_t frame_id; /* identifier of the last frame returned by the player */
+
+    uint64_t image_frame_id; /* frame identifier of the published image, 0 if none */
+    struct hwmap_params image_params;
+    struct media_cache_image image;
+};
+
+struct media_cache;
+
+struct media_cache *ngli_media_cache_create(void);
+
+/*
+ * Get the entry associated with the key, creating it if needed, and take a
+ * reference on it. The player of a new entry is left to the caller.
+ */
+int ngli_media_cache_get(struct media_cache *s, const char *key, struct media_cache_entry **entryp);
+void ngli_media_cache_release(struct media_cache *s, struct media_cache_entry **entryp);
+
+/* Start and stop the entry player, only the first start and last stop are honored */
+void ngli_media_cache_start(struct media_cache_entry *entry);
+void ngli_media_cache_stop(struct media_cache_entry *entry);
+
+void ngli_media_cache_publish_image(struct media_cache_entry *entry, const struct hwmap_params *params,
+                                    const struct image *image);
+
+/*
+ * Borrow the image published for the current frame of the entry. Return 0 if
+ * there is no such image or if it has been mapped with incompatible
+ * parameters.
+ */
+int ngli_media_cache_borrow_image(const struct media_cache_entry *entry, const struct hwmap_params *params,
+                                  struct media_cache_image *image);
+
+void ngli_media_cache_freep(struct media_cache **sp);
+
+#endif
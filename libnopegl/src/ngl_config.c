@@ -54,6 +54,14 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
             return NGL_ERROR_MEMORY;
     }
 
+    if (src->trace_filename) {
+        tmp.trace_filename = ngli_strdup(src->trace_filename);
+        if (!tmp.trace_filename) {
+            ngli_freep(&tmp.hud_export_filename);
+            return NGL_ERROR_MEMORY;
+        }
+    }
+
     if (src->backend_config) {
         if (src->backend == NGL_BACKEND_OPENGL ||
             src->backend == NGL_BACKEND_OPENGLES) {
@@ -61,10 +69,12 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
             tmp.backend_config = ngli_memdup(src->backend_config, size);
             if (!tmp.backend_config) {
                 ngli_freep(&tmp.hud_export_filename);
+                ngli_freep(&tmp.trace_filename);
                 return NGL_ERROR_MEMORY;
             }
         } else {
             ngli_freep(&tmp.hud_export_filename);
+            ngli_freep(&tmp.trace_filename);
             LOG(ERROR, "backend_config %p is not supported by backend %u",
                 src->backend_config, src->backend);
             return NGL_ERROR_UNSUPPORTED;
@@ -80,5 +90,6 @@ void ngli_config_reset(struct ngl_config *config)
 {
     ngli_freep(&config->backend_config);
     ngli_freep(&config->hud_export_filename);
+    ngli_freep(&config->trace_filename);
     memset(config, 0, sizeof(*config));
 }
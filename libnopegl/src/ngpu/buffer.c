@@ -32,6 +32,8 @@ static void buffer_freep(void **bufferp)
 
     ngpu_buffer_wait(*sp);
 
+    (*sp)->gpu_ctx->stats.buffer_memory -= (*sp)->memory_size;
+
     (*sp)->gpu_ctx->cls->buffer_freep(sp);
 }
 
@@ -49,7 +51,14 @@ int ngpu_buffer_init(struct ngpu_buffer *s, size_t size, uint32_t usage)
     s->size = size;
     s->usage = usage;
 
-    return s->gpu_ctx->cls->buffer_init(s);
+    int ret = s->gpu_ctx->cls->buffer_init(s);
+    if (ret < 0)
+        return ret;
+
+    s->memory_size = size;
+    s->gpu_ctx->stats.buffer_memory += size;
+
+    return 0;
 }
 
 int ngpu_buffer_wait(struct ngpu_buffer *s)
@@ -48,6 +48,7 @@ struct ngpu_buffer {
     struct ngpu_ctx *gpu_ctx;
     size_t size;
     uint32_t usage;
+    size_t memory_size; /* size accounted in the context statistics */
 };
 
 NGLI_RC_CHECK_STRUCT(ngpu_buffer);
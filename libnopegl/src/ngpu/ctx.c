@@ -106,7 +106,13 @@ int ngpu_ctx_init(struct ngpu_ctx *s)
     if (ret < 0)
         return ret;
 
-    return ngpu_pgcache_init(&s->program_cache, s);
+    ret = ngpu_pgcache_init(&s->program_cache, s);
+    if (ret < 0)
+        return ret;
+
+    ngli_darray_init(&s->pending_pipelines, sizeof(struct ngpu_pipeline *), 0);
+
+    return ngpu_uniform_arena_init(&s->uniform_arena, s);
 }
 
 int ngpu_ctx_resize(struct ngpu_ctx *s, int32_t width, int32_t height)
@@ -124,6 +130,7 @@ int ngpu_ctx_set_capture_buffer(struct ngpu_ctx *s, void *capture_buffer)
 uint32_t ngpu_ctx_advance_frame(struct ngpu_ctx *s)
 {
     s->current_frame_index = (s->current_frame_index + 1) % s->nb_in_flight_frames;
+    s->frame_count++;
     return s->current_frame_index;
 }
 
@@ -139,7 +146,13 @@ uint32_t ngpu_ctx_get_nb_in_flight_frames(struct ngpu_ctx *s)
 
 int ngpu_ctx_begin_update(struct ngpu_ctx *s)
 {
-    return s->cls->begin_update(s);
+    int ret = s->cls->begin_update(s);
+    if (ret < 0)
+        return ret;
+
+    ngpu_uniform_arena_begin(&s->uniform_arena, NGPU_UNIFORM_ARENA_PHASE_UPDATE);
+
+    return 0;
 }
 
 int ngpu_ctx_end_update(struct ngpu_ctx *s)
@@ -149,7 +162,13 @@ int ngpu_ctx_end_update(struct ngpu_ctx *s)
 
 int ngpu_ctx_begin_draw(struct ngpu_ctx *s)
 {
-    return s->cls->begin_draw(s);
+    int ret = s->cls->begin_draw(s);
+    if (ret < 0)
+        return ret;
+
+    ngpu_uniform_arena_begin(&s->uniform_arena, NGPU_UNIFORM_ARENA_PHASE_DRAW);
+
+    return 0;
 }
 
 int ngpu_ctx_end_draw(struct ngpu_ctx *s, double t)
@@ -162,6 +181,33 @@ int ngpu_ctx_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     return s->cls->query_draw_time(s, time);
 }
 
+int ngpu_ctx_wait_pipelines(struct ngpu_ctx *s)
+{
+    int ret = 0;
+    struct ngpu_pipeline **pipelines = ngli_darray_data(&s->pending_pipelines);
+    for (size_t i = 0; i < ngli_darray_count(&s->pending_pipelines); i++) {
+        const int pipeline_ret = ngpu_pipeline_wait(pipelines[i]);
+        if (pipeline_ret < 0 && ret >= 0)
+            ret = pipeline_ret;
+    }
+    ngli_darray_clear(&s->pending_pipelines);
+    return ret;
+}
+
+int ngpu_ctx_write_timestamp(struct ngpu_ctx *s, uint32_t query)
+{
+    ngli_assert(query < NGPU_MAX_TIMESTAMP_QUERIES);
+    return s->cls->write_timestamp(s, query);
+}
+
+int ngpu_ctx_read_timestamps(struct ngpu_ctx *s, uint32_t nb_queries, uint64_t *timestamps)
+{
+    ngli_assert(nb_queries <= NGPU_MAX_TIMESTAMP_QUERIES);
+    if (!nb_queries)
+        return 0;
+    return s->cls->read_timestamps(s, nb_queries, timestamps);
+}
+
 void ngpu_ctx_wait_idle(struct ngpu_ctx *s)
 {
     s->cls->wait_idle(s);
@@ -175,6 +221,8 @@ void ngpu_ctx_freep(struct ngpu_ctx **sp)
     struct ngpu_ctx *s = *sp;
 
     ngpu_pgcache_reset(&s->program_cache);
+    ngpu_uniform_arena_reset(&s->uniform_arena);
+    ngli_darray_reset(&s->pending_pipelines);
     s->cls->destroy(s);
 
     ngli_config_reset(&s->config);
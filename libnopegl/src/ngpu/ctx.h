@@ -35,6 +35,8 @@
 #include "pipeline.h"
 #include "rendertarget.h"
 #include "texture.h"
+#include "uniform_arena.h"
+#include "utils/darray.h"
 
 const char *ngli_backend_get_string_id(enum ngl_backend_type backend);
 const char *ngli_backend_get_full_name(enum ngl_backend_type backend);
@@ -55,6 +57,7 @@ int ngpu_viewport_is_valid(const struct ngpu_viewport *viewport);
 #define NGPU_FEATURE_STORAGE_BUFFER                    (1U << 3)
 #define NGPU_FEATURE_BUFFER_MAP_PERSISTENT             (1U << 4)
 #define NGPU_FEATURE_DEPTH_STENCIL_RESOLVE             (1U << 5)
+#define NGPU_FEATURE_TIMESTAMP_QUERY                   (1U << 6)
 
 struct ngpu_ctx_class {
     uint32_t id;
@@ -68,6 +71,8 @@ struct ngpu_ctx_class {
     int (*begin_draw)(struct ngpu_ctx *s);
     int (*end_draw)(struct ngpu_ctx *s, double t);
     int (*query_draw_time)(struct ngpu_ctx *s, int64_t *time);
+    int (*write_timestamp)(struct ngpu_ctx *s, uint32_t query);
+    int (*read_timestamps)(struct ngpu_ctx *s, uint32_t nb_queries, uint64_t *timestamps);
     void (*wait_idle)(struct ngpu_ctx *s);
     void (*destroy)(struct ngpu_ctx *s);
 
@@ -120,6 +125,7 @@ struct ngpu_ctx_class {
 
     struct ngpu_pipeline *(*pipeline_create)(struct ngpu_ctx *ctx);
     int (*pipeline_init)(struct ngpu_pipeline *s);
+    int (*pipeline_wait)(struct ngpu_pipeline *s);
     void (*pipeline_freep)(struct ngpu_pipeline **sp);
 
     struct ngpu_program *(*program_create)(struct ngpu_ctx *ctx);
@@ -134,10 +140,17 @@ struct ngpu_ctx_class {
     int (*texture_init)(struct ngpu_texture *s, const struct ngpu_texture_params *params);
     int (*texture_upload)(struct ngpu_texture *s, const uint8_t *data, int linesize);
     int (*texture_upload_with_params)(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+    int (*texture_upload_from_buffer)(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize);
     int (*texture_generate_mipmap)(struct ngpu_texture *s);
     void (*texture_freep)(struct ngpu_texture **sp);
 };
 
+struct ngpu_ctx_stats {
+    size_t nb_pipelines;   /* number of initialized pipelines */
+    size_t buffer_memory;  /* size in bytes of the initialized buffers */
+    size_t texture_memory; /* estimated size in bytes of the initialized textures */
+};
+
 struct ngpu_ctx {
     struct ngl_config config;
     const struct ngpu_ctx_class *cls;
@@ -149,8 +162,12 @@ struct ngpu_ctx {
 
     uint32_t nb_in_flight_frames;
     uint32_t current_frame_index;
+    uint64_t frame_count; /* number of frames started with ngpu_ctx_advance_frame() */
 
     struct ngpu_pgcache program_cache;
+    struct ngpu_uniform_arena uniform_arena;
+    struct darray pending_pipelines; /* struct ngpu_pipeline pointer */
+    struct ngpu_ctx_stats stats;
 
 #if DEBUG_GPU_CAPTURE
     struct ngpu_capture_ctx *gpu_capture_ctx;
@@ -180,6 +197,27 @@ int ngpu_ctx_end_update(struct ngpu_ctx *s);
 int ngpu_ctx_begin_draw(struct ngpu_ctx *s);
 int ngpu_ctx_end_draw(struct ngpu_ctx *s, double t);
 int ngpu_ctx_query_draw_time(struct ngpu_ctx *s, int64_t *time);
+
+/*
+ * Wait for the completion of all the pipelines created since the last call
+ * and return the first compilation error, if any. Backends may compile
+ * programs and pipelines concurrently, so gathering all the pipeline
+ * creations before waiting on them allows them to overlap.
+ */
+int ngpu_ctx_wait_pipelines(struct ngpu_ctx *s);
+
+/*
+ * Timestamp queries (requires NGPU_FEATURE_TIMESTAMP_QUERY and
+ * ngl_config.gpu_timings).
+ *
+ * Each in-flight frame owns NGPU_MAX_TIMESTAMP_QUERIES queries. A query
+ * written during a frame can be read back without stalling once the same frame
+ * index comes back, right after ngpu_ctx_begin_draw(). Timestamps are
+ * expressed in nanoseconds.
+ */
+int ngpu_ctx_write_timestamp(struct ngpu_ctx *s, uint32_t query);
+int ngpu_ctx_read_timestamps(struct ngpu_ctx *s, uint32_t nb_queries, uint64_t *timestamps);
+
 void ngpu_ctx_wait_idle(struct ngpu_ctx *s);
 void ngpu_ctx_freep(struct ngpu_ctx **sp);
 
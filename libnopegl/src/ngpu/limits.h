@@ -34,6 +34,8 @@
 
 #define NGPU_MAX_COLOR_ATTACHMENTS 8
 
+#define NGPU_MAX_TIMESTAMP_QUERIES 2048
+
 struct ngpu_limits {
     uint32_t max_vertex_attributes;
     uint32_t max_texture_image_units;
@@ -54,6 +56,7 @@ struct ngpu_limits {
     uint32_t max_texture_array_layers;
     uint32_t max_color_attachments;
     uint32_t max_draw_buffers;
+    uint32_t max_draw_indexed_index_value;
 };
 
 #endif
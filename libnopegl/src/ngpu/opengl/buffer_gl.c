@@ -45,7 +45,7 @@ static GLbitfield get_gl_barriers(uint32_t usage)
     if (usage & NGPU_BUFFER_USAGE_VERTEX_BUFFER_BIT)
         barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
     if (usage & NGPU_BUFFER_USAGE_MAP_READ)
-        barriers |= GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT;
+        barriers |= GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT;
     if (usage & NGPU_BUFFER_USAGE_MAP_WRITE)
         barriers |= GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT;
     return barriers;
@@ -51,6 +51,7 @@ static void cmd_buffer_gl_freep(void **sp)
     ngpu_cmd_buffer_gl_wait(s);
 
     ngli_darray_reset(&s->refs);
+    ngli_darray_reset(&s->buffer_refs);
     ngli_darray_reset(&s->cmds);
 
     ngli_freep(sp);
@@ -149,6 +150,10 @@ int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s)
     struct ngpu_rendertarget *cur_rendertarget = NULL;
     struct ngpu_pipeline *cur_pipeline = NULL;
 
+    int ret = ngpu_uniform_arena_flush(&gpu_ctx->uniform_arena);
+    if (ret < 0)
+        return ret;
+
     const struct ngpu_cmd_gl *cmds = ngli_darray_data(&s->cmds);
     for (size_t i = 0; i < ngli_darray_count(&s->cmds); i++) {
         const struct ngpu_cmd_gl *cmd = &cmds[i];
@@ -187,6 +192,11 @@ int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s)
             ngpu_texture_generate_mipmap(cmd->generate_texture_mipmap.texture);
             break;
         }
+        case NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP: {
+            const GLuint query = gpu_ctx_gl->timestamp_queries[cmd->write_timestamp.query];
+            gpu_ctx_gl->glQueryCounter(query, GL_TIMESTAMP);
+            break;
+        }
         case NGPU_CMD_TYPE_GL_SET_PIPELINE: {
             cur_pipeline = cmd->set_pipeline.pipeline;
             break;
@@ -226,6 +236,12 @@ int ngpu_cmd_buffer_gl_submit(struct ngpu_cmd_buffer_gl *s)
         }
     }
 
+    /*
+     * The command buffer can be submitted several times before being waited
+     * on (when measuring the draw time for instance); the previous fence is
+     * superseded by the new one since fences are signaled in order.
+     */
+    ngpu_fence_gl_freep(&s->fence);
     s->fence = ngpu_fence_gl_create(gpu_ctx);
     if (!s->fence)
         return NGL_ERROR_GRAPHICS_GENERIC;
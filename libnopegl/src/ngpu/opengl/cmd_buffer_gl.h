@@ -43,6 +43,7 @@ enum ngpu_cmd_type_gl {
     NGPU_CMD_TYPE_GL_SET_VERTEX_BUFFER,
     NGPU_CMD_TYPE_GL_SET_INDEX_BUFFER,
     NGPU_CMD_TYPE_GL_GENERATE_TEXTURE_MIPMAP,
+    NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP,
     NGPU_CMD_TYPE_GL_MAX_ENUM = 0x7FFFFFFF
 };
 
@@ -101,6 +102,10 @@ struct ngpu_cmd_gl {
         struct {
             struct ngpu_texture *texture;
         } generate_texture_mipmap;
+
+        struct {
+            uint32_t query;
+        } write_timestamp;
     };
 };
 
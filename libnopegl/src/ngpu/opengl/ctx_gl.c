@@ -372,12 +372,50 @@ static int timer_init(struct ngpu_ctx *s)
     return 0;
 }
 
+static int timestamp_queries_init(struct ngpu_ctx *s)
+{
+    const struct ngl_config *config = &s->config;
+
+    if (!config->gpu_timings)
+        return 0;
+
+#if defined(TARGET_DARWIN)
+    /* GL_TIMESTAMP queries are not supported on Darwin */
+    LOG(WARNING, "timestamp queries are not supported, GPU timings will be unavailable");
+    return 0;
+#else
+    struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
+    const struct glcontext *gl = s_priv->glcontext;
+
+    if (!(gl->features & (NGLI_FEATURE_GL_TIMER_QUERY | NGLI_FEATURE_GL_EXT_DISJOINT_TIMER_QUERY))) {
+        LOG(WARNING, "timestamp queries are not supported, GPU timings will be unavailable");
+        return 0;
+    }
+
+    const size_t nb_queries = s->nb_in_flight_frames * NGPU_MAX_TIMESTAMP_QUERIES;
+    s_priv->timestamp_queries = ngli_calloc(nb_queries, sizeof(*s_priv->timestamp_queries));
+    if (!s_priv->timestamp_queries)
+        return NGL_ERROR_MEMORY;
+    s_priv->glGenQueries((GLsizei)nb_queries, s_priv->timestamp_queries);
+    s_priv->nb_timestamp_queries = nb_queries;
+
+    s->features |= NGPU_FEATURE_TIMESTAMP_QUERY;
+
+    return 0;
+#endif
+}
+
 static void timer_reset(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
 
-    if (s_priv->glDeleteQueries)
+    if (s_priv->glDeleteQueries) {
         s_priv->glDeleteQueries(2, s_priv->queries);
+        if (s_priv->timestamp_queries)
+            s_priv->glDeleteQueries((GLsizei)s_priv->nb_timestamp_queries, s_priv->timestamp_queries);
+    }
+    ngli_freep(&s_priv->timestamp_queries);
+    s_priv->nb_timestamp_queries = 0;
 }
 
 static struct ngpu_ctx *gl_create(const struct ngl_config *config)
@@ -619,6 +657,10 @@ static int gl_init(struct ngpu_ctx *s)
         gl->funcs.DebugMessageCallback(gl_debug_message_callback, NULL);
     }
 
+    /* Let the driver pick its maximum number of compiler threads */
+    if (gl->features & NGLI_FEATURE_GL_KHR_PARALLEL_SHADER_COMPILE)
+        gl->funcs.MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+
     ngpu_ctx_info_init(s);
 
 #if DEBUG_GPU_CAPTURE
@@ -643,6 +685,10 @@ static int gl_init(struct ngpu_ctx *s)
     if (ret < 0)
         return ret;
 
+    ret = timestamp_queries_init(s);
+    if (ret < 0)
+        return ret;
+
     s_priv->default_rt_layout.samples = gl->samples;
     s_priv->default_rt_layout.nb_colors = 1;
     s_priv->default_rt_layout.colors[0].format = NGPU_FORMAT_R8G8B8A8_UNORM;
@@ -895,7 +941,7 @@ static int gl_begin_draw(struct ngpu_ctx *s)
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
     const struct ngl_config *config = &s->config;
 
-    if (config->hud)
+    if (config->hud || config->stats)
 #if defined(TARGET_DARWIN)
         s_priv->glBeginQuery(GL_TIME_ELAPSED, s_priv->queries[0]);
 #else
@@ -974,7 +1020,7 @@ static int gl_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
 
     const struct ngl_config *config = &s->config;
-    if (!config->hud)
+    if (!config->hud && !config->stats)
         return NGL_ERROR_INVALID_USAGE;
 
     struct ngpu_cmd_buffer_gl *cmd_buffer = s_priv->cur_cmd_buffer;
@@ -1006,6 +1052,42 @@ static int gl_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     return 0;
 }
 
+static int gl_write_timestamp(struct ngpu_ctx *s, uint32_t query)
+{
+    struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
+
+    if (!s_priv->timestamp_queries)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    const uint32_t first_query = s->current_frame_index * NGPU_MAX_TIMESTAMP_QUERIES;
+    return ngpu_cmd_buffer_gl_push(s_priv->cur_cmd_buffer,
+                                   &(struct ngpu_cmd_gl){
+                                       .type = NGPU_CMD_TYPE_GL_WRITE_TIMESTAMP,
+                                       .write_timestamp.query = first_query + query,
+                                   });
+}
+
+static int gl_read_timestamps(struct ngpu_ctx *s, uint32_t nb_queries, uint64_t *timestamps)
+{
+    struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
+
+    if (!s_priv->timestamp_queries)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    /*
+     * The command buffer associated with the current frame index has already
+     * been waited for in gl_begin_draw(), so the results are available.
+     */
+    const uint32_t first_query = s->current_frame_index * NGPU_MAX_TIMESTAMP_QUERIES;
+    for (uint32_t i = 0; i < nb_queries; i++) {
+        GLuint64 timestamp = 0;
+        s_priv->glGetQueryObjectui64v(s_priv->timestamp_queries[first_query + i], GL_QUERY_RESULT, &timestamp);
+        timestamps[i] = timestamp;
+    }
+
+    return 0;
+}
+
 static void gl_wait_idle(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_gl *s_priv = (struct ngpu_ctx_gl *)s;
@@ -1269,6 +1351,8 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
     .begin_draw                         = gl_begin_draw,                         \
     .end_draw                           = gl_end_draw,                           \
     .query_draw_time                    = gl_query_draw_time,                    \
+    .write_timestamp                    = gl_write_timestamp,                    \
+    .read_timestamps                    = gl_read_timestamps,                    \
     .wait_idle                          = gl_wait_idle,                          \
     .destroy                            = gl_destroy,                            \
                                                                                  \
@@ -1322,6 +1406,7 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
                                                                                  \
     .pipeline_create                    = ngpu_pipeline_gl_create,               \
     .pipeline_init                      = ngpu_pipeline_gl_init,                 \
+    .pipeline_wait                      = ngpu_pipeline_gl_wait,                 \
     .pipeline_freep                     = ngpu_pipeline_gl_freep,                \
                                                                                  \
     .program_create                     = ngpu_program_gl_create,                \
@@ -1336,6 +1421,7 @@ const struct ngpu_ctx_class ngpu_ctx_##cls_suffix = {
     .texture_init                       = ngpu_texture_gl_init,                  \
     .texture_upload                     = ngpu_texture_gl_upload,                \
     .texture_upload_with_params         = ngpu_texture_gl_upload_with_params,    \
+    .texture_upload_from_buffer         = ngpu_texture_gl_upload_from_buffer,    \
     .texture_generate_mipmap            = ngpu_texture_gl_generate_mipmap,       \
     .texture_freep                      = ngpu_texture_gl_freep,                 \
 }                                                                                \
@@ -52,6 +52,7 @@
 #define NGLI_FEATURE_GL_FLOAT_BLEND                                (1ULL << 44)
 #define NGLI_FEATURE_GL_EGL_EXT_IMAGE_DMA_BUF_IMPORT_MODIFIERS     (1ULL << 45)
 #define NGLI_FEATURE_GL_VIEWPORT_ARRAY                             (1ULL << 46)
+#define NGLI_FEATURE_GL_KHR_PARALLEL_SHADER_COMPILE                (1ULL << 47)
 
 #define NGLI_FEATURE_GL_COMPUTE_SHADER_ALL (NGLI_FEATURE_GL_COMPUTE_SHADER           | \
                                             NGLI_FEATURE_GL_PROGRAM_INTERFACE_QUERY  | \
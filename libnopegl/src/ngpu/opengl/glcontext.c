@@ -385,6 +385,11 @@ static int glcontext_probe_limits(struct glcontext *glcontext)
 
     GET(GL_MAX_DRAW_BUFFERS, &limits->max_draw_buffers);
 
+    /* The query is only available since OpenGL 4.3, which lifted the limit */
+    limits->max_draw_indexed_index_value = UINT32_MAX;
+    if (glcontext->backend == NGL_BACKEND_OPENGLES || glcontext->version >= 430)
+        GET(GL_MAX_ELEMENT_INDEX, &limits->max_draw_indexed_index_value);
+
     return 0;
 }
 
@@ -211,5 +211,12 @@ static const struct glfeature {
         .extensions     = (const char*[]){"ARB_viewport_array", NULL},
         .funcs_offsets  = (const size_t[]){OFFSET(ViewportIndexedf),
                                            SIZE_MAX}
+    }, {
+        .name           = "khr_parallel_shader_compile",
+        .flag           = NGLI_FEATURE_GL_KHR_PARALLEL_SHADER_COMPILE,
+        .extensions     = (const char*[]){"GL_KHR_parallel_shader_compile", NULL},
+        .es_extensions  = (const char*[]){"GL_KHR_parallel_shader_compile", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(MaxShaderCompilerThreadsKHR),
+                                           SIZE_MAX}
     },
 };
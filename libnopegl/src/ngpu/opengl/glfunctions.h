@@ -116,6 +116,7 @@ struct glfunctions {
     void (NGLI_GL_APIENTRY *InvalidateFramebuffer)(GLenum target, GLsizei numAttachments, const GLenum * attachments);
     void (NGLI_GL_APIENTRY *LinkProgram)(GLuint program);
     void * (NGLI_GL_APIENTRY *MapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    void (NGLI_GL_APIENTRY *MaxShaderCompilerThreadsKHR)(GLuint count);
     void (NGLI_GL_APIENTRY *MemoryBarrier)(GLbitfield barriers);
     void (NGLI_GL_APIENTRY *PixelStorei)(GLenum pname, GLint param);
     void (NGLI_GL_APIENTRY *QueryCounter)(GLuint id, GLenum target);
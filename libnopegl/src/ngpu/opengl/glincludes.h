@@ -111,6 +111,7 @@ typedef void (NGLI_GL_APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint
 # define GL_TIMESTAMP                          0x8E28
 # define GL_TEXTURE_CUBE_MAP_SEAMLESS          0x884F
 # define GL_FRONT_LEFT                         0x0400
+# define GL_MAX_ELEMENT_INDEX                  0x8D6B
 
 /* Compute shaders */
 # define GL_COMPUTE_SHADER                     0x91B9
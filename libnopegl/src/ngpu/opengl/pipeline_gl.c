@@ -173,6 +173,11 @@ int ngpu_pipeline_gl_init(struct ngpu_pipeline *s)
     return 0;
 }
 
+int ngpu_pipeline_gl_wait(struct ngpu_pipeline *s)
+{
+    return ngpu_program_gl_wait((struct ngpu_program *)s->program);
+}
+
 static void set_graphics_state(struct ngpu_pipeline *s)
 {
     struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
@@ -39,6 +39,7 @@ struct ngpu_pipeline_gl {
 
 struct ngpu_pipeline *ngpu_pipeline_gl_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_pipeline_gl_init(struct ngpu_pipeline *s);
+int ngpu_pipeline_gl_wait(struct ngpu_pipeline *s);
 void ngpu_pipeline_gl_draw(struct ngpu_pipeline *s, uint32_t nb_vertices, uint32_t nb_instances, uint32_t first_vertex);
 void ngpu_pipeline_gl_draw_indexed(struct ngpu_pipeline *s, uint32_t nb_indices, uint32_t nb_instances);
 void ngpu_pipeline_gl_dispatch(struct ngpu_pipeline *s, uint32_t nb_group_x, uint32_t nb_group_y, uint32_t nb_group_z);
@@ -84,20 +84,81 @@ struct ngpu_program *ngpu_program_gl_create(struct ngpu_ctx *gpu_ctx)
     return (struct ngpu_program *)s;
 }
 
+static const char *stage_names[NGPU_PROGRAM_STAGE_NB] = {
+    [NGPU_PROGRAM_STAGE_VERT] = "vertex",
+    [NGPU_PROGRAM_STAGE_FRAG] = "fragment",
+    [NGPU_PROGRAM_STAGE_COMP] = "compute",
+};
+
+static void release_compilation_data(struct ngpu_program *s)
+{
+    struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->shader_ids); i++) {
+        gl->funcs.DeleteShader(s_priv->shader_ids[i]);
+        s_priv->shader_ids[i] = 0;
+        ngli_freep(&s_priv->sources[i]);
+    }
+    ngli_freep(&s_priv->label);
+}
+
+static int check_compilation(struct ngpu_program *s)
+{
+    struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const char *label = s_priv->label ? s_priv->label : "";
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->shader_ids); i++) {
+        if (!s_priv->sources[i])
+            continue;
+        int ret = program_check_status(gl, s_priv->shader_ids[i], GL_COMPILE_STATUS);
+        if (ret < 0) {
+            char *s_with_numbers = ngli_numbered_lines(s_priv->sources[i]);
+            if (s_with_numbers) {
+                LOG(ERROR, "failed to compile shader \"%s\":\n%s", label, s_with_numbers);
+                ngli_free(s_with_numbers);
+            }
+            return ret;
+        }
+    }
+
+    int ret = program_check_status(gl, s_priv->id, GL_LINK_STATUS);
+    if (ret < 0) {
+        struct bstr *bstr = ngli_bstr_create();
+        if (bstr) {
+            ngli_bstr_printf(bstr, "failed to link shaders \"%s\":", label);
+            for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->sources); i++) {
+                if (!s_priv->sources[i])
+                    continue;
+                char *s_with_numbers = ngli_numbered_lines(s_priv->sources[i]);
+                if (s_with_numbers) {
+                    ngli_bstr_printf(bstr, "\n\n%s shader:\n%s", stage_names[i], s_with_numbers);
+                    ngli_free(s_with_numbers);
+                }
+            }
+            LOG(ERROR, "%s", ngli_bstr_strptr(bstr));
+            ngli_bstr_freep(&bstr);
+        }
+        return ret;
+    }
+
+    return 0;
+}
+
 int ngpu_program_gl_init(struct ngpu_program *s, const struct ngpu_program_params *params)
 {
     struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
 
-    int ret = 0;
-    struct {
-        const char *name;
+    const struct {
         GLenum type;
         const char *src;
-        GLuint id;
     } shaders[] = {
-        [NGPU_PROGRAM_STAGE_VERT] = {"vertex", GL_VERTEX_SHADER, params->vertex, 0},
-        [NGPU_PROGRAM_STAGE_FRAG] = {"fragment", GL_FRAGMENT_SHADER, params->fragment, 0},
-        [NGPU_PROGRAM_STAGE_COMP] = {"compute", GL_COMPUTE_SHADER, params->compute, 0},
+        [NGPU_PROGRAM_STAGE_VERT] = {GL_VERTEX_SHADER, params->vertex},
+        [NGPU_PROGRAM_STAGE_FRAG] = {GL_FRAGMENT_SHADER, params->fragment},
+        [NGPU_PROGRAM_STAGE_COMP] = {GL_COMPUTE_SHADER, params->compute},
     };
 
     struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
@@ -109,60 +170,53 @@ int ngpu_program_gl_init(struct ngpu_program *s, const struct ngpu_program_param
         return NGL_ERROR_GRAPHICS_UNSUPPORTED;
     }
 
+    if (params->label) {
+        s_priv->label = ngli_strdup(params->label);
+        if (!s_priv->label)
+            return NGL_ERROR_MEMORY;
+    }
+
     s_priv->id = gl->funcs.CreateProgram();
 
     for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
         if (!shaders[i].src)
             continue;
+        s_priv->sources[i] = ngli_strdup(shaders[i].src);
+        if (!s_priv->sources[i])
+            return NGL_ERROR_MEMORY;
         GLuint shader = gl->funcs.CreateShader(shaders[i].type);
-        shaders[i].id = shader;
+        s_priv->shader_ids[i] = shader;
         gl->funcs.ShaderSource(shader, 1, &shaders[i].src, NULL);
         gl->funcs.CompileShader(shader);
-        ret = program_check_status(gl, shader, GL_COMPILE_STATUS);
-        if (ret < 0) {
-            char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
-            if (s_with_numbers) {
-                LOG(ERROR, "failed to compile shader \"%s\":\n%s",
-                    params->label ? params->label : "", s_with_numbers);
-                ngli_free(s_with_numbers);
-            }
-            goto fail;
-        }
         gl->funcs.AttachShader(s_priv->id, shader);
     }
 
     gl->funcs.LinkProgram(s_priv->id);
-    ret = program_check_status(gl, s_priv->id, GL_LINK_STATUS);
-    if (ret < 0) {
-        struct bstr *bstr = ngli_bstr_create();
-        if (bstr) {
-            ngli_bstr_printf(bstr, "failed to link shaders \"%s\":",
-                             params->label ? params->label : "");
-            for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
-                if (!shaders[i].src)
-                    continue;
-                char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
-                if (s_with_numbers) {
-                    ngli_bstr_printf(bstr, "\n\n%s shader:\n%s", shaders[i].name, s_with_numbers);
-                    ngli_free(s_with_numbers);
-                }
-            }
-            LOG(ERROR, "%s", ngli_bstr_strptr(bstr));
-            ngli_bstr_freep(&bstr);
-        }
-        goto fail;
-    }
 
-    for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++)
-        gl->funcs.DeleteShader(shaders[i].id);
+    /*
+     * With GL_KHR_parallel_shader_compile, the driver compiles and links in
+     * the background as long as we do not query the program status, so the
+     * check is deferred until the program is actually needed.
+     */
+    s_priv->pending = true;
+    if (!(gl->features & NGLI_FEATURE_GL_KHR_PARALLEL_SHADER_COMPILE))
+        return ngpu_program_gl_wait(s);
 
     return 0;
+}
+
+int ngpu_program_gl_wait(struct ngpu_program *s)
+{
+    struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
+
+    if (!s_priv->pending)
+        return s_priv->status;
 
-fail:
-    for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++)
-        gl->funcs.DeleteShader(shaders[i].id);
+    s_priv->status = check_compilation(s);
+    s_priv->pending = false;
+    release_compilation_data(s);
 
-    return ret;
+    return s_priv->status;
 }
 
 void ngpu_program_gl_freep(struct ngpu_program **sp)
@@ -173,6 +227,7 @@ void ngpu_program_gl_freep(struct ngpu_program **sp)
     struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
     struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
+    release_compilation_data(s);
     gl->funcs.DeleteProgram(s_priv->id);
     ngli_freep(sp);
 }
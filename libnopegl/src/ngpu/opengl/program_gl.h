@@ -22,6 +22,8 @@
 #ifndef NGPU_PROGRAM_GL_H
 #define NGPU_PROGRAM_GL_H
 
+#include <stdbool.h>
+
 #include "glincludes.h"
 #include "ngpu/program.h"
 
@@ -30,10 +32,18 @@ struct ngpu_ctx;
 struct ngpu_program_gl {
     struct ngpu_program parent;
     GLuint id;
+
+    /* Compilation state, kept until the program status is checked */
+    GLuint shader_ids[NGPU_PROGRAM_STAGE_NB];
+    char *sources[NGPU_PROGRAM_STAGE_NB];
+    char *label;
+    bool pending;
+    int status;
 };
 
 struct ngpu_program *ngpu_program_gl_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_program_gl_init(struct ngpu_program *s, const struct ngpu_program_params *params);
+int ngpu_program_gl_wait(struct ngpu_program *s);
 void ngpu_program_gl_freep(struct ngpu_program **sp);
 
 #endif
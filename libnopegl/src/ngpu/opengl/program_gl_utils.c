@@ -38,6 +38,10 @@ int ngpu_program_gl_set_locations_and_bindings(struct ngpu_program *s,
     struct glcontext *gl = gpu_ctx_gl->glcontext;
     struct ngpu_program_gl *s_priv = (struct ngpu_program_gl *)s;
 
+    int ret = ngpu_program_gl_wait(s);
+    if (ret < 0)
+        return ret;
+
     const char *name = NULL;
     int need_relink = 0;
     const struct ngpu_vertex_state vertex_state = ngpu_pgcraft_get_vertex_state(crafter);
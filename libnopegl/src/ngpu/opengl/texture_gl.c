@@ -23,6 +23,7 @@
 
 #include <string.h>
 
+#include "buffer_gl.h"
 #include "ctx_gl.h"
 #include "format_gl.h"
 #include "glcontext.h"
@@ -424,6 +425,40 @@ int ngpu_texture_gl_upload_with_params(struct ngpu_texture *s, const uint8_t *da
     return 0;
 }
 
+int ngpu_texture_gl_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize)
+{
+    struct ngpu_texture_gl *s_priv = (struct ngpu_texture_gl *)s;
+    struct ngpu_ctx_gl *gpu_ctx_gl = (struct ngpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct ngpu_texture_params *params = &s->params;
+    const struct ngpu_buffer_gl *buffer_gl = (const struct ngpu_buffer_gl *)buffer;
+
+    ngli_assert(!s_priv->wrapped);
+    ngli_assert(params->usage & NGPU_TEXTURE_USAGE_TRANSFER_DST_BIT);
+    ngli_assert(buffer->usage & NGPU_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    const struct ngpu_texture_transfer_params transfer_params = {
+        .width = params->width,
+        .height = params->height,
+        .depth = params->depth,
+        .base_layer = 0,
+        .layer_count = s_priv->array_layers,
+        .pixels_per_row = linesize ? linesize : params->width,
+    };
+
+    /* With a pixel unpack buffer bound, the data pointer is an offset within
+     * the buffer and the transfer is performed asynchronously by the driver */
+    gl->funcs.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_gl->id);
+    gl->funcs.BindTexture(s_priv->target, s_priv->id);
+    texture_upload(s, (const uint8_t *)(uintptr_t)offset, &transfer_params);
+    if (params->mipmap_filter != NGPU_MIPMAP_FILTER_NONE)
+        gl->funcs.GenerateMipmap(s_priv->target);
+    gl->funcs.BindTexture(s_priv->target, 0);
+    gl->funcs.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    return 0;
+}
+
 int ngpu_texture_gl_generate_mipmap(struct ngpu_texture *s)
 {
     struct ngpu_texture_gl *s_priv = (struct ngpu_texture_gl *)s;
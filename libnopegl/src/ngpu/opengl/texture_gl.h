@@ -56,6 +56,7 @@ void ngpu_texture_gl_set_id(struct ngpu_texture *s, GLuint id);
 void ngpu_texture_gl_set_dimensions(struct ngpu_texture *s, int32_t width, int32_t height, int depth);
 int ngpu_texture_gl_upload(struct ngpu_texture *s, const uint8_t *data, int linesize);
 int ngpu_texture_gl_upload_with_params(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+int ngpu_texture_gl_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize);
 int ngpu_texture_gl_generate_mipmap(struct ngpu_texture *s);
 void ngpu_texture_gl_freep(struct ngpu_texture **sp);
 
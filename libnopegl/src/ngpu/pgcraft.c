@@ -67,6 +67,7 @@ struct ngpu_pgcraft {
 
     struct darray texture_infos; // ngpu_pgcraft_texture_info
     struct darray images; // image pointer
+    struct darray constants; // int32_t, indexed by constant id
     struct ngpu_pgcraft_compat_info compat_info;
 
     struct bstr *shaders[NGPU_PROGRAM_STAGE_NB];
@@ -94,6 +95,7 @@ struct ngpu_pgcraft {
     bool has_in_out_layout_qualifiers;
     bool has_precision_qualifiers;
     bool has_explicit_bindings;
+    bool has_specialization_constants;
 };
 
 /*
@@ -322,6 +324,7 @@ static const char * const texture_info_suffixes[NGPU_INFO_FIELD_NB] = {
     [NGPU_INFO_FIELD_COLOR_MATRIX]      = "_color_matrix",
     [NGPU_INFO_FIELD_DIMENSIONS]        = "_dimensions",
     [NGPU_INFO_FIELD_TIMESTAMP]         = "_ts",
+    [NGPU_INFO_FIELD_CLAMP]             = "_clamp",
     [NGPU_INFO_FIELD_SAMPLER_0]         = "",
     [NGPU_INFO_FIELD_SAMPLER_1]         = "_1",
     [NGPU_INFO_FIELD_SAMPLER_2]         = "_2",
@@ -337,6 +340,7 @@ static const enum ngpu_type texture_types_map[NGPU_PGCRAFT_TEXTURE_TYPE_NB][NGPU
         [NGPU_INFO_FIELD_TIMESTAMP]         = NGPU_TYPE_F32,
         [NGPU_INFO_FIELD_COLOR_MATRIX]      = NGPU_TYPE_MAT4,
         [NGPU_INFO_FIELD_SAMPLING_MODE]     = NGPU_TYPE_I32,
+        [NGPU_INFO_FIELD_CLAMP]             = NGPU_TYPE_BOOL,
         [NGPU_INFO_FIELD_SAMPLER_0]         = NGPU_TYPE_SAMPLER_2D,
         [NGPU_INFO_FIELD_SAMPLER_1]         = NGPU_TYPE_SAMPLER_2D,
         [NGPU_INFO_FIELD_SAMPLER_2]         = NGPU_TYPE_SAMPLER_2D,
@@ -411,6 +415,9 @@ static int prepare_texture_info_fields(struct ngpu_pgcraft *s, const struct ngpu
         const enum ngpu_type type = types_map[i];
         if (type == NGPU_TYPE_NONE || !is_type_supported(s, type))
             continue;
+        /* The clamping is a specialization constant when available */
+        if (i == NGPU_INFO_FIELD_CLAMP && s->has_specialization_constants)
+            continue;
         field->type = type;
         if (graphics && i == NGPU_INFO_FIELD_COORDINATE_MATRIX)
             field->stage = NGPU_PROGRAM_STAGE_VERT;
@@ -433,7 +440,10 @@ static int prepare_texture_infos(struct ngpu_pgcraft *s, const struct ngpu_pgcra
         if (!ngli_darray_push(&s->symbols, texture->name))
             return NGL_ERROR_MEMORY;
 
-        struct ngpu_pgcraft_texture_info info = {.id = ngli_darray_count(&s->symbols) - 1};
+        struct ngpu_pgcraft_texture_info info = {
+            .id          = ngli_darray_count(&s->symbols) - 1,
+            .clamp_video = texture->clamp_video,
+        };
         int ret = prepare_texture_info_fields(s, params, graphics, texture, &info);
         if (ret < 0)
             return ret;
@@ -539,8 +549,27 @@ static int inject_texture(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_text
     return 0;
 }
 
+/*
+ * The clamping of video textures is not baked into the shader code so that
+ * all the variants share the same program. With specialization constants, the
+ * value is provided at pipeline creation; otherwise it is exposed as a
+ * texture info uniform (see NGPU_INFO_FIELD_CLAMP).
+ */
+static int inject_video_constant(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_texture *texture, enum ngpu_program_stage stage)
+{
+    struct bstr *b = s->shaders[stage];
+
+    const int32_t value = texture->clamp_video;
+    const size_t constant_id = ngli_darray_count(&s->constants);
+    if (!ngli_darray_push(&s->constants, &value))
+        return NGL_ERROR_MEMORY;
+    ngli_bstr_printf(b, "layout(constant_id=%zu) const bool %s_clamp = false;\n", constant_id, texture->name);
+    return 0;
+}
+
 static int inject_textures(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_params *params, enum ngpu_program_stage stage)
 {
+    bool has_video = false;
     const struct ngpu_pgcraft_texture *textures = ngli_darray_data(&s->textures);
     const struct ngpu_pgcraft_texture_info *texture_infos = ngli_darray_data(&s->texture_infos);
     for (size_t i = 0; i < ngli_darray_count(&s->texture_infos); i++) {
@@ -548,7 +577,23 @@ static int inject_textures(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_par
         int ret = inject_texture(s, &textures[i], info, stage);
         if (ret < 0)
             return ret;
+
+        if (textures[i].type == NGPU_PGCRAFT_TEXTURE_TYPE_VIDEO && textures[i].stage == stage) {
+            if (s->has_specialization_constants) {
+                ret = inject_video_constant(s, &textures[i], stage);
+                if (ret < 0)
+                    return ret;
+            }
+            has_video = true;
+        }
     }
+
+    if (has_video)
+        ngli_bstr_print(s->shaders[stage],
+                        "vec4 ngli_texvideo_clamp(bool enabled, vec4 color)\n"
+                        "{\n"
+                        "    return enabled ? clamp(color, 0.0, 1.0) : color;\n"
+                        "}\n");
     return 0;
 }
 
@@ -699,7 +744,7 @@ static int inject_ublock(struct ngpu_pgcraft *s, struct bstr *b, enum ngpu_progr
     struct ngpu_pgcraft_block pgcraft_block = {
         /* instance name is empty to make field accesses identical to uniform accesses */
         .instance_name = "",
-        .type          = NGPU_TYPE_UNIFORM_BUFFER,
+        .type          = NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .stage         = stage,
         .block         = block,
     };
@@ -784,17 +829,6 @@ static void set_glsl_header(struct ngpu_pgcraft *s, struct bstr *b, const struct
     ngli_bstr_print(b, "\n");
 }
 
-static int texture_needs_clamping(const struct ngpu_pgcraft_params *params,
-                                  const char *name, size_t name_len)
-{
-    for (size_t i = 0; i < params->nb_textures; i++) {
-        const struct ngpu_pgcraft_texture *pgcraft_texture = &params->textures[i];
-        if (!strncmp(name, pgcraft_texture->name, name_len))
-            return pgcraft_texture->clamp_video;
-    }
-    return 0;
-}
-
 static enum ngpu_pgcraft_texture_type get_texture_type(const struct ngpu_pgcraft_params *params,
                                                      const char *name, size_t name_len)
 {
@@ -896,11 +930,7 @@ static int handle_token(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_params
             return 0;
         }
 
-        const int clamp = texture_needs_clamping(params, arg0_start, arg0_len);
-        if (clamp)
-            ngli_bstr_print(dst, "clamp(");
-
-        ngli_bstr_print(dst, "(");
+        ngli_bstr_printf(dst, "ngli_texvideo_clamp(%.*s_clamp, (", ARG_FMT(arg0));
 
         if (ngli_hwmap_is_image_layout_supported(config->backend, NGLI_IMAGE_LAYOUT_MEDIACODEC)) {
             ngli_bstr_printf(dst, "%.*s_sampling_mode == %d ? ", ARG_FMT(arg0), NGLI_IMAGE_LAYOUT_MEDIACODEC);
@@ -949,9 +979,7 @@ static int handle_token(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_params
             ngli_bstr_print(dst, "vec4(1.0, 0.0, 0.0, 1.0)"); /* red color */
         }
 
-        ngli_bstr_print(dst, ")");
-        if (clamp)
-            ngli_bstr_print(dst, ", 0.0, 1.0)");
+        ngli_bstr_print(dst, "))");
         ngli_bstr_print(dst, p);
     } else {
         ngli_assert(0);
@@ -1222,7 +1250,7 @@ static void probe_ublocks(struct ngpu_pgcraft *s)
         const struct ngpu_bindgroup_layout_entry *entries = ngli_darray_data(array);
         for (size_t j = 0; j < ngli_darray_count(array); j++) {
             const struct ngpu_bindgroup_layout_entry *entry = &entries[j];
-            if (entry->type == NGPU_TYPE_UNIFORM_BUFFER &&
+            if (entry->type == NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC &&
                 entry->binding == binding &&
                 entry->stage_flags == (1U << i)) {
                 info->uindices[i] = (int32_t)j;
@@ -1290,6 +1318,7 @@ static void setup_glsl_info_vk(struct ngpu_pgcraft *s)
     s->has_explicit_bindings        = true;
     s->has_in_out_layout_qualifiers = true;
     s->has_precision_qualifiers     = false;
+    s->has_specialization_constants = true;
 
     /* Bindings are shared across stages and types */
     for (size_t i = 0; i < NGLI_BINDING_TYPE_NB; i++)
@@ -1333,6 +1362,7 @@ struct ngpu_pgcraft *ngpu_pgcraft_create(struct ngpu_ctx *gpu_ctx)
 
     ngli_darray_init(&s->texture_infos, sizeof(struct ngpu_pgcraft_texture_info), 0);
     ngli_darray_init(&s->images, sizeof(struct image *), 0);
+    ngli_darray_init(&s->constants, sizeof(int32_t), 0);
 
     struct ngpu_pgcraft_compat_info *compat_info = &s->compat_info;
     for (size_t i = 0; i < NGLI_ARRAY_NB(compat_info->ublocks); i++) {
@@ -1425,6 +1455,8 @@ int ngpu_pgcraft_craft(struct ngpu_pgcraft *s, const struct ngpu_pgcraft_params
     s->compat_info.texture_infos    = ngli_darray_data(&s->texture_infos);
     s->compat_info.images           = ngli_darray_data(&s->images);
     s->compat_info.nb_texture_infos = ngli_darray_count(&s->texture_infos);
+    s->compat_info.constants        = ngli_darray_data(&s->constants);
+    s->compat_info.nb_constants     = ngli_darray_count(&s->constants);
 
 #if defined(BACKEND_GL) || defined(BACKEND_GLES)
     struct ngpu_ctx *gpu_ctx  = s->gpu_ctx;
@@ -1554,6 +1586,7 @@ void ngpu_pgcraft_freep(struct ngpu_pgcraft **sp)
     ngli_darray_reset(&s->textures);
     ngli_darray_reset(&s->texture_infos);
     ngli_darray_reset(&s->images);
+    ngli_darray_reset(&s->constants);
     ngli_darray_reset(&s->vert_out_vars);
 
     struct ngpu_pgcraft_compat_info *compat_info = &s->compat_info;
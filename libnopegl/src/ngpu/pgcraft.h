@@ -133,6 +133,7 @@ enum {
     NGPU_INFO_FIELD_COLOR_MATRIX,
     NGPU_INFO_FIELD_DIMENSIONS,
     NGPU_INFO_FIELD_TIMESTAMP,
+    NGPU_INFO_FIELD_CLAMP,
     NGPU_INFO_FIELD_SAMPLER_0,
     NGPU_INFO_FIELD_SAMPLER_1,
     NGPU_INFO_FIELD_SAMPLER_2,
@@ -151,6 +152,7 @@ struct ngpu_pgcraft_texture_info_field {
 
 struct ngpu_pgcraft_texture_info {
     size_t id;
+    int32_t clamp_video;
     struct ngpu_pgcraft_texture_info_field fields[NGPU_INFO_FIELD_NB];
 };
 
@@ -173,6 +175,9 @@ struct ngpu_pgcraft_compat_info {
     const struct ngpu_pgcraft_texture_info *texture_infos;
     const struct image **images;
     size_t nb_texture_infos;
+
+    const int32_t *constants;
+    size_t nb_constants;
 };
 
 struct ngpu_pgcraft_params {
@@ -51,7 +51,28 @@ static void pipeline_freep(void **pipelinep)
         return;
 
     struct ngpu_pipeline *s = *sp;
+
+    /*
+     * The pipeline may still be under construction in a worker thread which
+     * reads the graphics state and specialization constants, so it must be
+     * completed before anything gets released.
+     */
+    ngpu_pipeline_wait(s);
+
+    struct darray *pending_pipelines = &s->gpu_ctx->pending_pipelines;
+    struct ngpu_pipeline **pipelines = ngli_darray_data(pending_pipelines);
+    for (size_t i = 0; i < ngli_darray_count(pending_pipelines); i++) {
+        if (pipelines[i] == s) {
+            ngli_darray_remove(pending_pipelines, i);
+            break;
+        }
+    }
+
+    if (s->accounted)
+        s->gpu_ctx->stats.nb_pipelines--;
+
     ngpu_pipeline_graphics_reset(&s->graphics);
+    ngli_freep(&s->specialization.constants);
 
     (*sp)->gpu_ctx->cls->pipeline_freep(sp);
 }
@@ -75,8 +96,26 @@ int ngpu_pipeline_init(struct ngpu_pipeline *s, const struct ngpu_pipeline_param
 
     s->program  = params->program;
     s->layout = params->layout;
+    NGLI_ARRAY_MEMDUP(&s->specialization, &params->specialization, constants);
+
+    ret = s->gpu_ctx->cls->pipeline_init(s);
+    if (ret < 0)
+        return ret;
 
-    return s->gpu_ctx->cls->pipeline_init(s);
+    s->accounted = 1;
+    s->gpu_ctx->stats.nb_pipelines++;
+
+    if (s->gpu_ctx->cls->pipeline_wait &&
+        !ngli_darray_push(&s->gpu_ctx->pending_pipelines, &s))
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+int ngpu_pipeline_wait(struct ngpu_pipeline *s)
+{
+    const struct ngpu_ctx_class *cls = s->gpu_ctx->cls;
+    return cls->pipeline_wait ? cls->pipeline_wait(s) : 0;
 }
 
 void ngpu_pipeline_freep(struct ngpu_pipeline **sp)
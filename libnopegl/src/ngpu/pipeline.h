@@ -88,11 +88,22 @@ struct ngpu_pipeline_layout {
     const struct ngpu_bindgroup_layout *bindgroup_layout;
 };
 
+/*
+ * Values of the program specialization constants, indexed by constant id.
+ * Backends without specialization constants support have these values
+ * embedded in the shader sources and ignore them.
+ */
+struct ngpu_pipeline_specialization {
+    const int32_t *constants;
+    size_t nb_constants;
+};
+
 struct ngpu_pipeline_params {
     enum ngpu_pipeline_type type;
     const struct ngpu_pipeline_graphics graphics;
     const struct ngpu_program *program;
     const struct ngpu_pipeline_layout layout;
+    const struct ngpu_pipeline_specialization specialization;
 };
 
 struct ngpu_pipeline {
@@ -103,6 +114,8 @@ struct ngpu_pipeline {
     struct ngpu_pipeline_graphics graphics;
     const struct ngpu_program *program;
     struct ngpu_pipeline_layout layout;
+    struct ngpu_pipeline_specialization specialization;
+    int accounted; /* whether the pipeline is counted in the context statistics */
 };
 
 NGLI_RC_CHECK_STRUCT(ngpu_pipeline);
@@ -112,6 +125,13 @@ void ngpu_pipeline_graphics_reset(struct ngpu_pipeline_graphics *graphics);
 
 struct ngpu_pipeline *ngpu_pipeline_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_pipeline_init(struct ngpu_pipeline *s, const struct ngpu_pipeline_params *params);
+
+/*
+ * Pipeline creation (including the compilation of its program) may complete
+ * asynchronously; this function waits for it and returns its result. It must
+ * be called before using the pipeline.
+ */
+int ngpu_pipeline_wait(struct ngpu_pipeline *s);
 void ngpu_pipeline_freep(struct ngpu_pipeline **sp);
 
 #endif
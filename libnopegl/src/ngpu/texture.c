@@ -21,6 +21,8 @@
 
 #include "texture.h"
 #include "ctx.h"
+#include "format.h"
+#include "utils/utils.h"
 
 static void texture_freep(void **texturep)
 {
@@ -28,6 +30,8 @@ static void texture_freep(void **texturep)
     if (!*sp)
         return;
 
+    (*sp)->gpu_ctx->stats.texture_memory -= (*sp)->memory_size;
+
     (*sp)->gpu_ctx->cls->texture_freep(sp);
 }
 
@@ -40,9 +44,27 @@ struct ngpu_texture *ngpu_texture_create(struct ngpu_ctx *gpu_ctx)
     return s;
 }
 
+static size_t get_memory_size(const struct ngpu_texture_params *params)
+{
+    size_t size = (size_t)params->width * (size_t)params->height * (size_t)NGLI_MAX(params->depth, 1);
+    size *= ngpu_format_get_bytes_per_pixel(params->format) * (size_t)NGLI_MAX(params->samples, 1);
+    if (params->type == NGPU_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    if (params->mipmap_filter != NGPU_MIPMAP_FILTER_NONE)
+        size += size / 3;
+    return size;
+}
+
 int ngpu_texture_init(struct ngpu_texture *s, const struct ngpu_texture_params *params)
 {
-    return s->gpu_ctx->cls->texture_init(s, params);
+    int ret = s->gpu_ctx->cls->texture_init(s, params);
+    if (ret < 0)
+        return ret;
+
+    s->memory_size = get_memory_size(params);
+    s->gpu_ctx->stats.texture_memory += s->memory_size;
+
+    return 0;
 }
 
 int ngpu_texture_upload(struct ngpu_texture *s, const uint8_t *data, int linesize)
@@ -55,6 +77,11 @@ int ngpu_texture_upload_with_params(struct ngpu_texture *s, const uint8_t *data,
     return s->gpu_ctx->cls->texture_upload_with_params(s, data, transfer_params);
 }
 
+int ngpu_texture_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize)
+{
+    return s->gpu_ctx->cls->texture_upload_from_buffer(s, buffer, offset, linesize);
+}
+
 int ngpu_texture_generate_mipmap(struct ngpu_texture *s)
 {
     return s->gpu_ctx->cls->texture_generate_mipmap(s);
@@ -27,6 +27,7 @@
 #include "utils/utils.h"
 #include "utils/refcount.h"
 
+struct ngpu_buffer;
 struct ngpu_ctx;
 
 enum ngpu_mipmap_filter {
@@ -91,6 +92,7 @@ struct ngpu_texture {
     struct ngli_rc rc;
     struct ngpu_ctx *gpu_ctx;
     struct ngpu_texture_params params;
+    size_t memory_size; /* size accounted in the context statistics */
 };
 
 struct ngpu_texture_transfer_params {
@@ -107,6 +109,14 @@ struct ngpu_texture *ngpu_texture_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_texture_init(struct ngpu_texture *s, const struct ngpu_texture_params *params);
 int ngpu_texture_upload(struct ngpu_texture *s, const uint8_t *data, int linesize);
 int ngpu_texture_upload_with_params(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+
+/*
+ * Upload the texture content from a buffer (created with the
+ * NGPU_BUFFER_USAGE_TRANSFER_SRC_BIT usage) starting at the specified offset.
+ * The copy is recorded in the current command buffer (if any) and the buffer
+ * content must not be modified until it is completed.
+ */
+int ngpu_texture_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize);
 int ngpu_texture_generate_mipmap(struct ngpu_texture *s);
 void ngpu_texture_freep(struct ngpu_texture **sp);
 
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "buffer.h"
+#include "ctx.h"
+#include "log.h"
+#include "uniform_arena.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
+
+#define INITIAL_REGION_SIZE (64 * 1024)
+
+struct ngpu_uniform_arena_garbage {
+    struct ngpu_buffer *buffer;
+    uint8_t *data;
+    int persistent;
+    uint64_t draw_count;
+};
+
+static void release_buffer(struct ngpu_buffer **bufferp, uint8_t **datap, int persistent)
+{
+    if (*bufferp && persistent)
+        ngpu_buffer_unmap(*bufferp);
+    else
+        ngli_freep(datap);
+    *datap = NULL;
+    ngpu_buffer_freep(bufferp);
+}
+
+static void free_garbage(void *user_arg, void *data)
+{
+    struct ngpu_uniform_arena_garbage *garbage = data;
+    release_buffer(&garbage->buffer, &garbage->data, garbage->persistent);
+}
+
+static int create_buffer(struct ngpu_uniform_arena *s, size_t region_size)
+{
+    struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
+
+    const size_t size = region_size * s->nb_regions;
+    uint32_t usage = NGPU_BUFFER_USAGE_DYNAMIC_BIT | NGPU_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (s->persistent)
+        usage |= NGPU_BUFFER_USAGE_MAP_WRITE | NGPU_BUFFER_USAGE_MAP_PERSISTENT;
+    else
+        usage |= NGPU_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    s->buffer = ngpu_buffer_create(gpu_ctx);
+    if (!s->buffer)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngpu_buffer_init(s->buffer, size, usage);
+    if (ret < 0)
+        goto fail;
+
+    if (s->persistent) {
+        ret = ngpu_buffer_map(s->buffer, 0, size, (void **)&s->data);
+        if (ret < 0)
+            goto fail;
+    } else {
+        s->data = ngli_calloc(1, size);
+        if (!s->data) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+    }
+
+    s->region_size = region_size;
+
+    return 0;
+
+fail:
+    ngpu_buffer_freep(&s->buffer);
+    return ret;
+}
+
+int ngpu_uniform_arena_init(struct ngpu_uniform_arena *s, struct ngpu_ctx *gpu_ctx)
+{
+    s->gpu_ctx = gpu_ctx;
+    s->persistent = !!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT);
+    s->alignment = NGLI_MAX(gpu_ctx->limits.min_uniform_block_offset_alignment, 1);
+    s->nb_regions = gpu_ctx->nb_in_flight_frames * NGPU_UNIFORM_ARENA_PHASE_NB;
+    s->region = SIZE_MAX;
+
+    ngli_darray_init(&s->garbage, sizeof(struct ngpu_uniform_arena_garbage), 0);
+    ngli_darray_set_free_func(&s->garbage, free_garbage, NULL);
+
+    return create_buffer(s, NGLI_ALIGN(INITIAL_REGION_SIZE, s->alignment));
+}
+
+void ngpu_uniform_arena_begin(struct ngpu_uniform_arena *s, enum ngpu_uniform_arena_phase phase)
+{
+    const struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
+
+    if (phase == NGPU_UNIFORM_ARENA_PHASE_DRAW) {
+        s->draw_count++;
+
+        /*
+         * At the beginning of a draw phase, all the frames submitted
+         * nb_in_flight_frames ago or earlier are completed. The garbage is
+         * stamped with the draw counter of the previous frame when created
+         * during an update phase, hence the extra frame of margin.
+         */
+        size_t nb_released = 0;
+        const struct ngpu_uniform_arena_garbage *garbages = ngli_darray_data(&s->garbage);
+        while (nb_released < ngli_darray_count(&s->garbage) &&
+               s->draw_count - garbages[nb_released].draw_count > gpu_ctx->nb_in_flight_frames)
+            nb_released++;
+        ngli_darray_remove_range(&s->garbage, 0, nb_released);
+    }
+
+    s->region = gpu_ctx->current_frame_index * NGPU_UNIFORM_ARENA_PHASE_NB + phase;
+    s->offset = 0;
+    s->flushed = 0;
+    s->generation++;
+}
+
+static int grow(struct ngpu_uniform_arena *s, size_t size)
+{
+    int ret = ngpu_uniform_arena_flush(s);
+    if (ret < 0)
+        return ret;
+
+    const struct ngpu_uniform_arena_garbage garbage = {
+        .buffer     = s->buffer,
+        .data       = s->data,
+        .persistent = s->persistent,
+        .draw_count = s->draw_count,
+    };
+    if (!ngli_darray_push(&s->garbage, &garbage))
+        return NGL_ERROR_MEMORY;
+    s->buffer = NULL;
+    s->data = NULL;
+
+    const size_t region_size = NGLI_ALIGN(NGLI_MAX(s->region_size * 2, size), s->alignment);
+    LOG(DEBUG, "growing uniform arena regions to %zu bytes", region_size);
+    ret = create_buffer(s, region_size);
+    if (ret < 0)
+        return ret;
+
+    s->offset = 0;
+    s->flushed = 0;
+    s->generation++;
+
+    return 0;
+}
+
+int ngpu_uniform_arena_alloc(struct ngpu_uniform_arena *s, const void *data, size_t size,
+                             struct ngpu_buffer **bufferp, uint32_t *offsetp)
+{
+    if (s->region == SIZE_MAX) {
+        LOG(ERROR, "uniform data can only be allocated during an update or a draw");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (s->offset + size > s->region_size) {
+        int ret = grow(s, size);
+        if (ret < 0)
+            return ret;
+    }
+
+    const size_t offset = s->region * s->region_size + s->offset;
+    memcpy(s->data + offset, data, size);
+    s->offset = NGLI_ALIGN(s->offset + size, s->alignment);
+
+    *bufferp = s->buffer;
+    *offsetp = (uint32_t)offset;
+
+    return 0;
+}
+
+int ngpu_uniform_arena_flush(struct ngpu_uniform_arena *s)
+{
+    if (s->persistent || s->region == SIZE_MAX || s->flushed == s->offset)
+        return 0;
+
+    const size_t offset = s->region * s->region_size + s->flushed;
+    const size_t size = s->offset - s->flushed;
+    int ret = ngpu_buffer_upload(s->buffer, s->data + offset, offset, size);
+    if (ret < 0)
+        return ret;
+    s->flushed = s->offset;
+
+    return 0;
+}
+
+void ngpu_uniform_arena_reset(struct ngpu_uniform_arena *s)
+{
+    ngli_darray_reset(&s->garbage);
+    release_buffer(&s->buffer, &s->data, s->persistent);
+    memset(s, 0, sizeof(*s));
+}
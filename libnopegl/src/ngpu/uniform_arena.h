@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef NGPU_UNIFORM_ARENA_H
+#define NGPU_UNIFORM_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/darray.h"
+
+struct ngpu_buffer;
+struct ngpu_ctx;
+
+/*
+ * Context-wide uniform arena
+ *
+ * The arena is a single uniform buffer split into one region per in-flight
+ * frame and per phase (update and draw). The uniform data of every draw and
+ * dispatch is sub-allocated linearly in the region of the current phase, and
+ * bound with a dynamic offset. A region is recycled once the command buffer
+ * of the phase it belongs to has been waited for.
+ *
+ * When the buffer can be persistently mapped, the uniform data is written
+ * directly into it. Otherwise, the data is written into a CPU copy and
+ * uploaded with a single transfer right before the commands are submitted.
+ *
+ * If a region is exhausted, the arena is reallocated with bigger regions, and
+ * the previous buffer is released once it is no longer in use by the GPU.
+ */
+
+enum ngpu_uniform_arena_phase {
+    NGPU_UNIFORM_ARENA_PHASE_UPDATE,
+    NGPU_UNIFORM_ARENA_PHASE_DRAW,
+    NGPU_UNIFORM_ARENA_PHASE_NB
+};
+
+struct ngpu_uniform_arena {
+    struct ngpu_ctx *gpu_ctx;
+    int persistent;
+    size_t alignment;
+    struct ngpu_buffer *buffer;
+    uint8_t *data;          /* persistent mapping or CPU copy of the buffer */
+    size_t nb_regions;
+    size_t region_size;
+    size_t region;          /* index of the current region, SIZE_MAX outside of a phase */
+    size_t offset;          /* allocation offset within the current region */
+    size_t flushed;         /* offset up to which the current region has been uploaded */
+    uint64_t generation;    /* incremented every time the current allocations are invalidated */
+    uint64_t draw_count;
+    struct darray garbage;  /* struct ngpu_uniform_arena_garbage */
+};
+
+int ngpu_uniform_arena_init(struct ngpu_uniform_arena *s, struct ngpu_ctx *gpu_ctx);
+void ngpu_uniform_arena_begin(struct ngpu_uniform_arena *s, enum ngpu_uniform_arena_phase phase);
+
+/*
+ * Copy size bytes of uniform data into the arena, and return the buffer and
+ * the dynamic offset at which it must be bound.
+ */
+int ngpu_uniform_arena_alloc(struct ngpu_uniform_arena *s, const void *data, size_t size,
+                             struct ngpu_buffer **bufferp, uint32_t *offsetp);
+
+/* Upload the pending uniform data, if the buffer is not persistently mapped */
+int ngpu_uniform_arena_flush(struct ngpu_uniform_arena *s);
+
+void ngpu_uniform_arena_reset(struct ngpu_uniform_arena *s);
+
+#endif
@@ -182,16 +182,17 @@ static VkResult buffer_vk_upload(struct ngpu_buffer *s, const void *data, size_t
     const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
     const VkMemoryPropertyFlags mem_props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    VkResult res = create_vk_buffer(vk, s->size, usage, mem_props,
+    /* The staging buffer only covers the uploaded range */
+    VkResult res = create_vk_buffer(vk, size, usage, mem_props,
                                     &s_priv->staging_buffer, &s_priv->staging_memory);
     if (res != VK_SUCCESS)
         return res;
 
     uint8_t *mapped_data;
-    res = vkMapMemory(vk->device, s_priv->staging_memory, 0, s->size, 0, (void *)&mapped_data);
+    res = vkMapMemory(vk->device, s_priv->staging_memory, 0, size, 0, (void *)&mapped_data);
     if (res != VK_SUCCESS)
         return res;
-    memcpy(mapped_data + offset, data, size);
+    memcpy(mapped_data, data, size);
     vkUnmapMemory(vk->device, s_priv->staging_memory);
 
     struct ngpu_cmd_buffer_vk *cmd_buffer_vk;
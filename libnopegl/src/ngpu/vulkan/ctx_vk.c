@@ -160,6 +160,8 @@ static VkResult create_rendertarget(struct ngpu_ctx *s,
     return VK_SUCCESS;
 }
 
+#define NB_COMPILE_WORKERS 4
+
 #define COLOR_USAGE (NGPU_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | NGPU_TEXTURE_USAGE_TRANSFER_SRC_BIT)
 #define DEPTH_USAGE NGPU_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
 
@@ -318,6 +320,43 @@ static void destroy_query_pool(struct ngpu_ctx *s)
     vkDestroyQueryPool(vk->device, s_priv->query_pool, NULL);
 }
 
+static VkResult create_timestamp_pool(struct ngpu_ctx *s)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+    const struct ngl_config *config = &s->config;
+
+    if (!config->gpu_timings)
+        return VK_SUCCESS;
+
+    if (!vk->phy_device_props.limits.timestampComputeAndGraphics) {
+        LOG(WARNING, "timestamp queries are not supported by the graphics queue, GPU timings will be unavailable");
+        return VK_SUCCESS;
+    }
+
+    const VkQueryPoolCreateInfo create_info = {
+        .sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .queryType  = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = (uint32_t)s->nb_in_flight_frames * NGPU_MAX_TIMESTAMP_QUERIES,
+    };
+
+    VkResult res = vkCreateQueryPool(vk->device, &create_info, NULL, &s_priv->timestamp_pool);
+    if (res != VK_SUCCESS)
+        return res;
+
+    s->features |= NGPU_FEATURE_TIMESTAMP_QUERY;
+
+    return VK_SUCCESS;
+}
+
+static void destroy_timestamp_pool(struct ngpu_ctx *s)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    vkDestroyQueryPool(vk->device, s_priv->timestamp_pool, NULL);
+}
+
 static VkResult create_command_pool_and_buffers(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
@@ -894,6 +933,8 @@ static int vk_init(struct ngpu_ctx *s)
     s->limits.max_compute_work_group_size[2]     = limits->maxComputeWorkGroupSize[2];
     s->limits.max_compute_shared_memory_size     = limits->maxComputeSharedMemorySize;
     s->limits.max_draw_buffers                   = limits->maxColorAttachments;
+    /* Without fullDrawIndexUint32, indices are limited to 24-bit */
+    s->limits.max_draw_indexed_index_value       = vk->dev_features.fullDrawIndexUint32 ? limits->maxDrawIndexedIndexValue : (1U << 24) - 1;
     s->limits.max_samples                        = (uint32_t)get_max_supported_samples(limits);
     /* max_texture_image_units and max_image_units are specific to the OpenGL
      * backend and have no direct Vulkan equivalent so use sane default values */
@@ -919,10 +960,18 @@ static int vk_init(struct ngpu_ctx *s)
     if (ret < 0)
         return ret;
 
+    s_priv->compile_workpool = ngli_workpool_create(NB_COMPILE_WORKERS);
+    if (!s_priv->compile_workpool)
+        return NGL_ERROR_MEMORY;
+
     res = create_query_pool(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    res = create_timestamp_pool(s);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
     res = create_semaphores(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
@@ -1104,11 +1153,22 @@ static int vk_begin_draw(struct ngpu_ctx *s)
         s_priv->default_rt_load->height = s_priv->height;
     }
 
-    if (config->hud) {
+    if (config->hud || config->stats) {
         vkCmdResetQueryPool(s_priv->cur_cmd_buffer->cmd_buf, s_priv->query_pool, 0, 2);
         vkCmdWriteTimestamp(s_priv->cur_cmd_buffer->cmd_buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, s_priv->query_pool, 0);
     }
 
+    /*
+     * The reset is only executed on the GPU once the command buffer is
+     * submitted, so the results of the previous use of this frame slot remain
+     * readable by the host until the end of the frame.
+     */
+    if (s_priv->timestamp_pool) {
+        const uint32_t first_query = s->current_frame_index * NGPU_MAX_TIMESTAMP_QUERIES;
+        vkCmdResetQueryPool(s_priv->cur_cmd_buffer->cmd_buf, s_priv->timestamp_pool,
+                            first_query, NGPU_MAX_TIMESTAMP_QUERIES);
+    }
+
     return 0;
 }
 
@@ -1118,7 +1178,7 @@ static int vk_query_draw_time(struct ngpu_ctx *s, int64_t *time)
     struct vkcontext *vk = s_priv->vkcontext;
     const struct ngl_config *config = &s->config;
 
-    if (!config->hud)
+    if (!config->hud && !config->stats)
         return NGL_ERROR_INVALID_USAGE;
 
     ngli_assert(s_priv->cur_cmd_buffer->cmd_buf);
@@ -1212,12 +1272,57 @@ static void vk_destroy(struct ngpu_ctx *s)
     destroy_render_resources(s);
     destroy_swapchain(s);
     destroy_query_pool(s);
+    destroy_timestamp_pool(s);
 
+    ngli_workpool_freep(&s_priv->compile_workpool);
     ngli_glslang_uninit();
 
     ngli_vkcontext_freep(&s_priv->vkcontext);
 }
 
+static int vk_write_timestamp(struct ngpu_ctx *s, uint32_t query)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+
+    if (!s_priv->timestamp_pool)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    ngli_assert(s_priv->cur_cmd_buffer->cmd_buf);
+    const uint32_t first_query = s->current_frame_index * NGPU_MAX_TIMESTAMP_QUERIES;
+    vkCmdWriteTimestamp(s_priv->cur_cmd_buffer->cmd_buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                        s_priv->timestamp_pool, first_query + query);
+
+    return 0;
+}
+
+static int vk_read_timestamps(struct ngpu_ctx *s, uint32_t nb_queries, uint64_t *timestamps)
+{
+    struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    if (!s_priv->timestamp_pool)
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+
+    /*
+     * The command buffer associated with the current frame index has already
+     * been waited for in vk_begin_draw(), so the results are expected to be
+     * available without stalling.
+     */
+    const uint32_t first_query = s->current_frame_index * NGPU_MAX_TIMESTAMP_QUERIES;
+    VkResult res = vkGetQueryPoolResults(vk->device,
+                                         s_priv->timestamp_pool, first_query, nb_queries,
+                                         nb_queries * sizeof(*timestamps), timestamps, sizeof(*timestamps),
+                                         VK_QUERY_RESULT_64_BIT);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    const double period = vk->phy_device_props.limits.timestampPeriod;
+    for (uint32_t i = 0; i < nb_queries; i++)
+        timestamps[i] = (uint64_t)((double)timestamps[i] * period);
+
+    return 0;
+}
+
 static void vk_wait_idle(struct ngpu_ctx *s)
 {
     struct ngpu_ctx_vk *s_priv = (struct ngpu_ctx_vk *)s;
@@ -1519,6 +1624,8 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
     .end_update                         = vk_end_update,
     .begin_draw                         = vk_begin_draw,
     .query_draw_time                    = vk_query_draw_time,
+    .write_timestamp                    = vk_write_timestamp,
+    .read_timestamps                    = vk_read_timestamps,
     .end_draw                           = vk_end_draw,
     .wait_idle                          = vk_wait_idle,
     .destroy                            = vk_destroy,
@@ -1573,6 +1680,7 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
 
     .pipeline_create                    = ngpu_pipeline_vk_create,
     .pipeline_init                      = ngpu_pipeline_vk_init,
+    .pipeline_wait                      = ngpu_pipeline_vk_wait,
     .pipeline_freep                     = ngpu_pipeline_vk_freep,
 
     .program_create                     = ngpu_program_vk_create,
@@ -1587,6 +1695,7 @@ const struct ngpu_ctx_class ngpu_ctx_vk = {
     .texture_init                       = ngpu_texture_vk_init,
     .texture_upload                     = ngpu_texture_vk_upload,
     .texture_upload_with_params         = ngpu_texture_vk_upload_with_params,
+    .texture_upload_from_buffer         = ngpu_texture_vk_upload_from_buffer,
     .texture_generate_mipmap            = ngpu_texture_vk_generate_mipmap,
     .texture_freep                      = ngpu_texture_vk_freep,
 };
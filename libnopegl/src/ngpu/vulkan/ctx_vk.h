@@ -24,11 +24,13 @@
 
 #include "cmd_buffer_vk.h"
 #include "ngpu/ctx.h"
+#include "utils/workpool.h"
 #include "vkcontext.h"
 
 struct ngpu_ctx_vk {
     struct ngpu_ctx parent;
     struct vkcontext *vkcontext;
+    struct workpool *compile_workpool;
 
     VkSemaphore *image_avail_sems;
     VkSemaphore *update_finished_sems;
@@ -44,6 +46,7 @@ struct ngpu_ctx_vk {
     int cur_cmd_buffer_is_transient;
 
     VkQueryPool query_pool;
+    VkQueryPool timestamp_pool;
 
     VkSurfaceCapabilitiesKHR surface_caps;
     VkSurfaceFormatKHR surface_format;
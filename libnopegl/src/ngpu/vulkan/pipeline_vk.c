@@ -185,6 +185,38 @@ static VkResult create_attribute_descs(struct ngpu_pipeline *s)
     return VK_SUCCESS;
 }
 
+static VkResult create_specialization_info(const struct ngpu_pipeline *s, VkSpecializationInfo *info,
+                                           VkSpecializationMapEntry **entriesp)
+{
+    const struct ngpu_pipeline_specialization *specialization = &s->specialization;
+
+    *entriesp = NULL;
+    if (!specialization->nb_constants)
+        return VK_SUCCESS;
+
+    VkSpecializationMapEntry *entries = ngli_calloc(specialization->nb_constants, sizeof(*entries));
+    if (!entries)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    for (size_t i = 0; i < specialization->nb_constants; i++) {
+        entries[i] = (VkSpecializationMapEntry){
+            .constantID = (uint32_t)i,
+            .offset     = (uint32_t)(i * sizeof(*specialization->constants)),
+            .size       = sizeof(*specialization->constants),
+        };
+    }
+
+    *info = (VkSpecializationInfo){
+        .mapEntryCount = (uint32_t)specialization->nb_constants,
+        .pMapEntries   = entries,
+        .dataSize      = specialization->nb_constants * sizeof(*specialization->constants),
+        .pData         = specialization->constants,
+    };
+    *entriesp = entries;
+
+    return VK_SUCCESS;
+}
+
 static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
 {
     const struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
@@ -294,25 +326,36 @@ static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
         .pDynamicStates    = dynamic_states,
     };
 
+    VkSpecializationInfo specialization_info;
+    VkSpecializationMapEntry *specialization_entries;
+    VkResult res = create_specialization_info(s, &specialization_info, &specialization_entries);
+    if (res != VK_SUCCESS)
+        return res;
+    const VkSpecializationInfo *p_specialization_info = specialization_entries ? &specialization_info : NULL;
+
     const struct ngpu_program_vk *program_vk = (struct ngpu_program_vk *)s->program;
     const VkPipelineShaderStageCreateInfo shader_stage_create_info[2] = {
         {
-            .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            .stage  = VK_SHADER_STAGE_VERTEX_BIT,
-            .module = program_vk->shaders[NGPU_PROGRAM_STAGE_VERT],
-            .pName  = "main",
+            .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage               = VK_SHADER_STAGE_VERTEX_BIT,
+            .module              = program_vk->shaders[NGPU_PROGRAM_STAGE_VERT],
+            .pName               = "main",
+            .pSpecializationInfo = p_specialization_info,
         }, {
-            .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
-            .module = program_vk->shaders[NGPU_PROGRAM_STAGE_FRAG],
-            .pName  = "main",
+            .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage               = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .module              = program_vk->shaders[NGPU_PROGRAM_STAGE_FRAG],
+            .pName               = "main",
+            .pSpecializationInfo = p_specialization_info,
         },
     };
 
     VkRenderPass render_pass;
-    VkResult res = ngpu_vk_create_compatible_renderpass(s->gpu_ctx, &graphics->rt_layout, &render_pass);
-    if (res != VK_SUCCESS)
+    res = ngpu_vk_create_compatible_renderpass(s->gpu_ctx, &graphics->rt_layout, &render_pass);
+    if (res != VK_SUCCESS) {
+        ngli_freep(&specialization_entries);
         return res;
+    }
 
     const VkGraphicsPipelineCreateInfo pipeline_create_info = {
         .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
@@ -333,6 +376,7 @@ static VkResult pipeline_graphics_init(struct ngpu_pipeline *s)
     res = vkCreateGraphicsPipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 
     vkDestroyRenderPass(vk->device, render_pass, NULL);
+    ngli_freep(&specialization_entries);
 
     return res;
 }
@@ -345,12 +389,19 @@ static VkResult pipeline_compute_init(struct ngpu_pipeline *s)
 
     s_priv->pipeline_bind_point = VK_PIPELINE_BIND_POINT_COMPUTE;
 
+    VkSpecializationInfo specialization_info;
+    VkSpecializationMapEntry *specialization_entries;
+    VkResult res = create_specialization_info(s, &specialization_info, &specialization_entries);
+    if (res != VK_SUCCESS)
+        return res;
+
     const struct ngpu_program_vk *program_vk = (struct ngpu_program_vk *)s->program;
     const VkPipelineShaderStageCreateInfo shader_stage_create_info = {
-        .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
-        .module = program_vk->shaders[NGPU_PROGRAM_STAGE_COMP],
-        .pName  = "main",
+        .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+        .stage               = VK_SHADER_STAGE_COMPUTE_BIT,
+        .module              = program_vk->shaders[NGPU_PROGRAM_STAGE_COMP],
+        .pName               = "main",
+        .pSpecializationInfo = specialization_entries ? &specialization_info : NULL,
     };
 
     const VkComputePipelineCreateInfo pipeline_create_info = {
@@ -359,7 +410,9 @@ static VkResult pipeline_compute_init(struct ngpu_pipeline *s)
         .layout = s_priv->pipeline_layout,
     };
 
-    return vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    res = vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    ngli_freep(&specialization_entries);
+    return res;
 }
 
 static VkResult create_pipeline_layout(struct ngpu_pipeline *s)
@@ -404,23 +457,53 @@ struct ngpu_pipeline *ngpu_pipeline_vk_create(struct ngpu_ctx *gpu_ctx)
     return (struct ngpu_pipeline *)s;
 }
 
-static VkResult pipeline_vk_init(struct ngpu_pipeline *s)
+static int create_pipeline_job(void *arg)
 {
+    struct ngpu_pipeline *s = arg;
+
+    /*
+     * The program compilation job has been submitted before this one, so it
+     * is either running or done at this point, which makes this wait safe
+     * from a worker thread.
+     */
+    int ret = ngpu_program_vk_wait((struct ngpu_program *)s->program);
+    if (ret < 0)
+        return ret;
+
+    VkResult res = create_pipeline(s);
+    if (res != VK_SUCCESS)
+        LOG(ERROR, "unable to initialize pipeline: %s", ngli_vk_res2str(res));
+    return ngli_vk_res2ret(res);
+}
+
+int ngpu_pipeline_vk_init(struct ngpu_pipeline *s)
+{
+    struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
+    struct ngpu_pipeline_vk *s_priv = (struct ngpu_pipeline_vk *)s;
+
     if (s->type == NGPU_PIPELINE_TYPE_GRAPHICS) {
         VkResult res = create_attribute_descs(s);
-        if (res != VK_SUCCESS)
-            return res;
+        if (res != VK_SUCCESS) {
+            LOG(ERROR, "unable to initialize pipeline: %s", ngli_vk_res2str(res));
+            return ngli_vk_res2ret(res);
+        }
     }
 
-    return create_pipeline(s);
+    s_priv->job = ngli_workpool_submit(gpu_ctx_vk->compile_workpool, create_pipeline_job, s);
+    if (!s_priv->job)
+        return NGL_ERROR_MEMORY;
+
+    return 0;
 }
 
-int ngpu_pipeline_vk_init(struct ngpu_pipeline *s)
+int ngpu_pipeline_vk_wait(struct ngpu_pipeline *s)
 {
-    VkResult res = pipeline_vk_init(s);
-    if (res != VK_SUCCESS)
-        LOG(ERROR, "unable to initialize pipeline: %s", ngli_vk_res2str(res));
-    return ngli_vk_res2ret(res);
+    struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
+    struct ngpu_pipeline_vk *s_priv = (struct ngpu_pipeline_vk *)s;
+
+    if (s_priv->job)
+        s_priv->status = ngli_workpool_wait(gpu_ctx_vk->compile_workpool, &s_priv->job);
+    return s_priv->status;
 }
 
 static int prepare_and_bind_descriptor_set(struct ngpu_pipeline *s, VkCommandBuffer cmd_buf)
@@ -550,6 +633,8 @@ void ngpu_pipeline_vk_freep(struct ngpu_pipeline **sp)
     struct ngpu_pipeline *s = *sp;
     struct ngpu_pipeline_vk *s_priv = (struct ngpu_pipeline_vk *)s;
 
+    ngpu_pipeline_vk_wait(s);
+
     ngli_darray_reset(&s_priv->vertex_attribute_descs);
     ngli_darray_reset(&s_priv->vertex_binding_descs);
 
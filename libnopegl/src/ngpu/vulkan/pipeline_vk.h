@@ -26,6 +26,7 @@
 
 #include "ngpu/pipeline.h"
 #include "utils/darray.h"
+#include "utils/workpool.h"
 
 struct ngpu_ctx;
 
@@ -38,10 +39,14 @@ struct ngpu_pipeline_vk {
     VkPipelineLayout pipeline_layout;
     VkPipelineBindPoint pipeline_bind_point;
     VkPipeline pipeline;
+
+    struct workpool_job *job; // pipeline creation job
+    int status;
 };
 
 struct ngpu_pipeline *ngpu_pipeline_vk_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_pipeline_vk_init(struct ngpu_pipeline *s);
+int ngpu_pipeline_vk_wait(struct ngpu_pipeline *s);
 void ngpu_pipeline_vk_draw(struct ngpu_pipeline *s, uint32_t nb_vertices, uint32_t nb_instances, uint32_t first_vertex);
 void ngpu_pipeline_vk_draw_indexed(struct ngpu_pipeline *s, uint32_t nb_vertices, uint32_t nb_instances);
 void ngpu_pipeline_vk_dispatch(struct ngpu_pipeline *s, uint32_t nb_group_x, uint32_t nb_group_y, uint32_t nb_group_z);
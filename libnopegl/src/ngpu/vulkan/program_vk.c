@@ -28,6 +28,7 @@
 #include "log.h"
 #include "program_vk.h"
 #include "utils/memory.h"
+#include "utils/pthread_compat.h"
 #include "utils/string.h"
 #include "utils/utils.h"
 #include "vkutils.h"
@@ -37,40 +38,41 @@ struct ngpu_program *ngpu_program_vk_create(struct ngpu_ctx *gpu_ctx)
     struct ngpu_program_vk *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
+    if (pthread_mutex_init(&s->lock, NULL)) {
+        ngli_free(s);
+        return NULL;
+    }
     s->parent.gpu_ctx = gpu_ctx;
     return (struct ngpu_program *)s;
 }
 
-int ngpu_program_vk_init(struct ngpu_program *s, const struct ngpu_program_params *params)
+static void log_shader_error(const struct ngpu_program_vk *s, size_t index)
+{
+    char *s_with_numbers = ngli_numbered_lines(s->sources[index]);
+    if (s_with_numbers) {
+        LOG(ERROR, "failed to compile shader \"%s\":\n%s",
+            s->label ? s->label : "", s_with_numbers);
+        ngli_free(s_with_numbers);
+    }
+}
+
+static int compile_job(void *arg)
 {
+    struct ngpu_program *s = arg;
     struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
     struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct ngpu_program_vk *s_priv = (struct ngpu_program_vk *)s;
 
-    const struct {
-        enum ngpu_program_stage stage;
-        const char *src;
-    } shaders[] = {
-        {NGPU_PROGRAM_STAGE_VERT, params->vertex},
-        {NGPU_PROGRAM_STAGE_FRAG, params->fragment},
-        {NGPU_PROGRAM_STAGE_COMP, params->compute},
-    };
-
-    for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
-        if (!shaders[i].src)
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->sources); i++) {
+        if (!s_priv->sources[i])
             continue;
 
         void *data = NULL;
         size_t size = 0;
-        int ret = ngli_glslang_compile(shaders[i].stage, shaders[i].src, s->gpu_ctx->config.debug, &data, &size);
+        int ret = ngli_glslang_compile((enum ngpu_program_stage)i, s_priv->sources[i], s->gpu_ctx->config.debug, &data, &size);
         if (ret < 0) {
-            char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
-            if (s_with_numbers) {
-                LOG(ERROR, "failed to compile shader \"%s\":\n%s",
-                    params->label ? params->label : "", s_with_numbers);
-                ngli_free(s_with_numbers);
-            }
+            log_shader_error(s_priv, i);
             return ret;
         }
 
@@ -82,12 +84,7 @@ int ngpu_program_vk_init(struct ngpu_program *s, const struct ngpu_program_param
         VkResult res = vkCreateShaderModule(vk->device, &shader_module_create_info, NULL, &s_priv->shaders[i]);
         ngli_freep(&data);
         if (res != VK_SUCCESS) {
-            char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
-            if (s_with_numbers) {
-                LOG(ERROR, "failed to compile shader \"%s\":\n%s",
-                    params->label ? params->label : "", s_with_numbers);
-                ngli_free(s_with_numbers);
-            }
+            log_shader_error(s_priv, i);
             return ngli_vk_res2ret(res);
         }
     }
@@ -95,6 +92,63 @@ int ngpu_program_vk_init(struct ngpu_program *s, const struct ngpu_program_param
     return 0;
 }
 
+static void release_compilation_data(struct ngpu_program_vk *s)
+{
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s->sources); i++)
+        ngli_freep(&s->sources[i]);
+    ngli_freep(&s->label);
+}
+
+int ngpu_program_vk_init(struct ngpu_program *s, const struct ngpu_program_params *params)
+{
+    struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
+    struct ngpu_program_vk *s_priv = (struct ngpu_program_vk *)s;
+
+    const char *sources[] = {
+        [NGPU_PROGRAM_STAGE_VERT] = params->vertex,
+        [NGPU_PROGRAM_STAGE_FRAG] = params->fragment,
+        [NGPU_PROGRAM_STAGE_COMP] = params->compute,
+    };
+
+    /* The compilation job works on its own copy of the parameters */
+    for (size_t i = 0; i < NGLI_ARRAY_NB(sources); i++) {
+        if (!sources[i])
+            continue;
+        s_priv->sources[i] = ngli_strdup(sources[i]);
+        if (!s_priv->sources[i])
+            return NGL_ERROR_MEMORY;
+    }
+
+    if (params->label) {
+        s_priv->label = ngli_strdup(params->label);
+        if (!s_priv->label)
+            return NGL_ERROR_MEMORY;
+    }
+
+    s_priv->job = ngli_workpool_submit(gpu_ctx_vk->compile_workpool, compile_job, s);
+    if (!s_priv->job)
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+int ngpu_program_vk_wait(struct ngpu_program *s)
+{
+    struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
+    struct ngpu_program_vk *s_priv = (struct ngpu_program_vk *)s;
+
+    /* Programs are shared between pipelines, so they can be waited concurrently */
+    pthread_mutex_lock(&s_priv->lock);
+    if (s_priv->job) {
+        s_priv->status = ngli_workpool_wait(gpu_ctx_vk->compile_workpool, &s_priv->job);
+        release_compilation_data(s_priv);
+    }
+    const int status = s_priv->status;
+    pthread_mutex_unlock(&s_priv->lock);
+
+    return status;
+}
+
 void ngpu_program_vk_freep(struct ngpu_program **sp)
 {
     struct ngpu_program *s = *sp;
@@ -105,6 +159,10 @@ void ngpu_program_vk_freep(struct ngpu_program **sp)
     struct ngpu_ctx_vk *gpu_ctx_vk = (struct ngpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
 
+    ngpu_program_vk_wait(s);
+    release_compilation_data(s_priv);
+    pthread_mutex_destroy(&s_priv->lock);
+
     for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->shaders); i++)
         vkDestroyShaderModule(vk->device, s_priv->shaders[i], NULL);
     ngli_freep(sp);
@@ -25,16 +25,26 @@
 #include <vulkan/vulkan.h>
 
 #include "ngpu/program.h"
+#include "utils/pthread_compat.h"
+#include "utils/workpool.h"
 
 struct ngpu_ctx;
 
 struct ngpu_program_vk {
     struct ngpu_program parent;
     VkShaderModule shaders[NGPU_PROGRAM_STAGE_NB];
+
+    /* Asynchronous compilation state */
+    char *sources[NGPU_PROGRAM_STAGE_NB];
+    char *label;
+    pthread_mutex_t lock;
+    struct workpool_job *job;
+    int status;
 };
 
 struct ngpu_program *ngpu_program_vk_create(struct ngpu_ctx *gpu_ctx);
 int ngpu_program_vk_init(struct ngpu_program *s, const struct ngpu_program_params *params);
+int ngpu_program_vk_wait(struct ngpu_program *s);
 void ngpu_program_vk_freep(struct ngpu_program **sp);
 
 #endif
@@ -65,6 +65,7 @@ int ngpu_texture_vk_init(struct ngpu_texture *s, const struct ngpu_texture_param
 VkResult ngpu_texture_vk_wrap(struct ngpu_texture *s, const struct ngpu_texture_vk_wrap_params *wrap_params);
 int ngpu_texture_vk_upload(struct ngpu_texture *s, const uint8_t *data, int linesize);
 int ngpu_texture_vk_upload_with_params(struct ngpu_texture *s, const uint8_t *data, const struct ngpu_texture_transfer_params *transfer_params);
+int ngpu_texture_vk_upload_from_buffer(struct ngpu_texture *s, struct ngpu_buffer *buffer, size_t offset, int linesize);
 int ngpu_texture_vk_generate_mipmap(struct ngpu_texture *s);
 void ngpu_texture_vk_transition_layout(struct ngpu_texture *s, VkImageLayout layout);
 void ngpu_texture_vk_transition_to_default_layout(struct ngpu_texture *s);
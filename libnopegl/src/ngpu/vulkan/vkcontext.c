@@ -593,6 +593,7 @@ static VkResult create_device(struct vkcontext *s)
     ENABLE_FEATURE(vertexPipelineStoresAndAtomics, 0);
     ENABLE_FEATURE(fragmentStoresAndAtomics, 0);
     ENABLE_FEATURE(shaderStorageImageExtendedFormats, 0);
+    ENABLE_FEATURE(fullDrawIndexUint32, 0);
 
 #undef ENABLE_FEATURE
 
@@ -19,13 +19,10 @@
  * under the License.
  */
 
-#include <inttypes.h>
 #include <limits.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/types.h>
-#include <sys/stat.h>
 
 #include "internal.h"
 #include "log.h"
@@ -49,11 +46,13 @@ struct buffer_opts {
 
 struct buffer_priv {
     struct buffer_info buf;
-    FILE *fp;
+    struct file_map file_map;
 };
 
 NGLI_STATIC_ASSERT(offsetof(struct buffer_priv, buf) == 0, "buffer_info is first");
 
+#define UPLOAD_CHUNK_SIZE (16 * 1024 * 1024)
+
 #define OFFSET(x) offsetof(struct buffer_opts, x)
 static const struct node_param buffer_params[] = {
     {"count",  NGLI_PARAM_TYPE_U32,    OFFSET(count),
@@ -115,23 +114,21 @@ static int buffer_init_from_data(struct ngl_node *node)
     return 0;
 }
 
+/*
+ * The file is memory mapped instead of being read at init: its content is
+ * only loaded when accessed, typically while being uploaded to the GPU
+ */
 static int buffer_init_from_filename(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
     const struct buffer_opts *o = node->opts;
     struct buffer_layout *layout = &s->buf.layout;
 
-    int64_t size;
-    int ret = ngli_get_filesize(o->filename, &size);
+    int ret = ngli_file_map_init(&s->file_map, o->filename);
     if (ret < 0)
         return ret;
 
-    if (size > SIZE_MAX) {
-        LOG(ERROR, "'%s' size (%" PRId64 ") exceeds supported limit (%zu)", o->filename, size, SIZE_MAX);
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
-    s->buf.data_size = (size_t)size;
+    s->buf.data_size = s->file_map.size;
     layout->count = layout->count ? layout->count : s->buf.data_size / layout->stride;
 
     if (s->buf.data_size != layout->count * layout->stride) {
@@ -143,26 +140,7 @@ static int buffer_init_from_filename(struct ngl_node *node)
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->buf.data = ngli_calloc(layout->count, layout->stride);
-    if (!s->buf.data)
-        return NGL_ERROR_MEMORY;
-
-    s->fp = fopen(o->filename, "rb");
-    if (!s->fp) {
-        LOG(ERROR, "could not open '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    size_t n = fread(s->buf.data, 1, s->buf.data_size, s->fp);
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "could not read '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "read %zu bytes does not match expected size of %zu bytes", n, s->buf.data_size);
-        return NGL_ERROR_IO;
-    }
+    s->buf.data = s->file_map.data;
 
     return 0;
 }
@@ -311,9 +289,25 @@ static int buffer_prepare(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
-    ret = ngpu_buffer_upload(info->buffer, info->data, 0, info->data_size);
-    if (ret < 0)
-        return ret;
+    if (!s->file_map.data) {
+        ret = ngpu_buffer_upload(info->buffer, info->data, 0, info->data_size);
+        if (ret < 0)
+            return ret;
+        return ngli_node_prepare_children(node);
+    }
+
+    /*
+     * Stream the file content by chunks, dropping the pages of each chunk
+     * once uploaded so the whole file is never resident at once. The pages
+     * are read back from the file if the CPU data is accessed later on.
+     */
+    for (size_t offset = 0; offset < info->data_size; offset += UPLOAD_CHUNK_SIZE) {
+        const size_t size = NGLI_MIN(info->data_size - offset, UPLOAD_CHUNK_SIZE);
+        ret = ngpu_buffer_upload(info->buffer, info->data + offset, offset, size);
+        if (ret < 0)
+            return ret;
+        ngli_file_map_evict(&s->file_map, offset, size);
+    }
 
     return ngli_node_prepare_children(node);
 }
@@ -328,18 +322,12 @@ static void buffer_uninit(struct ngl_node *node)
     else
         ngpu_buffer_freep(&s->buf.buffer);
 
-    if (!o->data && !o->block)
-        ngli_freep(&s->buf.data);
-
     if (o->filename) {
+        ngli_file_map_reset(&s->file_map);
+        s->buf.data = NULL;
         s->buf.data_size = 0;
-
-        if (s->fp) {
-            int ret = fclose(s->fp);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", o->filename);
-            }
-        }
+    } else if (!o->data && !o->block) {
+        ngli_freep(&s->buf.data);
     }
 }
 
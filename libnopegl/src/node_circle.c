@@ -67,7 +67,7 @@ static int circle_init(struct ngl_node *node)
     float *vertices  = ngli_calloc(nb_vertices, sizeof(*vertices)  * 3);
     float *uvcoords  = ngli_calloc(nb_vertices, sizeof(*uvcoords)  * 2);
     float *normals   = ngli_calloc(nb_vertices, sizeof(*normals)   * 3);
-    uint16_t *indices = ngli_calloc(nb_indices, sizeof(*indices));
+    uint32_t *indices = ngli_calloc(nb_indices, sizeof(*indices));
 
     if (!vertices || !uvcoords || !normals || !indices) {
         ret = NGL_ERROR_MEMORY;
@@ -89,8 +89,8 @@ static int circle_init(struct ngl_node *node)
         uvcoords[i*2 + 0] = (x + 1.0f) / 2.0f;
         uvcoords[i*2 + 1] = (1.0f - y) / 2.0f;
         indices[(i - 1) * 3 + 0]  = 0; // point to center coordinate
-        indices[(i - 1) * 3 + 1]  = (uint16_t)i;
-        indices[(i - 1) * 3 + 2]  = (uint16_t)(i + 1);
+        indices[(i - 1) * 3 + 1]  = (uint32_t)i;
+        indices[(i - 1) * 3 + 2]  = (uint32_t)(i + 1);
     }
     /* Fix overflowing vertex reference back to the start for sealing the
      * circle */
@@ -20,6 +20,8 @@
  * under the License.
  */
 
+#include <string.h>
+
 #include "internal.h"
 #include "log.h"
 #include "ngpu/block.h"
@@ -31,6 +33,7 @@
 #include "pipeline_compat.h"
 #include "ngpu/block_desc.h"
 #include "ngpu/type.h"
+#include "utils/memory.h"
 
 /* Compute shaders */
 #include "colorstats_init_comp.h"
@@ -45,13 +48,17 @@
  */
 #define MAX_BIT_DEPTH 8
 
+NGLI_STATIC_ASSERT(1 << MAX_BIT_DEPTH == NGL_COLORSTATS_DEPTH, "public depth matches the maximum depth");
+
 struct stats_params_block {
     int32_t depth;
     int32_t length_minus1;
+    int32_t subsample;
 };
 
 struct colorstats_opts {
     struct ngl_node *texture_node;
+    int32_t subsample;
 };
 
 #define OFFSET(x) offsetof(struct colorstats_opts, x)
@@ -60,14 +67,34 @@ static const struct node_param colorstats_params[] = {
                 .flags=NGLI_PARAM_FLAG_NON_NULL,
                 .node_types=(const uint32_t[]){NGL_NODE_TEXTURE2D, NGLI_NODE_NONE},
                 .desc=NGLI_DOCSTRING("source texture to compute the color stats from")},
+    {"subsample", NGLI_PARAM_TYPE_I32, OFFSET(subsample), {.i32=1},
+                  .desc=NGLI_DOCSTRING("only analyze 1 pixel every `subsample` pixels in each direction of the texture")},
     {NULL}
 };
 
+/*
+ * Copy of the summary written by the sumscale compute for the CPU; there is
+ * one per frame in flight so that it can be mapped once the GPU is done with
+ * it, without stalling.
+ */
+struct readback {
+    struct ngpu_buffer *buffer;
+    bool pending;
+    double t;
+};
+
 struct colorstats_priv {
     struct block_info blk;
     uint32_t depth;
     uint32_t length_minus1;
     uint32_t group_size;
+    double t;
+
+    struct ngpu_block_desc readback_block;
+    struct readback *readbacks;
+    size_t nb_readbacks;
+    bool has_stats;
+    struct ngl_colorstats stats;
 
     struct ngpu_block stats_params_block;
 
@@ -223,6 +250,7 @@ static int init_computes(struct ngl_node *node)
     const struct ngpu_block_entry block_fields[] = {
         NGPU_BLOCK_FIELD(struct stats_params_block, depth, NGPU_TYPE_I32, 0),
         NGPU_BLOCK_FIELD(struct stats_params_block, length_minus1, NGPU_TYPE_I32, 0),
+        NGPU_BLOCK_FIELD(struct stats_params_block, subsample, NGPU_TYPE_I32, 0),
     };
     const struct ngpu_block_params block_params = {
         .count      = 1,
@@ -250,13 +278,21 @@ static int init_computes(struct ngl_node *node)
             .stage    = NGPU_PROGRAM_STAGE_COMP,
             .writable = 1,
             .block    = &s->blk.block,
+        }, {
+            .name     = "readback",
+            .type     = NGPU_TYPE_STORAGE_BUFFER,
+            .stage    = NGPU_PROGRAM_STAGE_COMP,
+            .writable = 1,
+            .block    = &s->readback_block,
         },
     };
-    size_t nb_blocks = NGLI_ARRAY_NB(blocks);
+
+    /* The readback block is last because it is only used by the sumscale compute */
+    const size_t nb_blocks = NGLI_ARRAY_NB(blocks) - 1;
 
     if ((ret = setup_init_compute(s, blocks, nb_blocks)) < 0 ||
         (ret = setup_waveform_compute(s, blocks, nb_blocks, o->texture_node)) < 0 ||
-        (ret = setup_sumscale_compute(s, blocks, nb_blocks)) < 0)
+        (ret = setup_sumscale_compute(s, blocks, nb_blocks + 1)) < 0)
         return ret;
 
     return 0;
@@ -289,10 +325,41 @@ static int init_block(struct colorstats_priv *s, struct ngpu_ctx *gpu_ctx)
     return 0;
 }
 
+static int init_readbacks(struct colorstats_priv *s, struct ngpu_ctx *gpu_ctx)
+{
+    struct ngpu_block_desc *block = &s->readback_block;
+    ngpu_block_desc_init(gpu_ctx, block, NGPU_BLOCK_LAYOUT_STD430);
+
+    const struct ngpu_block_field block_field = {"summary", NGPU_TYPE_UVEC4, 1 << MAX_BIT_DEPTH};
+    int ret = ngpu_block_desc_add_fields(block, &block_field, 1);
+    if (ret < 0)
+        return ret;
+
+    s->nb_readbacks = gpu_ctx->nb_in_flight_frames;
+    s->readbacks = ngli_calloc(s->nb_readbacks, sizeof(*s->readbacks));
+    if (!s->readbacks)
+        return NGL_ERROR_MEMORY;
+
+    const size_t size = ngpu_block_desc_get_size(block, 0);
+    for (size_t i = 0; i < s->nb_readbacks; i++) {
+        struct readback *readback = &s->readbacks[i];
+        readback->buffer = ngpu_buffer_create(gpu_ctx);
+        if (!readback->buffer)
+            return NGL_ERROR_MEMORY;
+        ret = ngpu_buffer_init(readback->buffer, size,
+                               NGPU_BUFFER_USAGE_STORAGE_BUFFER_BIT | NGPU_BUFFER_USAGE_MAP_READ);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 static int colorstats_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct colorstats_priv *s = node->priv_data;
+    const struct colorstats_opts *o = node->opts;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
 
     if (!(gpu_ctx->features & NGPU_FEATURE_COMPUTE)) {
@@ -300,8 +367,14 @@ static int colorstats_init(struct ngl_node *node)
         return NGL_ERROR_GRAPHICS_UNSUPPORTED;
     }
 
+    if (o->subsample < 1) {
+        LOG(ERROR, "subsample must be greater or equal to 1");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     int ret;
     if ((ret = init_block(s, gpu_ctx)) < 0 ||
+        (ret = init_readbacks(s, gpu_ctx)) < 0 ||
         (ret = init_computes(node)) < 0)
         return ret;
     return 0;
@@ -310,6 +383,7 @@ static int colorstats_init(struct ngl_node *node)
 static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
 {
     struct colorstats_priv *s = node->priv_data;
+    const struct colorstats_opts *o = node->opts;
 
     /* We assume a 8-bit sampling all the time for now */
     s->depth = 1U << 8;
@@ -324,6 +398,7 @@ static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
     ngpu_block_update(&s->stats_params_block, 0, &(const struct stats_params_block) {
         .depth = (int32_t)s->depth,
         .length_minus1 = (int32_t)s->length_minus1,
+        .subsample = o->subsample,
     });
 
     /*
@@ -344,6 +419,13 @@ static int alloc_block_buffer(struct ngl_node *node, uint32_t length)
     /* Each workgroup of the waveform compute works on 1 column of pixels */
     s->waveform.wg_count = length;
 
+    /*
+     * The previous buffer (if any) is only released once the GPU is done with
+     * it, and the users of the block are notified of the change through the
+     * buffer revision below
+     */
+    ngpu_buffer_freep(&s->blk.buffer);
+
     struct ngl_ctx *ctx = node->ctx;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
     s->blk.buffer = ngpu_buffer_create(gpu_ctx);
@@ -380,24 +462,25 @@ static int colorstats_update(struct ngl_node *node, double t)
     if (ret < 0)
         return ret;
 
+    s->t = t;
+
     /*
-     * Lazily allocate the data buffer because it depends on the texture
-     * dimensions
+     * The GPU is done with the frames previously submitted at the current
+     * frame index, so the corresponding readback can be mapped without
+     * stalling
      */
-    const struct texture_info *texture_info = o->texture_node->priv_data;
-    if (texture_info->image.params.width <= 0) {
-        LOG(ERROR, "invalid texture width: %d", texture_info->image.params.width);
-        return NGL_ERROR_INVALID_DATA;
-    }
-    const uint32_t source_w = (uint32_t)texture_info->image.params.width;
-    if (!s->blk.buffer)
-        return alloc_block_buffer(node, source_w);
-
-    /* Stream size change event */
-    if (s->length_minus1 != source_w - 1) {
-        // TODO: we need to resize the block data field / reallocate the underlying buffer
-        LOG(ERROR, "stream size change (%u -> %u) is not supported", s->length_minus1 + 1, source_w);
-        return NGL_ERROR_UNSUPPORTED;
+    struct ngpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+    struct readback *readback = &s->readbacks[gpu_ctx->current_frame_index];
+    if (readback->pending) {
+        void *data;
+        ret = ngpu_buffer_map(readback->buffer, 0, readback->buffer->size, &data);
+        if (ret < 0)
+            return ret;
+        memcpy(s->stats.histograms, data, sizeof(s->stats.histograms));
+        ngpu_buffer_unmap(readback->buffer);
+        s->stats.time = readback->t;
+        s->has_stats = true;
+        readback->pending = false;
     }
 
     return 0;
@@ -416,6 +499,29 @@ static void colorstats_draw(struct ngl_node *node)
         ctx->current_rendertarget = ctx->available_rendertargets[1];
     }
 
+    /*
+     * Lazily allocate the data buffer because it depends on the texture
+     * dimensions, which are only known once the texture is drawn when it
+     * follows the size of its render target
+     */
+    const struct texture_info *texture_info = o->texture_node->priv_data;
+    if (texture_info->image.params.width <= 0) {
+        LOG(ERROR, "invalid texture width: %d", texture_info->image.params.width);
+        return;
+    }
+    const uint32_t source_w = (uint32_t)texture_info->image.params.width;
+    const uint32_t subsample = (uint32_t)o->subsample;
+    const uint32_t length = (source_w + subsample - 1) / subsample;
+
+    /* Stream size change event (or first allocation) */
+    if (!s->blk.buffer || s->length_minus1 != length - 1) {
+        if (s->blk.buffer)
+            LOG(DEBUG, "stream size change (%u -> %u)", s->length_minus1 + 1, length);
+        int ret = alloc_block_buffer(node, length);
+        if (ret < 0)
+            return;
+    }
+
     /* Init */
     ngli_pipeline_compat_dispatch(s->init.pipeline_compat, s->init.wg_count, 1, 1);
 
@@ -427,7 +533,11 @@ static void colorstats_draw(struct ngl_node *node)
     ngli_pipeline_compat_dispatch(s->waveform.pipeline_compat, s->waveform.wg_count, 1, 1);
 
     /* Summary-scale */
+    struct readback *readback = &s->readbacks[ctx->gpu_ctx->current_frame_index];
+    ngli_pipeline_compat_update_buffer(s->sumscale.pipeline_compat, 2, readback->buffer, 0, 0);
     ngli_pipeline_compat_dispatch(s->sumscale.pipeline_compat, s->sumscale.wg_count, 1, 1);
+    readback->pending = true;
+    readback->t = s->t;
 }
 
 static void colorstats_uninit(struct ngl_node *node)
@@ -443,6 +553,30 @@ static void colorstats_uninit(struct ngl_node *node)
     ngpu_buffer_freep(&s->blk.buffer);
     ngpu_block_desc_reset(&s->blk.block);
     ngpu_block_reset(&s->stats_params_block);
+    for (size_t i = 0; i < s->nb_readbacks; i++)
+        ngpu_buffer_freep(&s->readbacks[i].buffer);
+    ngli_freep(&s->readbacks);
+    ngpu_block_desc_reset(&s->readback_block);
+}
+
+int ngl_colorstats_get(struct ngl_ctx *s, struct ngl_node *node, struct ngl_colorstats *stats)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the color stats");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (node->cls->id != NGL_NODE_COLORSTATS || node->ctx != s) {
+        LOG(ERROR, "%s is not a ColorStats node of the scene set on this context", node->label);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    const struct colorstats_priv *priv = node->priv_data;
+    if (!priv->has_stats)
+        return NGL_ERROR_NOT_FOUND;
+
+    *stats = priv->stats;
+    return 0;
 }
 
 const struct node_class ngli_colorstats_class = {
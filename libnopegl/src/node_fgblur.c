@@ -75,11 +75,12 @@ struct fgblur_priv {
     int32_t max_lod;
     float blurriness;
 
-    /* Intermediates Mips used by the blur passses */
+    /*
+     * Intermediates Mips used by the blur passses, acquired from the context
+     * render target pool for the duration of the draw
+     */
     struct ngpu_rendertarget_layout mip_layout;
-
-    struct rtt_ctx *mip;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS];
+    struct ngpu_texture_params mips_params[MAX_MIP_LEVELS];
 
     struct ngpu_block down_up_data_block;
 
@@ -369,6 +370,7 @@ static int resize(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     ngli_assert(dst_info->params.format == s->dst_layout.colors[0].format);
 
+    struct ngpu_texture_params mips_params[MAX_MIP_LEVELS];
     struct ngpu_texture_params texture_params = (struct ngpu_texture_params) {
         .type          = NGPU_TEXTURE_TYPE_2D,
         .format        = src_info->params.format,
@@ -382,34 +384,15 @@ static int resize(struct ngl_node *node)
                          NGPU_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    struct rtt_ctx *mip = NULL;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
-
     struct ngpu_texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
-    mip = ngli_rtt_create(ctx);
-    if (!mip)
-        return NGL_ERROR_MEMORY;
-
-    ret = ngli_rtt_from_texture_params(mip, &texture_params);
-    if (ret < 0)
-        goto fail;
-
     int32_t mip_width = width;
     int32_t mip_height = height;
     for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        mips[i] = ngli_rtt_create(ctx);
-        if (!mips[i]) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
         texture_params.width = mip_width;
         texture_params.height = mip_height;
-        ret = ngli_rtt_from_texture_params(mips[i], &texture_params);
-        if (ret < 0)
-            goto fail;
+        mips_params[i] = texture_params;
 
         mip_width = NGLI_MAX(mip_width >> 1, 1);
         mip_height = NGLI_MAX(mip_height >> 1, 1);
@@ -417,18 +400,14 @@ static int resize(struct ngl_node *node)
 
     dst = dst_info->texture;
     if (s->dst_is_resizable) {
-        dst = ngpu_texture_create(ctx->gpu_ctx);
-        if (!dst) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
         struct ngpu_texture_params params = dst_info->params;
         params.width = width;
         params.height = height;
-        ret = ngpu_texture_init(dst, &params);
-        if (ret < 0)
+        ret = ngli_texture_pool_get(ctx->texture_pool, &params, &dst);
+        if (ret < 0) {
+            dst = NULL;
             goto fail;
+        }
     }
 
     dst_rtt_ctx = ngli_rtt_create(ctx);
@@ -452,16 +431,10 @@ static int resize(struct ngl_node *node)
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->mip);
-    s->mip = mip;
-
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        ngli_rtt_freep(&s->mips[i]);
-        s->mips[i] = mips[i];
-    }
+    memcpy(s->mips_params, mips_params, sizeof(mips_params));
 
     if (s->dst_is_resizable) {
-        ngpu_texture_freep(&dst_info->texture);
+        ngli_texture_pool_recycle(ctx->texture_pool, &dst_info->texture);
         dst_info->texture = dst;
         dst_info->image.params.width = dst->params.width;
         dst_info->image.params.height = dst->params.height;
@@ -487,13 +460,9 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_rtt_freep(&mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&mips[i]);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizable)
-        ngpu_texture_freep(&dst);
+        ngli_texture_pool_recycle(ctx->texture_pool, &dst);
 
     LOG(ERROR, "failed to resize blur: %dx%d", width, height);
     return ret;
@@ -556,15 +525,33 @@ static void fgblur_draw(struct ngl_node *node)
     const int32_t lod_i = (int32_t)lod;
     const float lod_f = lod - (float)lod_i;
 
-    /* Downsample source to mips[1] */
     struct texture_info *src_info = o->source->priv_data;
     const struct image *src_image = &src_info->image;
+
+    /*
+     * Only the mips up to mips[lod_i+1] are involved in the passes below, and
+     * the full resolution intermediate mip is only needed if lod_i > 0
+     */
+    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
+    struct rtt_ctx *mip_rtt_ctx = NULL;
+    for (int32_t i = 0; i <= lod_i + 1; i++) {
+        mips[i] = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mips_params[i], 1);
+        if (!mips[i])
+            goto end;
+    }
+    if (lod_i > 0) {
+        mip_rtt_ctx = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->mips_params[0], 1);
+        if (!mip_rtt_ctx)
+            goto end;
+    }
+
+    /* Downsample source to mips[1] */
     const struct image *mip = src_image;
-    execute_down_up_pass(ctx, s->mips[1], s->dws.pl, mip);
+    execute_down_up_pass(ctx, mips[1], s->dws.pl, mip);
 
     /* Downsample successively until mips[lod_i+1] is generated */
     for (int32_t i = 2; i <= lod_i + 1; i++)
-        execute_down_up_pass(ctx, s->mips[i], s->dws.pl, ngli_rtt_get_image(s->mips[i - 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->dws.pl, ngli_rtt_get_image(mips[i - 1], 0));
 
     /*
      * Upsample successively from mips[lod_i] back to full resolution and store
@@ -572,9 +559,9 @@ static void fgblur_draw(struct ngl_node *node)
      */
     if (lod_i > 0) {
         for (int32_t i = lod_i - 1; i > 0; i--)
-            execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_image(s->mips[i + 1], 0));
-        execute_down_up_pass(ctx, s->mip, s->ups.pl, ngli_rtt_get_image(s->mips[1], 0));
-        mip = ngli_rtt_get_image(s->mip, 0);
+            execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_image(mips[i + 1], 0));
+        execute_down_up_pass(ctx, mip_rtt_ctx, s->ups.pl, ngli_rtt_get_image(mips[1], 0));
+        mip = ngli_rtt_get_image(mip_rtt_ctx, 0);
     }
 
     /*
@@ -582,7 +569,7 @@ static void fgblur_draw(struct ngl_node *node)
      * store the result in mips[0]
      */
     for (int32_t i = lod_i; i >= 0; i--)
-        execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_image(s->mips[i + 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_image(mips[i + 1], 0));
 
     const struct interpolate_block interpolate_block = {.lod = lod_f};
     ngpu_block_update(&s->interpolate.block, 0, &interpolate_block);
@@ -594,7 +581,7 @@ static void fgblur_draw(struct ngl_node *node)
     ngli_rtt_begin(s->dst_rtt_ctx);
     ngpu_ctx_begin_render_pass(ctx->gpu_ctx, ctx->current_rendertarget);
     ngli_pipeline_compat_update_image(s->interpolate.pl, 0, mip);
-    ngli_pipeline_compat_update_image(s->interpolate.pl, 1, ngli_rtt_get_image(s->mips[0], 0));
+    ngli_pipeline_compat_update_image(s->interpolate.pl, 1, ngli_rtt_get_image(mips[0], 0));
     ngli_pipeline_compat_draw(s->interpolate.pl, 3, 1, 0);
     ngli_rtt_end(s->dst_rtt_ctx);
 
@@ -606,16 +593,17 @@ static void fgblur_draw(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     struct image *dst_image = &dst_info->image;
     memcpy(dst_image->coordinates_matrix, src_image->coordinates_matrix, sizeof(src_image->coordinates_matrix));
+
+end:
+    ngli_rtt_pool_release(ctx->rtt_pool, &mip_rtt_ctx);
+    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
+        ngli_rtt_pool_release(ctx->rtt_pool, &mips[i]);
 }
 
 static void fgblur_release(struct ngl_node *node)
 {
     struct fgblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&s->mips[i]);
-
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
@@ -77,9 +77,12 @@ struct gblur_priv {
     struct image *image;
     size_t image_rev;
 
-    /* Render the horizontal pass to a temporary destination */
+    /*
+     * Render the horizontal pass to a temporary destination, acquired from
+     * the context render target pool for the duration of the draw
+     */
     struct ngpu_rendertarget_layout tmp_layout;
-    struct rtt_ctx *tmp;
+    struct ngpu_texture_params tmp_params;
 
     /* Render the vertical pass to the destination */
     int dst_is_resizable;
@@ -356,12 +359,10 @@ static int resize(struct ngl_node *node)
     struct texture_info *dst_info = o->destination->priv_data;
     ngli_assert(dst_info->params.format == s->dst_layout.colors[0].format);
 
-    struct rtt_ctx *tmp = NULL;
-
     struct ngpu_texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
-    const struct ngpu_texture_params texture_params = {
+    const struct ngpu_texture_params tmp_params = {
         .type          = NGPU_TEXTURE_TYPE_2D,
         .format        = src_info->params.format,
         .width         = width,
@@ -374,37 +375,22 @@ static int resize(struct ngl_node *node)
                          NGPU_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    tmp = ngli_rtt_create(ctx);
-    if (!tmp) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
-    }
-
-    ret = ngli_rtt_from_texture_params(tmp, &texture_params);
-    if (ret < 0)
-        goto fail;
-
     dst = dst_info->texture;
     if (s->dst_is_resizable) {
-        dst = ngpu_texture_create(ctx->gpu_ctx);
-        if (!dst) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
         struct ngpu_texture_params params = dst_info->params;
         params.width = width;
         params.height = height;
-        ret = ngpu_texture_init(dst, &params);
-        if (ret < 0)
+        ret = ngli_texture_pool_get(ctx->texture_pool, &params, &dst);
+        if (ret < 0) {
+            dst = NULL;
             goto fail;
+        }
     }
 
-    ngli_rtt_freep(&s->tmp);
-    s->tmp = tmp;
+    s->tmp_params = tmp_params;
 
     if (s->dst_is_resizable) {
-        ngpu_texture_freep(&dst_info->texture);
+        ngli_texture_pool_recycle(ctx->texture_pool, &dst_info->texture);
         dst_info->texture = dst;
         dst_info->image.params.width = dst->params.width;
         dst_info->image.params.height = dst->params.height;
@@ -445,11 +431,9 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_rtt_freep(&tmp);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizable)
-        ngpu_texture_freep(&dst);
+        ngli_texture_pool_recycle(ctx->texture_pool, &dst);
 
     LOG(ERROR, "failed to resize blur: %dx%d", width, height);
     return ret;
@@ -469,7 +453,11 @@ static void gblur_draw(struct ngl_node *node)
     if (ret < 0)
         return;
 
-    ngli_rtt_begin(s->tmp);
+    struct rtt_ctx *tmp = ngli_rtt_pool_acquire(ctx->rtt_pool, &s->tmp_params, 1);
+    if (!tmp)
+        return;
+
+    ngli_rtt_begin(tmp);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     uint32_t offset = 0;
     ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_h, &offset, 1);
@@ -478,22 +466,23 @@ static void gblur_draw(struct ngl_node *node)
         s->image_rev = s->image->rev;
     }
     ngli_pipeline_compat_draw(s->pl_blur_h, 3, 1, 0);
-    ngli_rtt_end(s->tmp);
+    ngli_rtt_end(tmp);
 
     ngli_rtt_begin(s->dst_rtt_ctx);
     ngpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     offset = (uint32_t)s->direction_block.block_size;
     ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_v, &offset, 1);
-    ngli_pipeline_compat_update_image(s->pl_blur_v, 0, ngli_rtt_get_image(s->tmp, 0));
+    ngli_pipeline_compat_update_image(s->pl_blur_v, 0, ngli_rtt_get_image(tmp, 0));
     ngli_pipeline_compat_draw(s->pl_blur_v, 3, 1, 0);
     ngli_rtt_end(s->dst_rtt_ctx);
+
+    ngli_rtt_pool_release(ctx->rtt_pool, &tmp);
 }
 
 static void gblur_release(struct ngl_node *node)
 {
     struct gblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->tmp);
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
@@ -30,6 +30,8 @@
 #include "ngpu/ctx.h"
 #include "node_buffer.h"
 #include "nopegl.h"
+#include "utils/memory.h"
+#include "vcache.h"
 
 static const struct param_choices topology_choices = {
     .name = "topology",
@@ -57,6 +59,7 @@ struct geometry_opts {
     struct ngl_node *normals;
     struct ngl_node *indices;
     enum ngpu_primitive_topology topology;
+    int optimize_indices;
 };
 
 struct geometry_priv {
@@ -84,6 +87,9 @@ static const struct node_param geometry_params[] = {
     {"topology",  NGLI_PARAM_TYPE_SELECT, OFFSET(topology), {.i32=NGPU_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST},
                   .choices=&topology_choices,
                   .desc=NGLI_DOCSTRING("primitive topology")},
+    {"optimize_indices", NGLI_PARAM_TYPE_BOOL, OFFSET(optimize_indices), {.i32=0},
+                  .desc=NGLI_DOCSTRING("reorder the triangles of the `indices` at initialization to reduce the number of "
+                                       "vertex shader invocations (`triangle_list` topology only)")},
     {NULL}
 };
 
@@ -97,6 +103,47 @@ NGLI_STATIC_ASSERT(offsetof(struct geometry_priv, geom) == 0, "geom on top of ge
     }                                                      \
 } while (0)                                                \
 
+/*
+ * The optimized indices are owned by the geometry, the source buffer is left
+ * untouched since it may be shared with other nodes.
+ */
+static int set_optimized_indices(struct geometry_priv *s, const struct buffer_info *indices, size_t nb_vertices)
+{
+    const size_t count = indices->layout.count;
+    uint32_t *src = ngli_calloc(count, sizeof(*src));
+    uint32_t *dst = ngli_calloc(count, sizeof(*dst));
+    if (!src || !dst) {
+        ngli_free(src);
+        ngli_free(dst);
+        return NGL_ERROR_MEMORY;
+    }
+
+    if (indices->layout.format == NGPU_FORMAT_R16_UNORM) {
+        const uint16_t *data = (const uint16_t *)indices->data;
+        for (size_t i = 0; i < count; i++)
+            src[i] = data[i];
+    } else {
+        memcpy(src, indices->data, count * sizeof(*src));
+    }
+
+    int ret = ngli_vcache_optimize(dst, src, count, nb_vertices);
+    if (ret < 0) {
+        LOG(ERROR, "unable to optimize indices, they must define complete triangles within the vertices count");
+        goto end;
+    }
+
+    LOG(DEBUG, "optimized indices ACMR: %f -> %f",
+        ngli_vcache_get_acmr(src, count, nb_vertices, NGLI_VCACHE_SIZE),
+        ngli_vcache_get_acmr(dst, count, nb_vertices, NGLI_VCACHE_SIZE));
+
+    ret = ngli_geometry_set_indices(s->geom, count, dst);
+
+end:
+    ngli_free(src);
+    ngli_free(dst);
+    return ret;
+}
+
 static int geometry_init(struct ngl_node *node)
 {
     struct geometry_priv *s = node->priv_data;
@@ -133,6 +180,17 @@ static int geometry_init(struct ngl_node *node)
             return NGL_ERROR_UNSUPPORTED;
         }
 
+        if (o->optimize_indices) {
+            if (o->topology != NGPU_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST) {
+                LOG(ERROR, "indices can only be optimized with a triangle list topology");
+                return NGL_ERROR_INVALID_ARG;
+            }
+            int ret = set_optimized_indices(s, indices, vertices->layout.count);
+            if (ret < 0)
+                return ret;
+            return ngli_geometry_init(s->geom, o->topology);
+        }
+
         ngli_node_buffer_extend_usage(o->indices, NGPU_BUFFER_USAGE_INDEX_BUFFER_BIT);
         indices->flags |= NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD;
 
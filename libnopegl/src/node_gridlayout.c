@@ -22,7 +22,6 @@
 
 #include <stddef.h>
 #include <stdio.h>
-#include <string.h>
 
 #include "internal.h"
 #include "log.h"
@@ -138,7 +137,7 @@ static void gridlayout_draw(struct ngl_node *node)
         s->trf.child = o->children[i];
 
         const float *matrix = &matrices[i * 4 * 4];
-        memcpy(s->trf.matrix, matrix, sizeof(s->trf.matrix));
+        ngli_transform_set_matrix(&s->trf, matrix);
 
         ngli_transform_draw(node);
     }
@@ -32,10 +32,12 @@
 
 #include "internal.h"
 #include "log.h"
+#include "media_cache.h"
 #include "node_animkeyframe.h"
 #include "node_media.h"
 #include "node_uniform.h"
 #include "nopegl.h"
+#include "utils/bstr.h"
 #include "utils/memory.h"
 
 #if defined(TARGET_ANDROID)
@@ -133,8 +135,8 @@ static void callback_nopemd_log(void *arg, int level, const char *filename, int
     if (level < 0 || level >= NGLI_ARRAY_NB(log_levels))
         return;
 
-    const struct media_opts *o = arg;
-    if (level < o->nopemd_min_level)
+    const int *min_level = arg;
+    if (level < *min_level)
         return;
 
     char logline[128];
@@ -201,16 +203,16 @@ static void reset_android_surface(struct android_surface_compat *surface)
 }
 #endif
 
-static int media_init(struct ngl_node *node)
+static int init_player(struct ngl_node *node, struct nmd_ctx **playerp, int *log_min_level)
 {
-    struct media_priv *s = node->priv_data;
     const struct media_opts *o = node->opts;
 
-    s->player = nmd_create(o->filename);
-    if (!s->player)
+    *playerp = nmd_create(o->filename);
+    if (!*playerp)
         return NGL_ERROR_MEMORY;
+    struct nmd_ctx *player = *playerp;
 
-    nmd_set_log_callback(s->player, node->opts, callback_nopemd_log);
+    nmd_set_log_callback(player, log_min_level, callback_nopemd_log);
 
     struct ngl_node *anim_node = o->anim;
     if (anim_node) {
@@ -221,59 +223,137 @@ static int media_init(struct ngl_node *node)
             const struct animkeyframe_opts *kf0 = anim->animkf[0]->opts;
             const double initial_seek = kf0->scalar;
 
-            nmd_set_option(s->player, "start_time", initial_seek);
+            nmd_set_option(player, "start_time", initial_seek);
 
             if (anim->nb_animkf > 1) {
                 const struct animkeyframe_opts *kfn = anim->animkf[anim->nb_animkf - 1]->opts;
                 const double last_time = kfn->scalar;
-                nmd_set_option(s->player, "end_time", last_time);
+                nmd_set_option(player, "end_time", last_time);
             }
         }
     }
 
-    if (o->max_nb_packets) nmd_set_option(s->player, "max_nb_packets", o->max_nb_packets);
-    if (o->max_nb_frames)  nmd_set_option(s->player, "max_nb_frames",  o->max_nb_frames);
-    if (o->max_nb_sink)    nmd_set_option(s->player, "max_nb_sink",    o->max_nb_sink);
-    if (o->max_pixels)     nmd_set_option(s->player, "max_pixels",     o->max_pixels);
-    if (o->filters)        nmd_set_option(s->player, "filters",        o->filters);
+    if (o->max_nb_packets) nmd_set_option(player, "max_nb_packets", o->max_nb_packets);
+    if (o->max_nb_frames)  nmd_set_option(player, "max_nb_frames",  o->max_nb_frames);
+    if (o->max_nb_sink)    nmd_set_option(player, "max_nb_sink",    o->max_nb_sink);
+    if (o->max_pixels)     nmd_set_option(player, "max_pixels",     o->max_pixels);
+    if (o->filters)        nmd_set_option(player, "filters",        o->filters);
 
-    nmd_set_option(s->player, "stream_idx", o->stream_idx);
-    nmd_set_option(s->player, "auto_hwaccel", o->hwaccel);
+    nmd_set_option(player, "stream_idx", o->stream_idx);
+    nmd_set_option(player, "auto_hwaccel", o->hwaccel);
 
-    nmd_set_option(s->player, "sw_pix_fmt", NMD_PIXFMT_AUTO);
+    nmd_set_option(player, "sw_pix_fmt", NMD_PIXFMT_AUTO);
     if (o->audio_tex) {
-        nmd_set_option(s->player, "avselect", NMD_SELECT_AUDIO);
-        nmd_set_option(s->player, "audio_texture", 1);
+        nmd_set_option(player, "avselect", NMD_SELECT_AUDIO);
+        nmd_set_option(player, "audio_texture", 1);
         return 0;
     }
 
 #if defined(TARGET_ANDROID)
+    struct media_priv *s = node->priv_data;
     struct ngl_ctx *ctx = node->ctx;
     struct android_ctx *android_ctx = &ctx->android_ctx;
     int ret = init_android_surface(android_ctx, &s->android_surface);
     if (ret < 0)
         return ret;
-    nmd_set_option(s->player, "opaque", &s->android_surface.surface_handle);
+    nmd_set_option(player, "opaque", &s->android_surface.surface_handle);
 #elif defined(TARGET_IPHONE) || defined(TARGET_DARWIN)
     const struct ngl_ctx *ctx = node->ctx;
     const struct ngl_config *config = &ctx->config;
     const char *vt_pix_fmt = o->vt_pix_fmt;
     if (!strcmp(o->vt_pix_fmt, "auto"))
         vt_pix_fmt = get_default_vt_pix_fmts(config->backend);
-    nmd_set_option(s->player, "vt_pix_fmt", vt_pix_fmt);
+    nmd_set_option(player, "vt_pix_fmt", vt_pix_fmt);
 #elif defined(HAVE_VAAPI)
     struct ngl_ctx *ctx = node->ctx;
     struct vaapi_ctx *vaapi_ctx = &ctx->vaapi_ctx;
-    nmd_set_option(s->player, "opaque", &vaapi_ctx->va_display);
+    nmd_set_option(player, "opaque", &vaapi_ctx->va_display);
 #endif
 
     return 0;
 }
 
-static int media_prefetch(struct ngl_node *node)
+#if !defined(TARGET_ANDROID)
+/*
+ * The key identifies the media nodes which can share their player: they must
+ * decode the same stream with the same options and be subject to the same
+ * time remapping, so that they always request the same media time.
+ */
+static char *get_cache_key(const struct ngl_node *node)
+{
+    const struct media_opts *o = node->opts;
+
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_printf(b, "%s|%d|%d|%d|%d|%d|%d|%d|%d|%s|%s|%d",
+                     o->filename, o->nopemd_min_level, o->audio_tex,
+                     o->max_nb_packets, o->max_nb_frames, o->max_nb_sink, o->max_pixels,
+                     o->stream_idx, o->hwaccel, o->filters ? o->filters : "", o->vt_pix_fmt,
+                     o->anim != NULL);
+
+    if (o->anim) {
+        const struct variable_opts *anim = o->anim->opts;
+        for (size_t i = 0; i < anim->nb_animkf; i++) {
+            const struct animkeyframe_opts *kf = anim->animkf[i]->opts;
+            ngli_bstr_printf(b, "|%a:%a:%d:%a:%a", kf->time, kf->scalar, kf->easing,
+                             kf->offsets[0], kf->offsets[1]);
+            for (size_t j = 0; j < kf->nb_args; j++)
+                ngli_bstr_printf(b, ",%a", kf->args[j]);
+        }
+    }
+
+    char *key = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return key;
+}
+#endif
+
+static int media_init(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
-    nmd_start(s->player);
+    struct media_opts *o = node->opts;
+
+#if defined(TARGET_ANDROID)
+    /* The Android surface is bound to a single texture */
+    return init_player(node, &s->player, &o->nopemd_min_level);
+#else
+    struct ngl_ctx *ctx = node->ctx;
+
+    char *key = get_cache_key(node);
+    if (!key)
+        return NGL_ERROR_MEMORY;
+    int ret = ngli_media_cache_get(ctx->media_cache, key, &s->entry);
+    ngli_free(key);
+    if (ret < 0)
+        return ret;
+
+    struct media_cache_entry *entry = s->entry;
+    if (!entry->player) {
+        entry->nopemd_min_level = o->nopemd_min_level;
+        ret = init_player(node, &entry->player, &entry->nopemd_min_level);
+        if (ret < 0) {
+            ngli_media_cache_release(ctx->media_cache, &s->entry);
+            return ret;
+        }
+    } else {
+        LOG(DEBUG, "sharing media player of %s with %s", entry->key, node->label);
+    }
+    s->player = entry->player;
+
+    return 0;
+#endif
+}
+
+/* Start the decoder from a prefetch worker thread */
+static int media_prefetch_async(struct ngl_node *node)
+{
+    struct media_priv *s = node->priv_data;
+    if (s->entry)
+        ngli_media_cache_start(s->entry);
+    else
+        nmd_start(s->player);
     return 0;
 }
 
@@ -336,6 +416,21 @@ static int media_update(struct ngl_node *node, double t)
 
     nmd_frame_releasep(&s->frame);
 
+    /*
+     * When the player is shared, only the first node requesting a given time
+     * queries the player, and receives the potential new frame. The other
+     * nodes are notified through the frame identifier.
+     */
+    struct media_cache_entry *entry = s->entry;
+    if (entry) {
+        if (entry->has_time && entry->time == media_time) {
+            s->frame_id = entry->frame_id;
+            return 0;
+        }
+        entry->has_time = 1;
+        entry->time = media_time;
+    }
+
     TRACE("get frame from %s at t=%g", node->label, media_time);
     struct nmd_frame *frame = NULL;
     int ret = nmd_get_frame(s->player, media_time, &frame);
@@ -354,10 +449,13 @@ static int media_update(struct ngl_node *node, double t)
         }
         TRACE("got frame %dx%d %s with ts=%f", frame->width, frame->height,
               pix_fmt_str, frame->ts);
+        if (entry)
+            entry->frame_id++;
     } else if (ret < 0 && ret != NMD_ERR_EOF) {
         LOG(ERROR, "failed to get frame: %s", get_nmd_ret_name(ret));
     }
     s->frame = frame;
+    s->frame_id = entry ? entry->frame_id : 0;
     return 0;
 }
 
@@ -365,13 +463,21 @@ static void media_release(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
     nmd_frame_releasep(&s->frame);
-    nmd_stop(s->player);
+    if (s->entry)
+        ngli_media_cache_stop(s->entry);
+    else
+        nmd_stop(s->player);
 }
 
 static void media_uninit(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
-    nmd_freep(&s->player);
+    if (s->entry) {
+        ngli_media_cache_release(node->ctx->media_cache, &s->entry);
+        s->player = NULL;
+    } else {
+        nmd_freep(&s->player);
+    }
 
 #if defined(TARGET_ANDROID)
     reset_android_surface(&s->android_surface);
@@ -390,7 +496,7 @@ static int filename_changed(struct ngl_node *node)
     if (ret < 0)
         return ret;
     if (prefetched) {
-        ret = media_prefetch(node);
+        ret = media_prefetch_async(node);
         if (ret < 0)
             return ret;
     }
@@ -398,11 +504,37 @@ static int filename_changed(struct ngl_node *node)
     return 0;
 }
 
+int ngli_node_media_unshare(struct ngl_node *node)
+{
+    struct media_priv *s = node->priv_data;
+    struct media_opts *o = node->opts;
+
+    if (!s->entry)
+        return 0;
+
+    LOG(DEBUG, "media %s can not share the frames of its player, falling back on a separate player", node->label);
+
+    const int started = node->state == NGLI_NODE_STATE_READY;
+    nmd_frame_releasep(&s->frame);
+    if (started)
+        ngli_media_cache_stop(s->entry);
+    ngli_media_cache_release(node->ctx->media_cache, &s->entry);
+    s->player = NULL;
+
+    int ret = init_player(node, &s->player, &o->nopemd_min_level);
+    if (ret < 0)
+        return ret;
+    if (started)
+        nmd_start(s->player);
+
+    return 0;
+}
+
 const struct node_class ngli_media_class = {
     .id        = NGL_NODE_MEDIA,
     .name      = "Media",
     .init      = media_init,
-    .prefetch  = media_prefetch,
+    .prefetch_async = media_prefetch_async,
     .update    = media_update,
     .release   = media_release,
     .uninit    = media_uninit,
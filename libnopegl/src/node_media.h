@@ -37,9 +37,14 @@ struct android_surface_compat {
 };
 #endif
 
+struct ngl_node;
+struct media_cache_entry;
+
 struct media_priv {
+    struct media_cache_entry *entry; /* NULL if the player is not shared */
     struct nmd_ctx *player;
     struct nmd_frame *frame;
+    uint64_t frame_id; /* identifier of the current frame of a shared player */
     size_t nb_parents;
     double start_time;
     double end_time;
@@ -50,4 +55,10 @@ struct media_priv {
 #endif
 };
 
+/*
+ * Stop sharing the player of the media node with other nodes and fall back on
+ * a separate player.
+ */
+int ngli_node_media_unshare(struct ngl_node *node);
+
 #endif
@@ -36,7 +36,8 @@ struct noise_opts {
 struct noise_priv {
     struct variable_info var;
     float vector[4];
-    struct noise generator[4];
+    struct noise generator;
+    uint32_t seeds[4];
 };
 
 const struct param_choices noise_func_choices = {
@@ -81,8 +82,8 @@ static int noisevec_update(struct ngl_node *node, double t, size_t n)
     struct noise_priv *s = node->priv_data;
     const struct noise_opts *o = node->opts;
     const float v = (float)(t * o->frequency);
-    for (size_t i = 0; i < n; i++)
-        s->vector[i] = ngli_noise_get(&s->generator[i], v);
+    const float times[] = {v, v, v, v};
+    ngli_noise_get_batch(&s->generator, s->vector, times, s->seeds, n);
     return 0;
 }
 
@@ -109,21 +110,17 @@ static int noisevec4_update(struct ngl_node *node, double t)
 static int init_noise_generators(struct noise_priv *s, const struct noise_opts *o, size_t n)
 {
     /*
-     * Every generator is instanciated the same, except for the seed: the seed
-     * offset is defined to create a large gap between every components to keep
-     * the overlap to the minimum possible
+     * Every component is evaluated with the same generator, except for the
+     * seed: the seed offset is defined to create a large gap between every
+     * components to keep the overlap to the minimum possible
      */
     const uint32_t seed_offset = UINT32_MAX / (uint32_t)n;
     uint32_t seed = o->generator_params.seed;
     for (size_t i = 0; i < n; i++) {
-        struct noise_params np = o->generator_params;
-        np.seed = seed;
-        int ret = ngli_noise_init(&s->generator[i], &np);
-        if (ret < 0)
-            return ret;
+        s->seeds[i] = seed;
         seed += seed_offset;
     }
-    return 0;
+    return ngli_noise_init(&s->generator, &o->generator_params);
 }
 
 #define DEFINE_NOISE_CLASS(class_id, class_name, type, dtype, count)        \
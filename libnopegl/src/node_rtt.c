@@ -358,46 +358,35 @@ static int rtt_resize(struct ngl_node *node)
 
     struct ngpu_texture *textures[NGPU_MAX_COLOR_ATTACHMENTS] = {NULL};
     struct ngpu_texture *depth_texture = NULL;
-    struct rtt_ctx *rtt_ctx = NULL;
 
     for (size_t i = 0; i < o->nb_color_textures; i++) {
-        textures[i] = ngpu_texture_create(ctx->gpu_ctx);
-        if (!textures[i]) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
         const struct rtt_texture_info info = get_rtt_texture_info(o->color_textures[i]);
         struct ngpu_texture_params texture_params = info.info->params;
         texture_params.width = width;
         texture_params.height = height;
 
-        ret = ngpu_texture_init(textures[i], &texture_params);
+        ret = ngli_texture_pool_get(ctx->texture_pool, &texture_params, &textures[i]);
         if (ret < 0)
             goto fail;
     }
 
     if (o->depth_texture) {
-        depth_texture = ngpu_texture_create(ctx->gpu_ctx);
-        if (!depth_texture) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
         const struct rtt_texture_info info = get_rtt_texture_info(o->depth_texture);
         struct ngpu_texture_params texture_params = info.info->params;
         texture_params.width = width;
         texture_params.height = height;
 
-        ret = ngpu_texture_init(depth_texture, &texture_params);
+        ret = ngli_texture_pool_get(ctx->texture_pool, &texture_params, &depth_texture);
         if (ret < 0)
             goto fail;
     }
 
-    rtt_ctx = ngli_rtt_create(ctx);
-    if (!rtt_ctx) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
+    if (!s->rtt_ctx) {
+        s->rtt_ctx = ngli_rtt_create(ctx);
+        if (!s->rtt_ctx) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
     }
 
     struct rtt_params params = s->rtt_params;
@@ -408,21 +397,18 @@ static int rtt_resize(struct ngl_node *node)
         params.colors[i].attachment = textures[i];
     params.depth_stencil.attachment = depth_texture;
 
-    ret = ngli_rtt_init(rtt_ctx, &params);
+    ret = ngli_rtt_init(s->rtt_ctx, &params);
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->rtt_ctx);
-
     s->width = width;
     s->height = height;
     s->rtt_params = params;
-    s->rtt_ctx = rtt_ctx;
 
     for (size_t i = 0; i < o->nb_color_textures; i++) {
         const struct rtt_texture_info info = get_rtt_texture_info(o->color_textures[i]);
         struct texture_info *texture_info = info.info;
-        ngpu_texture_freep(&texture_info->texture);
+        ngli_texture_pool_recycle(ctx->texture_pool, &texture_info->texture);
         texture_info->texture = textures[i];
         texture_info->image.params.width = width;
         texture_info->image.params.height = height;
@@ -433,7 +419,7 @@ static int rtt_resize(struct ngl_node *node)
     if (o->depth_texture) {
         const struct rtt_texture_info info = get_rtt_texture_info(o->depth_texture);
         struct texture_info *texture_info = info.info;
-        ngpu_texture_freep(&texture_info->texture);
+        ngli_texture_pool_recycle(ctx->texture_pool, &texture_info->texture);
         texture_info->texture = depth_texture;
         texture_info->image.params.width = width;
         texture_info->image.params.height = height;
@@ -444,10 +430,10 @@ static int rtt_resize(struct ngl_node *node)
     return 0;
 
 fail:
+    ngli_rtt_freep(&s->rtt_ctx);
     for (size_t i = 0; i < o->nb_color_textures; i++)
-        ngpu_texture_freep(&textures[i]);
-    ngpu_texture_freep(&depth_texture);
-    ngli_rtt_freep(&rtt_ctx);
+        ngli_texture_pool_recycle(ctx->texture_pool, &textures[i]);
+    ngli_texture_pool_recycle(ctx->texture_pool, &depth_texture);
 
     LOG(ERROR, "failed to resize rtt: %dx%d", width, height);
     return ret;
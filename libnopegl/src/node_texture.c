@@ -30,6 +30,7 @@
 #include "image.h"
 #include "internal.h"
 #include "log.h"
+#include "media_cache.h"
 #include "ngpu/ctx.h"
 #include "ngpu/format.h"
 #include "ngpu/texture.h"
@@ -53,6 +54,8 @@ struct texture_opts {
 struct texture_priv {
     struct texture_info texture_info;
     struct hwmap hwmap;
+    struct media_cache_image media_image; /* image borrowed from a shared media player */
+    uint64_t media_frame_id;
     int rtt_resizable;
     struct renderpass_info renderpass_info;
     struct ngpu_rendertarget_layout rendertarget_layout;
@@ -487,6 +490,31 @@ static int texture_prefetch(struct ngl_node *node)
     return 0;
 }
 
+static int handle_shared_media_frame(struct ngl_node *node)
+{
+    struct texture_priv *s = node->priv_data;
+    struct texture_info *i = node->priv_data;
+    const struct texture_opts *o = node->opts;
+    struct media_priv *media = o->data_src->priv_data;
+    struct media_cache_entry *entry = media->entry;
+    if (!entry || media->frame_id == s->media_frame_id)
+        return 0;
+    s->media_frame_id = media->frame_id;
+
+    /*
+     * The new frame has been mapped by another texture: its image is reused
+     * unless it has been mapped with different parameters or can not be
+     * shared, in which case the media node stops sharing its player.
+     */
+    if (!ngli_media_cache_borrow_image(entry, &s->hwmap.params, &s->media_image))
+        return ngli_node_media_unshare(o->data_src);
+
+    i->image = s->media_image.image;
+    i->image.rev = i->image_rev++;
+
+    return 0;
+}
+
 static int handle_media_frame(struct ngl_node *node)
 {
     struct texture_priv *s = node->priv_data;
@@ -495,7 +523,7 @@ static int handle_media_frame(struct ngl_node *node)
     struct media_priv *media = o->data_src->priv_data;
     struct nmd_frame *frame = media->frame;
     if (!frame)
-        return 0;
+        return handle_shared_media_frame(node);
 
     /* Transfer frame ownership to hwmap and ensure it cannot be re-used
      * later on */
@@ -504,7 +532,12 @@ static int handle_media_frame(struct ngl_node *node)
     /* Reset destination image */
     ngli_image_reset(&i->image);
 
+    const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
     int ret = ngli_hwmap_map_frame(&s->hwmap, frame, &i->image);
+    ngli_tracer_end(node->ctx->tracer, "texture_upload", node->label, trace_start);
+
+    ngli_media_cache_image_reset(&s->media_image);
+    s->media_frame_id = media->frame_id;
 
     /* Signal image change on new frame */
     i->image.rev = i->image_rev++;
@@ -514,6 +547,10 @@ static int handle_media_frame(struct ngl_node *node)
         return ret;
     }
 
+    /* Let the other textures sharing the media player reuse the image */
+    if (media->entry && ngli_hwmap_is_image_shareable(&s->hwmap))
+        ngli_media_cache_publish_image(media->entry, &s->hwmap.params, &i->image);
+
     return 0;
 }
 
@@ -524,7 +561,9 @@ static int handle_buffer_frame(struct ngl_node *node)
     struct buffer_info *buffer = o->data_src->priv_data;
     const uint8_t *data = buffer->data;
 
+    const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
     int ret = ngpu_texture_upload(i->texture, data, 0);
+    ngli_tracer_end(node->ctx->tracer, "texture_upload", node->label, trace_start);
     if (ret < 0) {
         LOG(ERROR, "could not upload texture buffer");
         return ret;
@@ -582,26 +621,21 @@ static int rtt_resize(struct ngl_node *node)
     }
 
     struct ngpu_texture *texture = NULL;
-    struct rtt_ctx *rtt_ctx = NULL;
-
-    texture = ngpu_texture_create(ctx->gpu_ctx);
-    if (!texture) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
-    }
 
     struct ngpu_texture_params texture_params = i->params;
     texture_params.width = width;
     texture_params.height = height;
 
-    ret = ngpu_texture_init(texture, &texture_params);
+    ret = ngli_texture_pool_get(ctx->texture_pool, &texture_params, &texture);
     if (ret < 0)
         goto fail;
 
-    rtt_ctx = ngli_rtt_create(ctx);
-    if (!rtt_ctx) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
+    if (!s->rtt_ctx) {
+        s->rtt_ctx = ngli_rtt_create(ctx);
+        if (!s->rtt_ctx) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
     }
 
     struct rtt_params rtt_params = s->rtt_params;
@@ -609,12 +643,11 @@ static int rtt_resize(struct ngl_node *node)
     rtt_params.height = height;
     rtt_params.colors[0].attachment = texture;
 
-    ret = ngli_rtt_init(rtt_ctx, &rtt_params);
+    ret = ngli_rtt_init(s->rtt_ctx, &rtt_params);
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->rtt_ctx);
-    ngpu_texture_freep(&i->texture);
+    ngli_texture_pool_recycle(ctx->texture_pool, &i->texture);
 
     i->params = texture_params;
     i->texture = texture;
@@ -623,13 +656,12 @@ static int rtt_resize(struct ngl_node *node)
     i->image.planes[0] = texture;
     i->image.rev = i->image_rev++;
     s->rtt_params = rtt_params;
-    s->rtt_ctx = rtt_ctx;
 
     return 0;
 
 fail:
-    ngpu_texture_freep(&texture);
-    ngli_rtt_freep(&rtt_ctx);
+    ngli_rtt_freep(&s->rtt_ctx);
+    ngli_texture_pool_recycle(ctx->texture_pool, &texture);
 
     LOG(ERROR, "failed to resize texture: %dx%d", width, height);
     return ret;
@@ -673,6 +705,8 @@ static void texture_release(struct ngl_node *node)
 
     ngli_rtt_freep(&s->rtt_ctx);
     ngli_hwmap_uninit(&s->hwmap);
+    ngli_media_cache_image_reset(&s->media_image);
+    s->media_frame_id = 0;
     ngpu_texture_freep(&i->texture);
     ngli_image_reset(&i->image);
     i->image.rev = i->image_rev++;
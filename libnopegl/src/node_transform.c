@@ -20,7 +20,6 @@
  */
 
 #include <stddef.h>
-#include <string.h>
 
 #include "internal.h"
 #include "math_utils.h"
@@ -43,7 +42,7 @@ static int update_matrix(struct ngl_node *node)
 {
     struct transform_priv *s = node->priv_data;
     const struct transform_opts *o = node->opts;
-    memcpy(s->trf.matrix, o->matrix, sizeof(o->matrix));
+    ngli_transform_set_matrix(&s->trf, o->matrix);
     return 0;
 }
 
@@ -64,7 +63,7 @@ static int transform_init(struct ngl_node *node)
 {
     struct transform_priv *s = node->priv_data;
     const struct transform_opts *o = node->opts;
-    memcpy(s->trf.matrix, o->matrix, sizeof(o->matrix));
+    ngli_transform_set_matrix(&s->trf, o->matrix);
     s->trf.child = o->child;
     return 0;
 }
@@ -79,8 +78,8 @@ static int transform_update(struct ngl_node *node, double t)
         return ret;
 
     if (o->matrix_node) {
-        float *data = ngli_node_get_data_ptr(o->matrix_node, o->matrix);
-        memcpy(s->trf.matrix, data, sizeof(s->trf.matrix));
+        const float *data = ngli_node_get_data_ptr(o->matrix_node, o->matrix);
+        ngli_transform_set_matrix(&s->trf, data);
     }
 
     return 0;
@@ -22,6 +22,8 @@
 #ifndef NODE_TRANSFORM_H
 #define NODE_TRANSFORM_H
 
+#include <stdint.h>
+
 #include "utils/utils.h"
 
 struct ngl_node;
@@ -29,6 +31,20 @@ struct ngl_node;
 struct transform {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+    uint64_t version; // bumped every time the matrix changes
+
+    /*
+     * Cached product of the matrix with the matrices of all the transform
+     * nodes below, along with the versions it has been computed from
+     */
+    NGLI_ALIGNED_MAT(chain_matrix);
+    const struct ngl_node *chain_child;
+    uint64_t chain_version;
+    uint64_t chain_matrix_version;
+    uint64_t chain_child_version;
+
+    /* Set while drawn as part of a chain already flattened by its parent */
+    int flattened;
 };
 
 #endif
@@ -155,13 +155,26 @@ struct ngl_node *ngl_node_create(uint32_t type)
 
 static void node_release(struct ngl_node *node)
 {
+    if (node->state == NGLI_NODE_STATE_PREFETCHING) {
+        const int executed = ngli_workpool_cancel(node->ctx->prefetch_workpool, &node->prefetch_job);
+        if (executed && node->cls->release) {
+            TRACE("RELEASE %s @ %p", node->label, node);
+            node->cls->release(node);
+        }
+        node->state = NGLI_NODE_STATE_INITIALIZED;
+        node->last_update_time = -1.;
+        return;
+    }
+
     if (node->state != NGLI_NODE_STATE_READY)
         return;
 
     ngli_assert(node->ctx);
     if (node->cls->release) {
         TRACE("RELEASE %s @ %p", node->label, node);
+        const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
         node->cls->release(node);
+        ngli_tracer_end(node->ctx->tracer, "release", node->label, trace_start);
     }
     node->state = NGLI_NODE_STATE_INITIALIZED;
     node->last_update_time = -1.;
@@ -201,7 +214,7 @@ static int node_init(struct ngl_node *node)
         }
     }
 
-    if (node->cls->prefetch)
+    if (node->cls->prefetch || node->cls->prefetch_async)
         node->state = NGLI_NODE_STATE_INITIALIZED;
     else
         node->state = NGLI_NODE_STATE_READY;
@@ -352,34 +365,99 @@ int ngli_node_visit(struct ngl_node *node, bool is_active, double t)
 
     /* Insert children (leaves) first */
     if (queue_node &&
-        (node->cls->prefetch || node->cls->release) &&
+        (node->cls->prefetch || node->cls->prefetch_async || node->cls->release) &&
         !ngli_darray_push(&node->ctx->activitycheck_nodes, &node))
         return NGL_ERROR_MEMORY;
 
     return 0;
 }
 
+static int prefetch_async_job(void *arg)
+{
+    struct ngl_node *node = arg;
+    return node->cls->prefetch_async(node);
+}
+
+static int node_submit_prefetch(struct ngl_node *node)
+{
+    if (node->state != NGLI_NODE_STATE_INITIALIZED || !node->cls->prefetch_async)
+        return 0;
+
+    TRACE("PREFETCH ASYNC %s @ %p", node->label, node);
+    node->prefetch_job = ngli_workpool_submit(node->ctx->prefetch_workpool, prefetch_async_job, node);
+    if (!node->prefetch_job)
+        return NGL_ERROR_MEMORY;
+    node->state = NGLI_NODE_STATE_PREFETCHING;
+
+    return 0;
+}
+
+/*
+ * A node is not prefetched until its pending asynchronous job is completed
+ * and all its active children are ready, unless it is required right away
+ */
+static int node_is_prefetchable(struct ngl_node *node)
+{
+    if (node->state == NGLI_NODE_STATE_PREFETCHING &&
+        !ngli_workpool_is_done(node->ctx->prefetch_workpool, node->prefetch_job))
+        return 0;
+
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+        const struct ngl_node *child = children[i];
+        if (child->is_active && child->state != NGLI_NODE_STATE_READY)
+            return 0;
+    }
+
+    return 1;
+}
+
 static int node_prefetch(struct ngl_node *node)
 {
     if (node->state == NGLI_NODE_STATE_READY)
         return 0;
 
+    /* Complete the prefetch of the children that has been deferred */
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+        struct ngl_node *child = children[i];
+        if (child->is_active) {
+            int ret = node_prefetch(child);
+            if (ret < 0)
+                return ret;
+        }
+    }
+
+    int ret = 0;
+    if (node->state == NGLI_NODE_STATE_PREFETCHING) {
+        const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
+        ret = ngli_workpool_wait(node->ctx->prefetch_workpool, &node->prefetch_job);
+        ngli_tracer_end(node->ctx->tracer, "prefetch_wait", node->label, trace_start);
+        if (ret < 0)
+            goto fail;
+    }
+
     if (node->cls->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
-        int ret = node->cls->prefetch(node);
-        if (ret < 0) {
-            LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
-            node->visit_time = -1.;
-            if (node->cls->release) {
-                LOG(VERBOSE, "RELEASE %s @ %p", node->label, node);
-                node->cls->release(node);
-            }
-            return ret;
-        }
+        const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
+        ret = node->cls->prefetch(node);
+        ngli_tracer_end(node->ctx->tracer, "prefetch", node->label, trace_start);
+        if (ret < 0)
+            goto fail;
     }
     node->state = NGLI_NODE_STATE_READY;
 
     return 0;
+
+fail:
+    LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
+    node->visit_time = -1.;
+    node->state = NGLI_NODE_STATE_INITIALIZED;
+    if (node->cls->release) {
+        LOG(VERBOSE, "RELEASE %s @ %p", node->label, node);
+        node->cls->release(node);
+    }
+    return ret;
 }
 
 int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
@@ -400,10 +478,25 @@ int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
             node_release(node);
     }
 
-    /* Prefetch nodes starting from the children (leaves) up to the parents (root) */
+    /* Start the asynchronous prefetch of all the newly active nodes at once */
     for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
         struct ngl_node *node = nodes[i];
         if (node->is_active) {
+            ret = node_submit_prefetch(node);
+            if (ret < 0)
+                return ret;
+        }
+    }
+
+    /*
+     * Prefetch nodes starting from the children (leaves) up to the parents
+     * (root). The nodes still waiting for a prefetch job are skipped: they
+     * will be prefetched during a later call, or synchronously if they need
+     * to be updated before that.
+     */
+    for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
+        struct ngl_node *node = nodes[i];
+        if (node->is_active && node_is_prefetchable(node)) {
             ret = node_prefetch(node);
             if (ret < 0)
                 return ret;
@@ -415,11 +508,19 @@ int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
 
 int ngli_node_update(struct ngl_node *node, double t)
 {
-    ngli_assert(node->state == NGLI_NODE_STATE_READY);
+    if (node->state != NGLI_NODE_STATE_READY) {
+        ngli_assert(node->is_active && node->state > NGLI_NODE_STATE_UNINITIALIZED);
+        int ret = node_prefetch(node);
+        if (ret < 0)
+            return ret;
+    }
+
     if (node->cls->update) {
         if (node->last_update_time != t) {
             TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+            const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
             int ret = node->cls->update(node, t);
+            ngli_tracer_end(node->ctx->tracer, "update", node->label, trace_start);
             if (ret < 0) {
                 LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
                 return ret;
@@ -468,7 +569,16 @@ void ngli_node_draw(struct ngl_node *node)
 {
     if (node->cls->draw) {
         TRACE("DRAW %s @ %p", node->label, node);
-        node->cls->draw(node);
+        const int64_t trace_start = ngli_tracer_begin(node->ctx->tracer);
+        struct gpu_timings *gpu_timings = node->ctx->gpu_timings;
+        if (gpu_timings && ngli_gpu_timings_is_timed_node(node)) {
+            ngli_gpu_timings_begin_node(gpu_timings, node);
+            node->cls->draw(node);
+            ngli_gpu_timings_end_node(gpu_timings);
+        } else {
+            node->cls->draw(node);
+        }
+        ngli_tracer_end(node->ctx->tracer, "draw", node->label, trace_start);
         node->draw_count++;
     }
 }
@@ -488,6 +598,17 @@ const struct node_param *ngli_node_param_find(const struct ngl_node *node, const
     return par;
 }
 
+/*
+ * The parameters of a node must not be live changed while its asynchronous
+ * prefetch is running
+ */
+static int node_complete_prefetch(struct ngl_node *node)
+{
+    if (node->state != NGLI_NODE_STATE_PREFETCHING)
+        return 0;
+    return node_prefetch(node);
+}
+
 static int param_add(struct ngl_node *node, const char *key, size_t nb_elems, void *elems)
 {
     int ret = 0;
@@ -508,8 +629,12 @@ static int param_add(struct ngl_node *node, const char *key, size_t nb_elems, vo
         return ret;
     }
 
-    if (node->ctx && par->update_func)
+    if (node->ctx && par->update_func) {
+        ret = node_complete_prefetch(node);
+        if (ret < 0)
+            return ret;
         ret = par->update_func(node);
+    }
 
     return ret;
 }
@@ -578,7 +703,10 @@ static int node_param_update(struct ngl_node *node, const struct node_param *par
         return 0;
 
     if (par->update_func) {
-        int ret = par->update_func(node);
+        int ret = node_complete_prefetch(node);
+        if (ret < 0)
+            return ret;
+        ret = par->update_func(node);
         if (ret < 0)
             return ret;
     }
@@ -20,25 +20,36 @@
  * under the License.
  */
 
-#include <math.h>
+#include <stddef.h>
 
 #include "math_utils.h"
 #include "noise.h"
 #include "utils/utils.h"
 
-static float curve_linear(float t)
+/*
+ * Number of samples evaluated together: every stage of the evaluation is a
+ * loop over the samples of a block with a constant trip count so that the
+ * compiler can vectorize it, and the interpolation function is selected once
+ * per block instead of once per sample
+ */
+#define BLOCK_SIZE 4
+
+static void curve_linear(float * restrict dst, const float * restrict t)
 {
-    return t;
+    for (size_t k = 0; k < BLOCK_SIZE; k++)
+        dst[k] = t[k];
 }
 
-static float curve_cubic(float t)
+static void curve_cubic(float * restrict dst, const float * restrict t)
 {
-    return (3.f - 2.f*t)*t*t;
+    for (size_t k = 0; k < BLOCK_SIZE; k++)
+        dst[k] = (3.f - 2.f*t[k])*t[k]*t[k];
 }
 
-static float curve_quintic(float t)
+static void curve_quintic(float * restrict dst, const float * restrict t)
 {
-    return ((6.f*t - 15.f)*t + 10.f)*t*t*t;
+    for (size_t k = 0; k < BLOCK_SIZE; k++)
+        dst[k] = ((6.f*t[k] - 15.f)*t[k] + 10.f)*t[k]*t[k]*t[k];
 }
 
 static const interp_func_type interp_func_map[NGLI_NOISE_NB] = {
@@ -70,29 +81,63 @@ static float u32tof32(uint32_t x)
     return u.f - 1.f;
 }
 
-/* Gradient noise, returns a value in [-.5,.5) */
-static float noise(const struct noise *s, float t)
+static uint32_t f32_to_bits(float x)
+{
+    const union { float f; uint32_t i; } u = {.f = x};
+    return u.i;
+}
+
+static float bits_to_f32(uint32_t x)
+{
+    const union { uint32_t i; float f; } u = {.i = x};
+    return u.f;
+}
+
+/*
+ * Gradient noise, returns the values in [-.5,.5) scaled by amp and
+ * accumulated into dst
+ */
+static void noise_block(const struct noise *s, float *dst, const float *t, const uint32_t *seeds, float amp)
 {
-    const float i = floorf(t);  // integer part (lattice point)
-    const float f = t - i;      // fractional part: where we are between 2 lattice points
-    const uint32_t x = (uint32_t)i + s->params.seed; // seed is an offsetting on the lattice
-
-    /*
-     * The random values correspond to the random slopes found at the 2 lattice
-     * points surrounding our current point; they are between [0,1) so we
-     * rescale them to [-1,1), which is equivalent to a tilt between [-π/4,π/4)
-     */
-    const float s0 = u32tof32(hash(x))     * 2.f - 1.f;
-    const float s1 = u32tof32(hash(x + 1)) * 2.f - 1.f;
-
-    /* Get the y-coordinate of the slope of each lattice */
-    const float y0 = s0 * f;
-    const float y1 = s1 * (f - 1.f);
+    float f[BLOCK_SIZE];
+    float y0[BLOCK_SIZE];
+    float y1[BLOCK_SIZE];
+    float a[BLOCK_SIZE];
+
+    for (size_t k = 0; k < BLOCK_SIZE; k++) {
+        /*
+         * Any float with a magnitude of at least 2^23 is an integer, so its
+         * fractional part is 0 and so is the noise, whatever the lattice
+         * point. Such values are replaced with 0 to get a well-defined
+         * integer conversion. The floor is computed without any float
+         * comparison so that the loop can be vectorized.
+         */
+        const uint32_t bits = f32_to_bits(t[k]);
+        const uint32_t mask = (bits >> 23 & 0xff) >= 127 + 23 ? 0 : UINT32_MAX;
+        const float v = bits_to_f32(bits & mask) + 0.f; // +0 to turn -0 into 0
+        const float r = (float)(int32_t)v;      // truncated toward 0
+        const float i = r - (float)(f32_to_bits(v - r) >> 31); // integer part (lattice point)
+        f[k] = v - i;                           // fractional part: where we are between 2 lattice points
+        const uint32_t x = (uint32_t)(int32_t)i + seeds[k]; // seed is an offsetting on the lattice
+
+        /*
+         * The random values correspond to the random slopes found at the 2
+         * lattice points surrounding our current point; they are between [0,1)
+         * so we rescale them to [-1,1), which is equivalent to a tilt between
+         * [-π/4,π/4)
+         */
+        const float s0 = u32tof32(hash(x))     * 2.f - 1.f;
+        const float s1 = u32tof32(hash(x + 1)) * 2.f - 1.f;
+
+        /* Get the y-coordinate of the slope of each lattice */
+        y0[k] = s0 * f[k];
+        y1[k] = s1 * (f[k] - 1.f);
+    }
 
     /* Interpolate between the 2 slope y-coordinates */
-    const float a = s->interp_func(f);
-    const float r = NGLI_MIX_F32(y0, y1, a);
-    return r;
+    s->interp_func(a, f);
+    for (size_t k = 0; k < BLOCK_SIZE; k++)
+        dst[k] += NGLI_MIX_F32(y0[k], y1[k], a[k]) * amp;
 }
 
 int ngli_noise_init(struct noise *s, const struct noise_params *params)
@@ -103,16 +148,53 @@ int ngli_noise_init(struct noise *s, const struct noise_params *params)
     return 0;
 }
 
-float ngli_noise_get(const struct noise *s, float t)
+static void get_block(const struct noise *s, float *dst, const float *t, const uint32_t *seeds)
 {
     /* Fractional Brownian Motion */
     const struct noise_params *p = &s->params;
-    float sum = 0.f;
+    float pos[BLOCK_SIZE];
+    for (size_t k = 0; k < BLOCK_SIZE; k++) {
+        pos[k] = t[k];
+        dst[k] = 0.f;
+    }
     float amp = p->amplitude;
     for (int32_t i = 0; i < p->octaves; i++) {
-        sum += noise(s, t) * amp;
-        t *= p->lacunarity;
+        noise_block(s, dst, pos, seeds, amp);
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+            pos[k] *= p->lacunarity;
         amp *= p->gain;
     }
-    return sum;
+}
+
+void ngli_noise_get_batch(const struct noise *s, float *dst, const float *t, const uint32_t *seeds, size_t n)
+{
+    uint32_t block_seeds[BLOCK_SIZE];
+    for (size_t k = 0; k < BLOCK_SIZE; k++)
+        block_seeds[k] = s->params.seed;
+
+    size_t i = 0;
+    for (; i + BLOCK_SIZE <= n; i += BLOCK_SIZE)
+        get_block(s, dst + i, t + i, seeds ? seeds + i : block_seeds);
+
+    /* Remaining samples, padded to a full block */
+    const size_t nb_remaining = n - i;
+    if (nb_remaining) {
+        float block_t[BLOCK_SIZE] = {0};
+        float block_dst[BLOCK_SIZE];
+        for (size_t k = 0; k < nb_remaining; k++) {
+            block_t[k] = t[i + k];
+            if (seeds)
+                block_seeds[k] = seeds[i + k];
+        }
+        get_block(s, block_dst, block_t, block_seeds);
+        for (size_t k = 0; k < nb_remaining; k++)
+            dst[i + k] = block_dst[k];
+    }
+}
+
+float ngli_noise_get(const struct noise *s, float t)
+{
+    float ret;
+    ngli_noise_get_batch(s, &ret, &t, NULL, 1);
+    return ret;
 }
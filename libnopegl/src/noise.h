@@ -23,6 +23,7 @@
 #ifndef NOISE_H
 #define NOISE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 enum {
@@ -32,7 +33,7 @@ enum {
     NGLI_NOISE_NB
 };
 
-typedef float (*interp_func_type)(float t);
+typedef void (*interp_func_type)(float *dst, const float *t);
 
 struct noise_params {
     float amplitude;
@@ -51,4 +52,11 @@ struct noise {
 int ngli_noise_init(struct noise *s, const struct noise_params *params);
 float ngli_noise_get(const struct noise *s, float t);
 
+/*
+ * Evaluate n samples at once: dst[i] is the noise at time t[i] using the seed
+ * seeds[i] (or the seed of the noise parameters if seeds is NULL). The result
+ * is the same as calling ngli_noise_get() for each sample.
+ */
+void ngli_noise_get_batch(const struct noise *s, float *dst, const float *t, const uint32_t *seeds, size_t n);
+
 #endif
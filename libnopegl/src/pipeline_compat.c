@@ -56,38 +56,16 @@ struct pipeline_compat {
     int updated;
     int need_pipeline_recreation;
     const struct ngpu_pgcraft_compat_info *compat_info;
-    struct ngpu_buffer *ubuffers[NGPU_PROGRAM_STAGE_NB];
-    uint8_t *mapped_datas[NGPU_PROGRAM_STAGE_NB];
+    uint8_t *udatas[NGPU_PROGRAM_STAGE_NB];
+    size_t usizes[NGPU_PROGRAM_STAGE_NB];
+    int udirty[NGPU_PROGRAM_STAGE_NB];
+    const struct ngpu_buffer *ubuffers[NGPU_PROGRAM_STAGE_NB];
+    size_t uoffset_indices[NGPU_PROGRAM_STAGE_NB];
+    uint64_t ugeneration;
+    size_t user_offset_indices[NGPU_MAX_DYNAMIC_OFFSETS];
+    size_t nb_user_offsets;
 };
 
-static int wait_buffer(struct pipeline_compat *s, enum ngpu_program_stage stage)
-{
-    if (s->mapped_datas[stage])
-        return 0;
-
-    struct ngpu_buffer *buffer = s->ubuffers[stage];
-    return ngpu_buffer_wait(buffer);
-}
-
-static int map_buffer(struct pipeline_compat *s, enum ngpu_program_stage stage)
-{
-    if (s->mapped_datas[stage])
-        return 0;
-
-    struct ngpu_buffer *buffer = s->ubuffers[stage];
-    return ngpu_buffer_map(buffer, 0, buffer->size, (void **) &s->mapped_datas[stage]);
-}
-
-static void unmap_buffers(struct pipeline_compat *s)
-{
-    for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++) {
-        if (s->mapped_datas[i]) {
-            ngpu_buffer_unmap(s->ubuffers[i]);
-            s->mapped_datas[i] = NULL;
-        }
-    }
-}
-
 struct pipeline_compat *ngli_pipeline_compat_create(struct ngpu_ctx *gpu_ctx)
 {
     struct pipeline_compat *s = ngli_calloc(1, sizeof(*s));
@@ -97,38 +75,53 @@ struct pipeline_compat *ngli_pipeline_compat_create(struct ngpu_ctx *gpu_ctx)
     return s;
 }
 
-static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_compat_params *params)
+static int is_dynamic_buffer(const struct ngpu_bindgroup_layout_entry *entry)
 {
-    struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
+    return entry->type == NGPU_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+           entry->type == NGPU_TYPE_STORAGE_BUFFER_DYNAMIC;
+}
 
+/*
+ * The uniform blocks are sub-allocated from the context uniform arena at
+ * draw time, and bound with a dynamic offset. Their data is kept in a CPU
+ * copy in the meantime.
+ */
+static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_compat_params *params)
+{
     for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++) {
         const size_t block_size = ngpu_block_desc_get_size(&s->compat_info->ublocks[i], 0);
         if (!block_size)
             continue;
 
-        struct ngpu_buffer *buffer = ngpu_buffer_create(gpu_ctx);
-        if (!buffer)
+        s->udatas[i] = ngli_calloc(1, block_size);
+        if (!s->udatas[i])
             return NGL_ERROR_MEMORY;
-        s->ubuffers[i] = buffer;
-
-        uint32_t usage = NGPU_BUFFER_USAGE_DYNAMIC_BIT
-                       | NGPU_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-                       | NGPU_BUFFER_USAGE_MAP_WRITE;
+        s->usizes[i] = block_size;
+        s->udirty[i] = 1;
+    }
 
-        if (gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT)
-            usage |= NGPU_BUFFER_USAGE_MAP_PERSISTENT;
+    /*
+     * Dynamic offsets are ordered as their respective buffers in the layout:
+     * split them between the ones managed by the uniform blocks and the ones
+     * set by the user with ngli_pipeline_compat_update_dynamic_offsets()
+     */
+    const struct ngpu_bindgroup_layout_desc *layout_desc = &s->bindgroup_layout_desc;
+    for (size_t i = 0; i < layout_desc->nb_buffers; i++) {
+        if (!is_dynamic_buffer(&layout_desc->buffers[i]))
+            continue;
 
-        int ret = ngpu_buffer_init(buffer, block_size, usage);
-        if (ret < 0)
-            return ret;
+        const size_t offset_index = s->nb_dynamic_offsets++;
+        ngli_assert(offset_index < NGPU_MAX_DYNAMIC_OFFSETS);
 
-        if (gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT) {
-            ret = ngpu_buffer_map(buffer, 0, buffer->size, (void **) &s->mapped_datas[i]);
-            if (ret < 0)
-                return ret;
+        int ublock = 0;
+        for (size_t j = 0; j < NGPU_PROGRAM_STAGE_NB; j++) {
+            if (s->usizes[j] && s->compat_info->uindices[j] == (int32_t)i) {
+                s->uoffset_indices[j] = offset_index;
+                ublock = 1;
+            }
         }
-
-        ngli_pipeline_compat_update_buffer(s, s->compat_info->uindices[i], buffer, 0, buffer->size);
+        if (!ublock)
+            s->user_offset_indices[s->nb_user_offsets++] = offset_index;
     }
 
     return 0;
@@ -203,7 +196,11 @@ static int create_pipeline(struct pipeline_compat *s)
         .program  = s->program,
         .layout   = {
             .bindgroup_layout = s->bindgroup_layout,
-        }
+        },
+        .specialization = {
+            .constants    = s->compat_info->constants,
+            .nb_constants = s->compat_info->nb_constants,
+        },
     };
 
     ret = ngpu_pipeline_init(s->pipeline, &pipeline_params);
@@ -276,8 +273,6 @@ int ngli_pipeline_compat_update_vertex_buffer(struct pipeline_compat *s, int32_t
 
 int ngli_pipeline_compat_update_uniform_count(struct pipeline_compat *s, int32_t index, const void *value, size_t count)
 {
-    struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
-
     if (index == -1)
         return NGL_ERROR_NOT_FOUND;
 
@@ -287,17 +282,9 @@ int ngli_pipeline_compat_update_uniform_count(struct pipeline_compat *s, int32_t
     const struct ngpu_block_field *fields = ngli_darray_data(&block->fields);
     const struct ngpu_block_field *field = &fields[field_index];
     if (value) {
-        if (!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT)) {
-            int ret = map_buffer(s, stage);
-            if (ret < 0)
-                return ret;
-        } else {
-            int ret = wait_buffer(s, stage);
-            if (ret < 0)
-                return ret;
-        }
-        uint8_t *dst = s->mapped_datas[stage] + field->offset;
+        uint8_t *dst = s->udatas[stage] + field->offset;
         ngpu_block_field_copy_count(field, dst, value, count);
+        s->udirty[stage] = 1;
     }
 
     return 0;
@@ -335,9 +322,9 @@ int ngli_pipeline_compat_update_texture(struct pipeline_compat *s, int32_t index
 
 int ngli_pipeline_compat_update_dynamic_offsets(struct pipeline_compat *s, const uint32_t *offsets, size_t nb_offsets)
 {
-    ngli_assert(s->bindgroup_layout->nb_dynamic_offsets == nb_offsets);
-    memcpy(s->dynamic_offsets, offsets, nb_offsets * sizeof(*s->dynamic_offsets));
-    s->nb_dynamic_offsets = nb_offsets;
+    ngli_assert(s->nb_user_offsets == nb_offsets);
+    for (size_t i = 0; i < nb_offsets; i++)
+        s->dynamic_offsets[s->user_offset_indices[i]] = offsets[i];
     return 0;
 }
 
@@ -392,6 +379,7 @@ void ngli_pipeline_compat_update_image(struct pipeline_compat *s, int32_t index,
     ngli_pipeline_compat_update_uniform(s, fields[NGPU_INFO_FIELD_COORDINATE_MATRIX].index, image->coordinates_matrix);
     ngli_pipeline_compat_update_uniform(s, fields[NGPU_INFO_FIELD_COLOR_MATRIX].index, image->color_matrix);
     ngli_pipeline_compat_update_uniform(s, fields[NGPU_INFO_FIELD_TIMESTAMP].index, &image->ts);
+    ngli_pipeline_compat_update_uniform(s, fields[NGPU_INFO_FIELD_CLAMP].index, &info->clamp_video);
 
     if (image->params.layout) {
         const float dimensions[] = {(float)image->params.width, (float)image->params.height, (float)image->params.depth};
@@ -539,14 +527,50 @@ static int prepare_bindgroup(struct pipeline_compat *s)
     return 0;
 }
 
+static int prepare_blocks_buffers(struct pipeline_compat *s)
+{
+    struct ngpu_uniform_arena *arena = &s->gpu_ctx->uniform_arena;
+
+    /*
+     * The previous allocations remain valid as long as the arena stays in the
+     * same region, so unchanged blocks do not need to be copied again
+     */
+    const int invalidated = s->ugeneration != arena->generation;
+
+    for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++) {
+        if (!s->usizes[i] || (!s->udirty[i] && !invalidated))
+            continue;
+
+        struct ngpu_buffer *buffer;
+        uint32_t offset;
+        int ret = ngpu_uniform_arena_alloc(arena, s->udatas[i], s->usizes[i], &buffer, &offset);
+        if (ret < 0)
+            return ret;
+
+        if (s->ubuffers[i] != buffer) {
+            ngli_pipeline_compat_update_buffer(s, s->compat_info->uindices[i], buffer, 0, s->usizes[i]);
+            s->ubuffers[i] = buffer;
+        }
+        s->dynamic_offsets[s->uoffset_indices[i]] = offset;
+        s->udirty[i] = 0;
+    }
+
+    s->ugeneration = arena->generation;
+
+    return 0;
+}
+
 static int prepare_pipeline(struct pipeline_compat *s)
 {
-    struct ngpu_ctx *gpu_ctx = s->gpu_ctx;
+    int ret = ngpu_pipeline_wait(s->pipeline);
+    if (ret < 0)
+        return ret;
 
-    if (!(gpu_ctx->features & NGPU_FEATURE_BUFFER_MAP_PERSISTENT))
-       unmap_buffers(s);
+    ret = prepare_blocks_buffers(s);
+    if (ret < 0)
+        return ret;
 
-    int ret = prepare_bindgroup(s);
+    ret = prepare_bindgroup(s);
     if (ret < 0)
         return ret;
 
@@ -615,14 +639,7 @@ void ngli_pipeline_compat_freep(struct pipeline_compat **sp)
     ngli_freep(&s->textures);
     ngli_freep(&s->buffers);
 
-    if (s->compat_info) {
-        for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++) {
-            if (s->ubuffers[i]) {
-                if (s->mapped_datas[i])
-                    ngpu_buffer_unmap(s->ubuffers[i]);
-                ngpu_buffer_freep(&s->ubuffers[i]);
-            }
-        }
-    }
+    for (size_t i = 0; i < NGPU_PROGRAM_STAGE_NB; i++)
+        ngli_freep(&s->udatas[i]);
     ngli_freep(sp);
 }
@@ -30,6 +30,7 @@
 #include "ngpu/rendertarget.h"
 #include "rtt.h"
 #include "utils/memory.h"
+#include "utils/utils.h"
 
 struct rtt_ctx {
     struct ngl_ctx *ctx;
@@ -43,7 +44,6 @@ struct rtt_ctx {
     struct ngpu_texture *depth;
 
     struct ngpu_texture *ms_colors[NGPU_MAX_COLOR_ATTACHMENTS];
-    size_t nb_ms_colors;
     struct ngpu_texture *ms_depth;
 
     struct image images[NGPU_MAX_COLOR_ATTACHMENTS];
@@ -53,6 +53,7 @@ struct rtt_ctx {
     struct ngpu_scissor prev_scissor;
     struct ngpu_rendertarget *prev_rendertargets[2];
     struct ngpu_rendertarget *prev_rendertarget;
+    int64_t trace_start;
 };
 
 struct rtt_ctx *ngli_rtt_create(struct ngl_ctx *ctx)
@@ -64,13 +65,37 @@ struct rtt_ctx *ngli_rtt_create(struct ngl_ctx *ctx)
     return s;
 }
 
+/*
+ * The internal attachments are never sampled, so they are obtained with
+ * bucketed dimensions and kept across reinitializations as long as they still
+ * match the bucket of the requested dimensions.
+ */
+static int get_attachment(struct rtt_ctx *s, const struct ngpu_texture_params *params,
+                          struct ngpu_texture **texturep)
+{
+    struct texture_pool *texture_pool = s->ctx->texture_pool;
+
+    if (*texturep && ngli_texture_pool_match_bucket(texture_pool, *texturep, params))
+        return 0;
+
+    ngli_texture_pool_recycle(texture_pool, texturep);
+    return ngli_texture_pool_get_bucketed(texture_pool, params, texturep);
+}
+
 int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
 {
     struct ngl_ctx *ctx = s->ctx;
     struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
 
+    ngli_assert(!s->started);
+
     s->params = *params;
 
+    s->available_rendertargets[0] = NULL;
+    s->available_rendertargets[1] = NULL;
+    ngpu_rendertarget_freep(&s->rt);
+    ngpu_rendertarget_freep(&s->rt_resume);
+
     uint32_t transient_usage = 0;
     if (!params->nb_interruptions)
         transient_usage |= NGPU_TEXTURE_USAGE_TRANSIENT_ATTACHMENT_BIT;
@@ -80,17 +105,13 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
         .height = s->params.height,
     };
 
+    size_t nb_ms_colors = 0;
     for (size_t i = 0; i < s->params.nb_colors; i++) {
         struct ngpu_attachment *attachment = &s->params.colors[i];
         if (s->params.samples > 1) {
             struct ngpu_texture *texture = attachment->attachment;
             const int texture_layer = attachment->attachment_layer;
 
-            struct ngpu_texture *ms_texture = ngpu_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_colors[s->nb_ms_colors++] = ms_texture;
-
             struct ngpu_texture_params attachment_params = {
                 .type    = NGPU_TEXTURE_TYPE_2D,
                 .format  = texture->params.format,
@@ -99,9 +120,10 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
                 .samples = s->params.samples,
                 .usage   = NGPU_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | transient_usage,
             };
-            int ret = ngpu_texture_init(ms_texture, &attachment_params);
+            int ret = get_attachment(s, &attachment_params, &s->ms_colors[nb_ms_colors]);
             if (ret < 0)
                 return ret;
+            struct ngpu_texture *ms_texture = s->ms_colors[nb_ms_colors++];
 
             rt_params.colors[rt_params.nb_colors].attachment = ms_texture;
             rt_params.colors[rt_params.nb_colors].attachment_layer = 0;
@@ -133,11 +155,6 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             struct ngpu_texture *texture = attachment->attachment;
             const int texture_layer = attachment->attachment_layer;
 
-            struct ngpu_texture *ms_texture = ngpu_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_depth = ms_texture;
-
             struct ngpu_texture_params attachment_params = {
                 .type    = NGPU_TEXTURE_TYPE_2D,
                 .format  = texture->params.format,
@@ -146,9 +163,10 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
                 .samples = s->params.samples,
                 .usage   = NGPU_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            int ret = ngpu_texture_init(ms_texture, &attachment_params);
+            int ret = get_attachment(s, &attachment_params, &s->ms_depth);
             if (ret < 0)
                 return ret;
+            struct ngpu_texture *ms_texture = s->ms_depth;
 
             rt_params.depth_stencil.attachment = ms_texture;
             rt_params.depth_stencil.attachment_layer = 0;
@@ -161,11 +179,6 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             rt_params.depth_stencil = s->params.depth_stencil;
         }
     } else if (s->params.depth_stencil_format != NGPU_FORMAT_UNDEFINED) {
-        struct ngpu_texture *depth = ngpu_texture_create(gpu_ctx);
-        if (!depth)
-            return NGL_ERROR_MEMORY;
-        s->depth = depth;
-
         struct ngpu_texture_params attachment_params = {
             .type    = NGPU_TEXTURE_TYPE_2D,
             .format  = s->params.depth_stencil_format,
@@ -174,11 +187,11 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             .samples = s->params.samples,
             .usage   = NGPU_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
         };
-        int ret = ngpu_texture_init(depth, &attachment_params);
+        int ret = get_attachment(s, &attachment_params, &s->depth);
         if (ret < 0)
             return ret;
 
-        rt_params.depth_stencil.attachment = depth;
+        rt_params.depth_stencil.attachment = s->depth;
         rt_params.depth_stencil.load_op = NGPU_LOAD_OP_CLEAR;
         /*
          * For the first rendertarget with load operations set to clear, if
@@ -191,6 +204,14 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
         rt_params.depth_stencil.store_op = store_op;
     }
 
+    /* Release the internal attachments which are not needed anymore */
+    for (size_t i = nb_ms_colors; i < NGLI_ARRAY_NB(s->ms_colors); i++)
+        ngli_texture_pool_recycle(ctx->texture_pool, &s->ms_colors[i]);
+    if (rt_params.depth_stencil.attachment != s->ms_depth)
+        ngli_texture_pool_recycle(ctx->texture_pool, &s->ms_depth);
+    if (rt_params.depth_stencil.attachment != s->depth)
+        ngli_texture_pool_recycle(ctx->texture_pool, &s->depth);
+
     s->rt = ngpu_rendertarget_create(gpu_ctx);
     if (!s->rt)
         return NGL_ERROR_MEMORY;
@@ -237,13 +258,8 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
 int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct ngpu_texture_params *params)
 {
     struct ngl_ctx *ctx = s->ctx;
-    struct ngpu_ctx *gpu_ctx = ctx->gpu_ctx;
 
-    s->color = ngpu_texture_create(gpu_ctx);
-    if (!s->color)
-        return NGL_ERROR_MEMORY;
-
-    int ret = ngpu_texture_init(s->color, params);
+    int ret = ngli_texture_pool_get(ctx->texture_pool, params, &s->color);
     if (ret < 0)
         return ret;
 
@@ -305,6 +321,11 @@ void ngli_rtt_begin(struct rtt_ctx *s)
     ctx->available_rendertargets[0] = s->available_rendertargets[0];
     ctx->available_rendertargets[1] = s->available_rendertargets[1];
     ctx->current_rendertarget = s->available_rendertargets[0];
+
+    if (ctx->gpu_timings)
+        ngli_gpu_timings_begin_pass(ctx->gpu_timings);
+
+    s->trace_start = ngli_tracer_begin(ctx->tracer);
 }
 
 void ngli_rtt_end(struct rtt_ctx *s)
@@ -332,6 +353,11 @@ void ngli_rtt_end(struct rtt_ctx *s)
         if (texture_params->mipmap_filter != NGPU_MIPMAP_FILTER_NONE)
             ngpu_ctx_generate_texture_mipmap(gpu_ctx, texture);
     }
+
+    if (ctx->gpu_timings)
+        ngli_gpu_timings_end_pass(ctx->gpu_timings);
+
+    ngli_tracer_end(ctx->tracer, "render_pass", NULL, s->trace_start);
 }
 
 void ngli_rtt_freep(struct rtt_ctx **sp)
@@ -345,13 +371,13 @@ void ngli_rtt_freep(struct rtt_ctx **sp)
 
     ngpu_rendertarget_freep(&s->rt);
     ngpu_rendertarget_freep(&s->rt_resume);
-    ngpu_texture_freep(&s->depth);
+    struct texture_pool *texture_pool = s->ctx->texture_pool;
+    ngli_texture_pool_recycle(texture_pool, &s->depth);
 
-    for (size_t i = 0; i < s->nb_ms_colors; i++)
-        ngpu_texture_freep(&s->ms_colors[i]);
-    s->nb_ms_colors = 0;
-    ngpu_texture_freep(&s->ms_depth);
-    ngpu_texture_freep(&s->color);
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s->ms_colors); i++)
+        ngli_texture_pool_recycle(texture_pool, &s->ms_colors[i]);
+    ngli_texture_pool_recycle(texture_pool, &s->ms_depth);
+    ngli_texture_pool_recycle(texture_pool, &s->color);
 
     ngli_freep(sp);
 }
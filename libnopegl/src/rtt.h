@@ -46,6 +46,12 @@ struct rtt_params {
 };
 
 struct rtt_ctx *ngli_rtt_create(struct ngl_ctx *ctx);
+
+/*
+ * Can be called again to change the parameters (typically the dimensions),
+ * in which case the internal attachments are kept if they are still large
+ * enough. On failure, the context must be destroyed.
+ */
 int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params);
 int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct ngpu_texture_params *params);
 void ngli_rtt_get_dimensions(struct rtt_ctx *s, int32_t *width, int32_t *height);
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "internal.h"
+#include "log.h"
+#include "ngpu/ctx.h"
+#include "rtt.h"
+#include "rtt_pool.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
+
+/* Number of frames an unused render target is kept around before being destroyed */
+#define MAX_IDLE_FRAMES 4
+
+struct entry {
+    struct ngpu_texture_params params;
+    size_t nb_colors;
+    struct ngpu_texture *textures[NGPU_MAX_COLOR_ATTACHMENTS];
+    struct rtt_ctx *rtt_ctx;
+    int in_use;
+    uint64_t last_frame;
+};
+
+struct rtt_pool {
+    struct ngl_ctx *ctx;
+    struct darray entries; /* struct entry */
+    uint64_t frame;
+};
+
+static void reset_entry(void *user_arg, void *data)
+{
+    struct entry *entry = data;
+    struct rtt_pool *s = user_arg;
+    ngli_rtt_freep(&entry->rtt_ctx);
+    for (size_t i = 0; i < entry->nb_colors; i++)
+        ngli_texture_pool_recycle(s->ctx->texture_pool, &entry->textures[i]);
+}
+
+struct rtt_pool *ngli_rtt_pool_create(struct ngl_ctx *ctx)
+{
+    struct rtt_pool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    ngli_darray_init(&s->entries, sizeof(struct entry), 0);
+    ngli_darray_set_free_func(&s->entries, reset_entry, s);
+    return s;
+}
+
+void ngli_rtt_pool_begin_frame(struct rtt_pool *s)
+{
+    s->frame++;
+
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries);) {
+        struct entry *entry = &entries[i];
+        ngli_assert(!entry->in_use);
+        if (s->frame - entry->last_frame > MAX_IDLE_FRAMES) {
+            ngli_darray_remove(&s->entries, i);
+            continue;
+        }
+        i++;
+    }
+}
+
+static int init_entry(struct rtt_pool *s, struct entry *entry)
+{
+    struct rtt_params rtt_params = {
+        .width     = entry->params.width,
+        .height    = entry->params.height,
+        .nb_colors = entry->nb_colors,
+    };
+
+    for (size_t i = 0; i < entry->nb_colors; i++) {
+        int ret = ngli_texture_pool_get(s->ctx->texture_pool, &entry->params, &entry->textures[i]);
+        if (ret < 0)
+            return ret;
+
+        rtt_params.colors[i] = (struct ngpu_attachment) {
+            .attachment = entry->textures[i],
+            .load_op    = NGPU_LOAD_OP_CLEAR,
+            .store_op   = NGPU_STORE_OP_STORE,
+        };
+    }
+
+    entry->rtt_ctx = ngli_rtt_create(s->ctx);
+    if (!entry->rtt_ctx)
+        return NGL_ERROR_MEMORY;
+
+    return ngli_rtt_init(entry->rtt_ctx, &rtt_params);
+}
+
+struct rtt_ctx *ngli_rtt_pool_acquire(struct rtt_pool *s, const struct ngpu_texture_params *params, size_t nb_colors)
+{
+    ngli_assert(nb_colors > 0 && nb_colors <= NGPU_MAX_COLOR_ATTACHMENTS);
+
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        if (!entry->in_use &&
+            entry->nb_colors == nb_colors &&
+            !memcmp(&entry->params, params, sizeof(*params))) {
+            entry->in_use = 1;
+            entry->last_frame = s->frame;
+            return entry->rtt_ctx;
+        }
+    }
+
+    struct entry new_entry = {
+        .params     = *params,
+        .nb_colors  = nb_colors,
+        .in_use     = 1,
+        .last_frame = s->frame,
+    };
+
+    int ret = init_entry(s, &new_entry);
+    if (ret < 0) {
+        LOG(ERROR, "could not create transient render target %dx%d: %s",
+            params->width, params->height, NGLI_RET_STR(ret));
+        reset_entry(s, &new_entry);
+        return NULL;
+    }
+
+    struct entry *entry = ngli_darray_push(&s->entries, &new_entry);
+    if (!entry) {
+        reset_entry(s, &new_entry);
+        return NULL;
+    }
+
+    return entry->rtt_ctx;
+}
+
+void ngli_rtt_pool_release(struct rtt_pool *s, struct rtt_ctx **rtt_ctxp)
+{
+    struct rtt_ctx *rtt_ctx = *rtt_ctxp;
+    if (!rtt_ctx)
+        return;
+
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        if (entry->rtt_ctx == rtt_ctx) {
+            ngli_assert(entry->in_use);
+            entry->in_use = 0;
+            *rtt_ctxp = NULL;
+            return;
+        }
+    }
+    ngli_assert(0);
+}
+
+void ngli_rtt_pool_freep(struct rtt_pool **sp)
+{
+    struct rtt_pool *s = *sp;
+    if (!s)
+        return;
+    ngli_darray_reset(&s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef RTT_POOL_H
+#define RTT_POOL_H
+
+#include <stdlib.h>
+
+#include "ngpu/texture.h"
+
+struct ngl_ctx;
+struct rtt_ctx;
+struct rtt_pool;
+
+/*
+ * Pool of transient render targets, shared by all the nodes of a rendering
+ * context.
+ *
+ * Intermediate attachments (such as the ones used between the passes of a
+ * blur) are only live between the first pass writing them and the last pass
+ * sampling them. Instead of keeping them allocated for the lifetime of each
+ * node, nodes acquire them right before their first pass and release them
+ * right after their last one. Since the passes are executed by the GPU in
+ * submission order, a released render target can be handed out again within
+ * the same frame to another node requesting identical attachments.
+ *
+ * Render targets that have not been acquired for a few frames are destroyed.
+ */
+
+struct rtt_pool *ngli_rtt_pool_create(struct ngl_ctx *ctx);
+
+/* Must be called once per frame, before any render target is acquired */
+void ngli_rtt_pool_begin_frame(struct rtt_pool *s);
+
+/*
+ * Acquire a render target with nb_colors color attachments, all of them
+ * created with the same texture parameters. The attachments are cleared when
+ * the render target begins.
+ */
+struct rtt_ctx *ngli_rtt_pool_acquire(struct rtt_pool *s, const struct ngpu_texture_params *params, size_t nb_colors);
+void ngli_rtt_pool_release(struct rtt_pool *s, struct rtt_ctx **rtt_ctxp);
+
+void ngli_rtt_pool_freep(struct rtt_pool **sp);
+
+#endif
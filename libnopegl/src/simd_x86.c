@@ -21,15 +21,18 @@
  */
 
 #include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
 
 #include "math_utils.h"
 
-void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
+static inline void mat4_mul_sse(float *dst, const float *m1, const float *m2)
 {
-    __m128 m1_0 = _mm_load_ps(m1);
-    __m128 m1_1 = _mm_load_ps(m1 + 4);
-    __m128 m1_2 = _mm_load_ps(m1 + 8);
-    __m128 m1_3 = _mm_load_ps(m1 + 12);
+    __m128 m1_0 = _mm_loadu_ps(m1);
+    __m128 m1_1 = _mm_loadu_ps(m1 + 4);
+    __m128 m1_2 = _mm_loadu_ps(m1 + 8);
+    __m128 m1_3 = _mm_loadu_ps(m1 + 12);
 
     __m128 r0 = _mm_mul_ps(m1_0, _mm_set1_ps(m2[0]));
     __m128 r1 = _mm_mul_ps(m1_0, _mm_set1_ps(m2[4]));
@@ -51,18 +54,18 @@ void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
     r2 = _mm_add_ps(r2, _mm_mul_ps(m1_3, _mm_set1_ps(m2[3 + 8])));
     r3 = _mm_add_ps(r3, _mm_mul_ps(m1_3, _mm_set1_ps(m2[3 + 12])));
 
-    _mm_store_ps(dst,      r0);
-    _mm_store_ps(dst + 4,  r1);
-    _mm_store_ps(dst + 8,  r2);
-    _mm_store_ps(dst + 12, r3);
+    _mm_storeu_ps(dst,      r0);
+    _mm_storeu_ps(dst + 4,  r1);
+    _mm_storeu_ps(dst + 8,  r2);
+    _mm_storeu_ps(dst + 12, r3);
 }
 
-void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
+static inline void mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 {
-    __m128 m0 = _mm_load_ps(m);
-    __m128 m1 = _mm_load_ps(m + 4);
-    __m128 m2 = _mm_load_ps(m + 8);
-    __m128 m3 = _mm_load_ps(m + 12);
+    __m128 m0 = _mm_loadu_ps(m);
+    __m128 m1 = _mm_loadu_ps(m + 4);
+    __m128 m2 = _mm_loadu_ps(m + 8);
+    __m128 m3 = _mm_loadu_ps(m + 12);
 
     __m128 r0 = _mm_mul_ps(m0, _mm_set1_ps(v[0]));
     __m128 r1 = _mm_mul_ps(m1, _mm_set1_ps(v[1]));
@@ -71,5 +74,129 @@ void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 
     __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(r0, r1), r2), r3);
 
-    _mm_store_ps(dst, r);
+    _mm_storeu_ps(dst, r);
+}
+
+void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2)
+{
+    mat4_mul_sse(dst, m1, m2);
+}
+
+void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
+{
+    mat4_mul_vec4_sse(dst, m, v);
+}
+
+void ngli_mat4_mul_batch_sse(float *dst, const float *m1, const float *m2, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        mat4_mul_sse(dst + i * 4 * 4, m1 + i * 4 * 4, m2 + i * 4 * 4);
+}
+
+void ngli_mat4_mul_vec4_batch_sse(float *dst, const float *m, const float *v, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        mat4_mul_vec4_sse(dst + i * 4, m + i * 4 * 4, v + i * 4);
+}
+
+int ngli_cpu_has_avx(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const int has_osxsave = info[2] >> 27 & 1;
+    const int has_avx     = info[2] >> 28 & 1;
+    if (!has_osxsave || !has_avx)
+        return 0;
+    /* The OS must also save the YMM registers on context switches */
+    return (_xgetbv(0) & 0x6) == 0x6;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * The AVX kernels are built with the target attribute so that the rest of the
+ * code does not require AVX; they must only be called if ngli_cpu_has_avx()
+ * returns true. The operations are performed in the same order as the SSE
+ * versions so both give the exact same results.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+# define TARGET_AVX __attribute__((target("avx")))
+#else
+# define TARGET_AVX
+#endif
+
+TARGET_AVX
+static inline void mat4_mul_avx(float *dst, const float *m1, const float *m2)
+{
+    /* Each column of m1 is duplicated in both lanes */
+    const __m256 m1_0 = _mm256_broadcast_ps((const __m128 *)m1);
+    const __m256 m1_1 = _mm256_broadcast_ps((const __m128 *)(m1 + 4));
+    const __m256 m1_2 = _mm256_broadcast_ps((const __m128 *)(m1 + 8));
+    const __m256 m1_3 = _mm256_broadcast_ps((const __m128 *)(m1 + 12));
+
+    /* 2 columns of m2 (and the destination) per register */
+    const __m256 m2_01 = _mm256_loadu_ps(m2);
+    const __m256 m2_23 = _mm256_loadu_ps(m2 + 8);
+
+    __m256 r01 = _mm256_mul_ps(m1_0, _mm256_permute_ps(m2_01, 0x00));
+    __m256 r23 = _mm256_mul_ps(m1_0, _mm256_permute_ps(m2_23, 0x00));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_1, _mm256_permute_ps(m2_01, 0x55)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_1, _mm256_permute_ps(m2_23, 0x55)));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_2, _mm256_permute_ps(m2_01, 0xaa)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_2, _mm256_permute_ps(m2_23, 0xaa)));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_3, _mm256_permute_ps(m2_01, 0xff)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_3, _mm256_permute_ps(m2_23, 0xff)));
+
+    _mm256_storeu_ps(dst,     r01);
+    _mm256_storeu_ps(dst + 8, r23);
+}
+
+TARGET_AVX
+static inline __m256 load_2x4_avx(const float *lo, const float *hi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+TARGET_AVX
+void ngli_mat4_mul_batch_avx(float *dst, const float *m1, const float *m2, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        mat4_mul_avx(dst + i * 4 * 4, m1 + i * 4 * 4, m2 + i * 4 * 4);
+}
+
+TARGET_AVX
+void ngli_mat4_mul_vec4_batch_avx(float *dst, const float *m, const float *v, size_t n)
+{
+    /* 2 matrices and vectors per iteration, one in each lane */
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        const float *ma = m + i * 4 * 4;
+        const float *mb = ma + 4 * 4;
+
+        const __m256 m0 = load_2x4_avx(ma,      mb);
+        const __m256 m1 = load_2x4_avx(ma + 4,  mb + 4);
+        const __m256 m2 = load_2x4_avx(ma + 8,  mb + 8);
+        const __m256 m3 = load_2x4_avx(ma + 12, mb + 12);
+
+        const __m256 vab = _mm256_loadu_ps(v + i * 4);
+
+        const __m256 r0 = _mm256_mul_ps(m0, _mm256_permute_ps(vab, 0x00));
+        const __m256 r1 = _mm256_mul_ps(m1, _mm256_permute_ps(vab, 0x55));
+        const __m256 r2 = _mm256_mul_ps(m2, _mm256_permute_ps(vab, 0xaa));
+        const __m256 r3 = _mm256_mul_ps(m3, _mm256_permute_ps(vab, 0xff));
+
+        const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(r0, r1), r2), r3);
+
+        _mm256_storeu_ps(dst + i * 4, r);
+    }
+    if (i < n)
+        mat4_mul_vec4_sse(dst + i * 4, m + i * 4 * 4, v + i * 4);
 }
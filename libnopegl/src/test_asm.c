@@ -21,6 +21,8 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
+#include <time.h>
 
 #include "math_utils.h"
 #include "utils/utils.h"
@@ -42,7 +44,96 @@ static void flt_check(const float *f, size_t size)
     printf("=> OK\n");
 }
 
-int main(void)
+#define BATCH_SIZE 1024
+
+static void fill_random(float *dst, size_t n, uint32_t *state)
+{
+    for (size_t i = 0; i < n; i++) {
+        *state = *state * 1664525 + 1013904223;
+        dst[i] = (float)(*state >> 8) / (float)(1 << 24) * 2.f - 1.f;
+    }
+}
+
+static void check_batches(void)
+{
+    /* Odd count and misaligned pointers to exercise the tails and unaligned loads */
+    const size_t n = 37;
+    float *buf = calloc(3 * 4 * 4 * n + 1, sizeof(*buf));
+    float *ref = calloc(4 * 4 * n, sizeof(*ref));
+    if (!buf || !ref)
+        exit(1);
+    float *m1 = buf + 1;
+    float *m2 = m1 + 4 * 4 * n;
+    float *out = m2 + 4 * 4 * n;
+    uint32_t state = 0x12345;
+    fill_random(m1, 4 * 4 * n, &state);
+    fill_random(m2, 4 * 4 * n, &state);
+
+    printf(":: Testing mat4 mul batch\n");
+    ngli_mat4_mul_batch_c(ref, m1, m2, n);
+    ngli_mat4_mul_batch(out, m1, m2, n);
+    flt_diff(out, ref, out, 4 * 4 * n);
+    flt_check(out, 4 * 4 * n);
+
+    printf(":: Testing mat4 mul batch in place\n");
+    memcpy(out, m1, 4 * 4 * n * sizeof(*out));
+    ngli_mat4_mul_batch(out, out, m2, n);
+    flt_diff(out, ref, out, 4 * 4 * n);
+    flt_check(out, 4 * 4 * n);
+
+    printf(":: Testing mat4 mul vec4 batch\n");
+    ngli_mat4_mul_vec4_batch_c(ref, m1, m2, n);
+    ngli_mat4_mul_vec4_batch(out, m1, m2, n);
+    flt_diff(out, ref, out, 4 * n);
+    flt_check(out, 4 * n);
+
+    free(ref);
+    free(buf);
+}
+
+static double get_ns_per_op(clock_t start, size_t nb_ops)
+{
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (double)nb_ops;
+}
+
+#define BENCH(name, nb_ops, code) do {                      \
+    const clock_t start = clock();                          \
+    for (size_t k = 0; k < nb_runs; k++) {                  \
+        code;                                               \
+    }                                                       \
+    printf("%-24s %8.2f ns/op\n", name,                     \
+           get_ns_per_op(start, (nb_ops) * nb_runs));       \
+} while (0)
+
+static void run_benchmarks(void)
+{
+    const size_t n = BATCH_SIZE;
+    const size_t nb_runs = 200;
+    float *m1  = calloc(4 * 4 * n, sizeof(*m1));
+    float *m2  = calloc(4 * 4 * n, sizeof(*m2));
+    float *out = calloc(4 * 4 * n, sizeof(*out));
+    if (!m1 || !m2 || !out)
+        exit(1);
+    uint32_t state = 0x6789;
+    fill_random(m1, 4 * 4 * n, &state);
+    fill_random(m2, 4 * 4 * n, &state);
+
+    printf(":: Benchmarks (%zu elements)\n", n);
+    BENCH("mat4_mul_c",            n, for (size_t i = 0; i < n; i++) ngli_mat4_mul_c(out + i * 16, m1 + i * 16, m2 + i * 16));
+    BENCH("mat4_mul",              n, for (size_t i = 0; i < n; i++) ngli_mat4_mul(out + i * 16, m1 + i * 16, m2 + i * 16));
+    BENCH("mat4_mul_batch_c",      n, ngli_mat4_mul_batch_c(out, m1, m2, n));
+    BENCH("mat4_mul_batch",        n, ngli_mat4_mul_batch(out, m1, m2, n));
+    BENCH("mat4_mul_vec4_c",       n, for (size_t i = 0; i < n; i++) ngli_mat4_mul_vec4_c(out + i * 4, m1 + i * 16, m2 + i * 4));
+    BENCH("mat4_mul_vec4",         n, for (size_t i = 0; i < n; i++) ngli_mat4_mul_vec4(out + i * 4, m1 + i * 16, m2 + i * 4));
+    BENCH("mat4_mul_vec4_batch_c", n, ngli_mat4_mul_vec4_batch_c(out, m1, m2, n));
+    BENCH("mat4_mul_vec4_batch",   n, ngli_mat4_mul_vec4_batch(out, m1, m2, n));
+
+    free(m1);
+    free(m2);
+    free(out);
+}
+
+int main(int ac, char **av)
 {
     static const NGLI_ALIGNED_MAT(m1) = {
         0.73016f,  0.51184f, 0.20930f, -7.42311f,
@@ -95,5 +186,11 @@ int main(void)
         flt_check(v_diff, 4);
     }
 
+    check_batches();
+
+    /* Benchmarks are opt-in so that the test suite only checks correctness */
+    if (ac > 1 && !strcmp(av[1], "bench"))
+        run_benchmarks();
+
     return 0;
 }
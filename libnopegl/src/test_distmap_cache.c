@@ -0,0 +1,120 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "distmap_cache.h"
+#include "ngpu/texture.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
+
+#define NB_SHAPES 12
+
+static int nb_freed_textures;
+
+static void free_texture(struct ngpu_texture **sp)
+{
+    nb_freed_textures++;
+    ngli_freep(sp);
+}
+
+/* The cache only references and releases the textures, no GPU is involved */
+void ngpu_texture_freep(struct ngpu_texture **sp)
+{
+    NGLI_RC_UNREFP(sp);
+}
+
+static int get_textures(struct distmap_cache *s, char contents[][16], struct ngpu_texture **textures)
+{
+    int nb_hits = 0;
+    for (size_t i = 0; i < NB_SHAPES; i++) {
+        textures[i] = ngli_distmap_cache_get(s, (const uint8_t *)contents[i], sizeof(contents[i]));
+        nb_hits += textures[i] != NULL;
+    }
+    return nb_hits;
+}
+
+static void release_textures(struct distmap_cache *s, struct ngpu_texture **textures)
+{
+    for (size_t i = 0; i < NB_SHAPES; i++)
+        ngli_distmap_cache_release(s, &textures[i]);
+}
+
+int main(void)
+{
+    int ret = EXIT_FAILURE;
+    char contents[NB_SHAPES][16] = {0};
+    struct ngpu_texture *textures[NB_SHAPES] = {0};
+
+    struct distmap_cache *s = ngli_distmap_cache_create();
+    if (!s)
+        return EXIT_FAILURE;
+
+    for (size_t i = 0; i < NB_SHAPES; i++) {
+        snprintf(contents[i], sizeof(contents[i]), "shape %zu", i);
+        textures[i] = ngli_calloc(1, sizeof(*textures[i]));
+        if (!textures[i])
+            goto end;
+        textures[i]->rc = NGLI_RC_CREATE(free_texture);
+        if (ngli_distmap_cache_set(s, (const uint8_t *)contents[i], sizeof(contents[i]), textures[i]) < 0)
+            goto end;
+    }
+
+    /* Scene reload: everything released by the previous scene can be reused */
+    ngli_distmap_cache_hold(s);
+    release_textures(s, textures);
+    int nb_hits = get_textures(s, contents, textures);
+    printf("hits after reload: %d/%d\n", nb_hits, NB_SHAPES);
+    if (nb_hits != NB_SHAPES || ngli_distmap_cache_purge(s) < 0 || nb_freed_textures) {
+        fprintf(stderr, "distance maps were not kept across the reload\n");
+        goto end;
+    }
+
+    /* Outside of a reload, only the most recently released entries are kept */
+    release_textures(s, textures);
+    nb_hits = get_textures(s, contents, textures);
+    printf("hits after release: %d/%d\n", nb_hits, NB_SHAPES);
+    if (nb_hits != 8 || nb_freed_textures != NB_SHAPES - 8) {
+        fprintf(stderr, "unexpected number of released entries kept\n");
+        goto end;
+    }
+    for (size_t i = 0; i < NB_SHAPES - 8; i++) {
+        if (textures[i]) {
+            fprintf(stderr, "least recently released entries were not dropped first\n");
+            goto end;
+        }
+    }
+
+    /* Purging drops all the unused entries */
+    release_textures(s, textures);
+    if (ngli_distmap_cache_purge(s) < 0 || nb_freed_textures != NB_SHAPES) {
+        fprintf(stderr, "unused entries were not purged\n");
+        goto end;
+    }
+
+    ret = EXIT_SUCCESS;
+
+end:
+    release_textures(s, textures);
+    ngli_distmap_cache_freep(&s);
+    return ret;
+}
@@ -98,6 +98,7 @@ static int run_test(void)
             return EXIT_FAILURE;
 
         const size_t nb_values = NGLI_ARRAY_NB(test->expected_values);
+        float times[NGLI_ARRAY_NB(test->expected_values)];
         for (size_t i = 0; i < nb_values; i++) {
             const float t = (float)i / 10.f;
             const float gv = ngli_noise_get(&noise, t);
@@ -106,6 +107,38 @@ static int run_test(void)
                 fprintf(stderr, "noise(%f)=%g but expected %g [err:%g]\n", t, gv, ev, fabs(gv - ev));
                 ret = EXIT_FAILURE;
             }
+            times[i] = t;
+        }
+
+        /* The batch evaluation must match the individual samples exactly */
+        float values[NGLI_ARRAY_NB(test->expected_values)];
+        ngli_noise_get_batch(&noise, values, times, NULL, nb_values);
+        for (size_t i = 0; i < nb_values; i++) {
+            const float gv = ngli_noise_get(&noise, times[i]);
+            if (values[i] != gv) {
+                fprintf(stderr, "batch noise(%f)=%g but expected %g\n", times[i], values[i], gv);
+                ret = EXIT_FAILURE;
+            }
+        }
+
+        /* Same time with a different seed per sample */
+        uint32_t seeds[NGLI_ARRAY_NB(test->expected_values)];
+        for (size_t i = 0; i < nb_values; i++) {
+            seeds[i] = np->seed + (uint32_t)i * 0x9e3779b9;
+            times[i] = 1.37f;
+        }
+        ngli_noise_get_batch(&noise, values, times, seeds, nb_values);
+        for (size_t i = 0; i < nb_values; i++) {
+            struct noise_params seeded_np = *np;
+            seeded_np.seed = seeds[i];
+            struct noise seeded_noise;
+            if (ngli_noise_init(&seeded_noise, &seeded_np) < 0)
+                return EXIT_FAILURE;
+            const float gv = ngli_noise_get(&seeded_noise, times[i]);
+            if (values[i] != gv) {
+                fprintf(stderr, "batch noise(%f) with seed 0x%08x=%g but expected %g\n", times[i], seeds[i], values[i], gv);
+                ret = EXIT_FAILURE;
+            }
         }
     }
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/memory.h"
+#include "utils/utils.h"
+#include "vcache.h"
+
+#define GRID_SIZE 64
+
+/*
+ * Regular grid of 2 triangles per cell, emitted in a shuffled order which is
+ * the worst case for the post-transform vertex cache.
+ */
+static uint32_t *gen_grid(size_t *nb_indicesp, size_t *nb_verticesp)
+{
+    const size_t nb_cells = (GRID_SIZE - 1) * (GRID_SIZE - 1);
+    const size_t nb_triangles = nb_cells * 2;
+    uint32_t *indices = ngli_calloc(nb_triangles * 3, sizeof(*indices));
+    if (!indices)
+        return NULL;
+
+    uint32_t *dst = indices;
+    for (uint32_t y = 0; y < GRID_SIZE - 1; y++) {
+        for (uint32_t x = 0; x < GRID_SIZE - 1; x++) {
+            const uint32_t i0 = y * GRID_SIZE + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + GRID_SIZE;
+            const uint32_t i3 = i2 + 1;
+            const uint32_t tris[] = {i0, i2, i1, i1, i2, i3};
+            memcpy(dst, tris, sizeof(tris));
+            dst += NGLI_ARRAY_NB(tris);
+        }
+    }
+
+    /* Deterministic Fisher-Yates shuffle of the triangles */
+    uint32_t state = 0x7e3a2b91;
+    for (size_t i = nb_triangles - 1; i > 0; i--) {
+        state = state * 1664525 + 1013904223;
+        const size_t j = state % (i + 1);
+        uint32_t tmp[3];
+        memcpy(tmp, indices + i * 3, sizeof(tmp));
+        memcpy(indices + i * 3, indices + j * 3, sizeof(tmp));
+        memcpy(indices + j * 3, tmp, sizeof(tmp));
+    }
+
+    *nb_indicesp = nb_triangles * 3;
+    *nb_verticesp = GRID_SIZE * GRID_SIZE;
+    return indices;
+}
+
+static int cmp_triangle(const void *a, const void *b)
+{
+    return memcmp(a, b, 3 * sizeof(uint32_t));
+}
+
+int main(void)
+{
+    int ret = EXIT_FAILURE;
+    uint32_t *optimized = NULL;
+    size_t nb_indices, nb_vertices;
+    uint32_t *indices = gen_grid(&nb_indices, &nb_vertices);
+    if (!indices)
+        return EXIT_FAILURE;
+
+    optimized = ngli_calloc(nb_indices, sizeof(*optimized));
+    if (!optimized)
+        goto end;
+
+    if (ngli_vcache_optimize(optimized, indices, nb_indices, nb_vertices) < 0)
+        goto end;
+
+    const float acmr_ref = ngli_vcache_get_acmr(indices, nb_indices, nb_vertices, NGLI_VCACHE_SIZE);
+    const float acmr_opt = ngli_vcache_get_acmr(optimized, nb_indices, nb_vertices, NGLI_VCACHE_SIZE);
+    printf("ACMR: %f -> %f\n", acmr_ref, acmr_opt);
+    if (acmr_opt > 0.8f || acmr_opt >= acmr_ref) {
+        fprintf(stderr, "unexpected ACMR after optimization\n");
+        goto end;
+    }
+
+    /* The optimized triangles must be the same as the original ones */
+    qsort(indices, nb_indices / 3, 3 * sizeof(*indices), cmp_triangle);
+    qsort(optimized, nb_indices / 3, 3 * sizeof(*optimized), cmp_triangle);
+    if (memcmp(indices, optimized, nb_indices * sizeof(*indices))) {
+        fprintf(stderr, "optimized triangles do not match the original ones\n");
+        goto end;
+    }
+
+    /* Out of range indices must be rejected */
+    const uint32_t invalid[] = {0, 1, 3};
+    uint32_t out[NGLI_ARRAY_NB(invalid)];
+    if (ngli_vcache_optimize(out, invalid, NGLI_ARRAY_NB(invalid), 3) >= 0) {
+        fprintf(stderr, "out of range indices were not rejected\n");
+        goto end;
+    }
+
+    ret = EXIT_SUCCESS;
+
+end:
+    ngli_free(optimized);
+    ngli_free(indices);
+    return ret;
+}
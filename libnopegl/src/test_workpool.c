@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+
+#include "utils/atomic.h"
+#include "utils/utils.h"
+#include "utils/workpool.h"
+
+#define NB_JOBS 64
+
+static int64_t counter;
+
+static int job_func(void *arg)
+{
+    const int *value = arg;
+    ngli_atomic_inc64(&counter);
+    return *value;
+}
+
+static void test_wait(size_t nb_threads)
+{
+    struct workpool *s = ngli_workpool_create(nb_threads);
+    ngli_assert(s);
+
+    counter = 0;
+
+    int values[NB_JOBS];
+    struct workpool_job *jobs[NB_JOBS];
+    for (int i = 0; i < NB_JOBS; i++) {
+        values[i] = i;
+        jobs[i] = ngli_workpool_submit(s, job_func, &values[i]);
+        ngli_assert(jobs[i]);
+    }
+
+    for (int i = 0; i < NB_JOBS; i++) {
+        const int ret = ngli_workpool_wait(s, &jobs[i]);
+        ngli_assert(ret == i);
+        ngli_assert(!jobs[i]);
+    }
+    ngli_assert(ngli_atomic_load64(&counter) == NB_JOBS);
+
+    ngli_workpool_freep(&s);
+    ngli_assert(!s);
+}
+
+static void test_cancel(void)
+{
+    struct workpool *s = ngli_workpool_create(1);
+    ngli_assert(s);
+
+    counter = 0;
+
+    int value = 0;
+    struct workpool_job *jobs[NB_JOBS];
+    for (int i = 0; i < NB_JOBS; i++) {
+        jobs[i] = ngli_workpool_submit(s, job_func, &value);
+        ngli_assert(jobs[i]);
+    }
+
+    int nb_executed = 0;
+    for (int i = NB_JOBS - 1; i >= 0; i--)
+        nb_executed += ngli_workpool_cancel(s, &jobs[i]);
+
+    /* The cancelled jobs must not have been executed */
+    ngli_assert(ngli_atomic_load64(&counter) == nb_executed);
+
+    ngli_workpool_freep(&s);
+}
+
+int main(void)
+{
+    test_wait(1);
+    test_wait(4);
+    test_cancel();
+    return 0;
+}
@@ -317,54 +317,100 @@ static int set_vec3_value(float *dst, struct ngl_node *node, const float *value,
     return 0;
 }
 
-static int set_transform(float *dst, const struct texteffect_opts *effect_opts,
-                         struct ngli_box box, struct ngli_box chr_box,
-                         const struct char_info *chr, double t)
+static void get_anchor(float *anchor, const struct texteffect_opts *effect_opts,
+                       struct ngli_box box, struct ngli_box chr_box, const struct char_info *chr)
 {
-    struct ngl_node *node = effect_opts->transform_chain;
-
-    if (!node)
-        return 0;
-    int ret = ngli_node_update(node, t);
-    if (ret < 0)
-        return ret;
-
-    float anchor_x, anchor_y;
     if (effect_opts->anchor_ref == NGLI_TEXT_ANCHOR_REF_CHAR) {
         /*
          * Go to the the center of the character quad, then adjust to honor the
          * anchor parameter according to the real dimension of the character
          */
-        anchor_x = chr_box.x + chr_box.w / 2.f + effect_opts->anchor[0] * chr->real_dim[0] / 2.f;
-        anchor_y = chr_box.y + chr_box.h / 2.f + effect_opts->anchor[1] * chr->real_dim[1] / 2.f;
+        anchor[0] = chr_box.x + chr_box.w / 2.f + effect_opts->anchor[0] * chr->real_dim[0] / 2.f;
+        anchor[1] = chr_box.y + chr_box.h / 2.f + effect_opts->anchor[1] * chr->real_dim[1] / 2.f;
     } else if (effect_opts->anchor_ref == NGLI_TEXT_ANCHOR_REF_BOX) {
         /* Remap an anchor in [-1,1] to the text bounding box coordinates */
         const float norm_x = NGLI_LINEAR_NORM(-1.f, 1.f, effect_opts->anchor[0]);
         const float norm_y = NGLI_LINEAR_NORM(-1.f, 1.f, effect_opts->anchor[1]);
-        anchor_x = NGLI_MIX_F32(box.x, box.x + box.w, norm_x);
-        anchor_y = NGLI_MIX_F32(box.y, box.y + box.h, norm_y);
+        anchor[0] = NGLI_MIX_F32(box.x, box.x + box.w, norm_x);
+        anchor[1] = NGLI_MIX_F32(box.y, box.y + box.h, norm_y);
     } else if (effect_opts->anchor_ref == NGLI_TEXT_ANCHOR_REF_VIEWPORT) {
-        anchor_x = effect_opts->anchor[0];
-        anchor_y = effect_opts->anchor[1];
+        anchor[0] = effect_opts->anchor[0];
+        anchor[1] = effect_opts->anchor[1];
     } else {
         ngli_assert(0);
     }
+}
 
-    NGLI_ALIGNED_MAT(tm);
-    NGLI_ALIGNED_MAT(tmreloc0);
-    NGLI_ALIGNED_MAT(tmreloc1);
+/*
+ * Compute translate(anchor) * m * translate(-anchor) without the two matrix
+ * products: the translation column is moved to the anchor, then every column
+ * is offset according to its w component.
+ */
+static void relocate_transform(float *dst, const float *m, const float *anchor)
+{
+    memcpy(dst, m, 4 * 4 * sizeof(*dst));
+    for (size_t i = 0; i < 4; i++)
+        dst[12 + i] -= m[i] * anchor[0] + m[4 + i] * anchor[1];
+    for (size_t j = 0; j < 4; j++) {
+        dst[j * 4 + 0] += anchor[0] * dst[j * 4 + 3];
+        dst[j * 4 + 1] += anchor[1] * dst[j * 4 + 3];
+    }
+}
 
-    ngli_transform_chain_compute(node, tm);
-    ngli_mat4_translate(tmreloc0,  anchor_x,  anchor_y, 0.f);
-    ngli_mat4_translate(tmreloc1, -anchor_x, -anchor_y, 0.f);
+enum {
+    VALUE_TRANSFORM     = 1 << 0,
+    VALUE_COLOR         = 1 << 1,
+    VALUE_OPACITY       = 1 << 2,
+    VALUE_OUTLINE_COLOR = 1 << 3,
+    VALUE_OUTLINE       = 1 << 4,
+    VALUE_GLOW_COLOR    = 1 << 5,
+    VALUE_GLOW          = 1 << 6,
+    VALUE_BLUR          = 1 << 7,
+    VALUE_OUTLINE_POS   = 1 << 8,
+};
 
-    NGLI_ALIGNED_MAT(tmp);
-    memcpy(tmp, dst, sizeof(tm));      // start from the existing position
-    ngli_mat4_mul(tmp, tmp, tmreloc0); // go to anchor
-    ngli_mat4_mul(tmp, tmp, tm);       // apply user transform matrix
-    ngli_mat4_mul(tmp, tmp, tmreloc1); // go back from anchor
+/* Values set by an effect, a negative constant meaning the value is not set */
+static uint32_t get_values_mask(const struct texteffect_opts *o)
+{
+    uint32_t mask = 0;
+    if (o->transform_chain)                             mask |= VALUE_TRANSFORM;
+    if (o->color_node         || o->color[0] >= 0.f)         mask |= VALUE_COLOR;
+    if (o->opacity_node       || o->opacity >= 0.f)          mask |= VALUE_OPACITY;
+    if (o->outline_color_node || o->outline_color[0] >= 0.f) mask |= VALUE_OUTLINE_COLOR;
+    if (o->outline_node       || o->outline >= 0.f)          mask |= VALUE_OUTLINE;
+    if (o->glow_color_node    || o->glow_color[0] >= 0.f)    mask |= VALUE_GLOW_COLOR;
+    if (o->glow_node          || o->glow >= 0.f)             mask |= VALUE_GLOW;
+    if (o->blur_node          || o->blur >= 0.f)             mask |= VALUE_BLUR;
+    if (o->outline_pos_node   || o->outline_pos >= 0.f)      mask |= VALUE_OUTLINE_POS;
+    return mask;
+}
+
+static int eval_segment(struct segment_values *v, const struct texteffect_opts *o,
+                        const float *anchor, double t)
+{
+    int ret;
+
+    if (o->transform_chain) {
+        ret = ngli_node_update(o->transform_chain, t);
+        if (ret < 0)
+            return ret;
+        NGLI_ALIGNED_MAT(tm);
+        ngli_transform_chain_compute(o->transform_chain, tm);
+        if (anchor)
+            relocate_transform(v->transform, tm, anchor);
+        else
+            memcpy(v->transform, tm, sizeof(tm));
+    }
 
-    memcpy(dst, tmp, sizeof(tmp));
+    if ((ret = set_vec3_value(v->color,       o->color_node,         o->color,         t)) < 0 ||
+        (ret = set_f32_value( v->color + 3,   o->opacity_node,       o->opacity,       t)) < 0 ||
+        (ret = set_vec3_value(v->outline,     o->outline_color_node, o->outline_color, t)) < 0 ||
+        (ret = set_f32_value( v->outline + 3, o->outline_node,       o->outline,       t)) < 0 ||
+        (ret = set_vec3_value(v->glow,        o->glow_color_node,    o->glow_color,    t)) < 0 ||
+        (ret = set_f32_value( v->glow + 3,    o->glow_node,          o->glow,          t)) < 0 ||
+        (ret = set_f32_value(&v->blur,        o->blur_node,          o->blur,          t)) < 0 ||
+        (ret = set_f32_value(&v->outline_pos, o->outline_pos_node,   o->outline_pos,   t)) < 0)
+        return ret;
 
     return 0;
 }
@@ -460,6 +506,14 @@ static void shuffle(uint64_t *rng_state, size_t *positions, size_t n)
 
 static int build_effects_segmentation(struct text *s)
 {
+    if (s->config.nb_effect_nodes) {
+        const size_t nb_chars = ngli_darray_count(&s->chars);
+        float *new_transforms = ngli_realloc(s->effect_transforms, nb_chars, 4 * 4 * sizeof(*new_transforms));
+        if (!new_transforms)
+            return NGL_ERROR_MEMORY;
+        s->effect_transforms = new_transforms;
+    }
+
     for (size_t i = 0; i < s->config.nb_effect_nodes; i++) {
         struct ngl_node *effect_node = s->config.effect_nodes[i];
         const struct texteffect_opts *effect_opts = effect_node->opts;
@@ -493,6 +547,11 @@ static int build_effects_segmentation(struct text *s)
             return NGL_ERROR_BUG;
         }
 
+        struct segment_values *new_values = ngli_realloc(effect->values, effect->total_segments, sizeof(*new_values));
+        if (!new_values)
+            return NGL_ERROR_MEMORY;
+        effect->values = new_values;
+
         if (effect_opts->random) {
             /* Build a shuffle map associating a position with another one */
             size_t *shuffle_map = ngli_calloc(effect->total_segments, sizeof(*shuffle_map));
@@ -521,12 +580,17 @@ static void destroy_effects_data(struct text *s)
     /*
      * text.effects is not destroyed since its size depends on the number of
      * effects (which doesn't change). On the other hand, effects[i].positions
-     * depends on the number of characters, so we're freeing them here.
+     * and effects[i].values depend on the number of characters, so we're
+     * freeing them here.
      */
-    if (s->effects)
-        for (size_t i = 0; i < s->config.nb_effect_nodes; i++)
+    if (s->effects) {
+        for (size_t i = 0; i < s->config.nb_effect_nodes; i++) {
             ngli_freep(&s->effects[i].positions);
+            ngli_freep(&s->effects[i].values);
+        }
+    }
 
+    ngli_freep(&s->effect_transforms);
     ngli_freep(&s->chars_data_default);
     s->chars_data = NULL; // allocation is shared with chars_data_default
     s->chars_data_size = 0;
@@ -699,6 +763,7 @@ int ngli_text_set_time(struct text *s, double t)
 
     reset_chars_data_to_defaults(s);
 
+    int has_transform = 0;
     for (size_t i = 0; i < s->config.nb_effect_nodes; i++) {
         struct ngl_node *effect_node = s->config.effect_nodes[i];
         const struct texteffect_opts *effect_opts = effect_node->opts;
@@ -719,21 +784,35 @@ int ngli_text_set_time(struct text *s, double t)
             return ret;
 
         const struct effect_segmentation *effect = &s->effects[i];
+        const uint32_t mask = get_values_mask(effect_opts);
 
         const size_t nb_elems = effect->total_segments;
         const double duration  = 1.f / ((double)nb_elems - overlap * (double)(nb_elems - 1));
         const double timescale = (1.f - overlap) * duration;
 
-        /* Apply effect on the selected range of characters */
-        const struct char_info *chars = ngli_darray_data(&s->chars);
-        for (size_t c = 0; c < ngli_darray_count(&s->chars); c++) {
-            const size_t pos = effect->positions[c];
+        /*
+         * The anchor only depends on the character with a character anchor
+         * reference, otherwise it is baked into the transform of the segments
+         */
+        const int char_anchor = effect_opts->anchor_ref == NGLI_TEXT_ANCHOR_REF_CHAR;
+        float anchor[2] = {0};
+        if (!char_anchor)
+            get_anchor(anchor, effect_opts, s->config.box, (struct ngli_box){0}, NULL);
+
+        /*
+         * The target time only depends on the position of the segment, so
+         * the effect values are evaluated once per segment instead of once
+         * per character (words and lines typically gather many characters)
+         */
+        for (size_t pos = 0; pos < nb_elems; pos++) {
+            struct segment_values *v = &effect->values[pos];
 
             /* Recenter the position in the middle of the character (similar to texture sampling) */
             const float pos_f = ((float)pos + 0.5f) / (float)nb_elems;
 
             /* Spacially filter out characters that do not land into the user specified range */
-            if (pos_f < start_pos || pos_f > end_pos)
+            v->in_range = pos_f >= start_pos && pos_f <= end_pos;
+            if (!v->in_range)
                 continue;
 
             /* Interpolate the time of the target, taking into account the overlap */
@@ -741,20 +820,58 @@ int ngli_text_set_time(struct text *s, double t)
             const double next_t = prev_t + duration;
             const double target_t = NGLI_LINEAR_NORM(prev_t, next_t, effect_t);
 
-            const struct ngli_box chr_box = {NGLI_ARG_VEC4(s->data_ptrs.pos_size + c * 4)};
-            const struct char_info *chr = &chars[i];
-
-            if ((ret = set_transform( s->data_ptrs.transform  + c * 4 * 4, effect_opts, s->config.box, chr_box, chr,                     target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.color      + c * 4,     effect_opts->color_node,         effect_opts->color,         target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.color      + c * 4 + 3, effect_opts->opacity_node,       effect_opts->opacity,       target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.outline    + c * 4,     effect_opts->outline_color_node, effect_opts->outline_color, target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.outline    + c * 4 + 3, effect_opts->outline_node,       effect_opts->outline,       target_t)) < 0 ||
-                (ret = set_vec3_value(s->data_ptrs.glow       + c * 4,     effect_opts->glow_color_node,    effect_opts->glow_color,    target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.glow       + c * 4 + 3, effect_opts->glow_node,          effect_opts->glow,          target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.blur       + c,         effect_opts->blur_node,          effect_opts->blur,          target_t)) < 0 ||
-                (ret = set_f32_value( s->data_ptrs.outline_pos + c,        effect_opts->outline_pos_node,   effect_opts->outline_pos,   target_t)) < 0)
+            ret = eval_segment(v, effect_opts, char_anchor ? NULL : anchor, target_t);
+            if (ret < 0)
                 return ret;
         }
+
+        /*
+         * Apply effect on the selected range of characters. The transforms
+         * are gathered (identity for the characters out of range) to be
+         * combined with the existing ones all at once.
+         */
+        const size_t nb_chars = ngli_darray_count(&s->chars);
+        const struct char_info *chars = ngli_darray_data(&s->chars);
+        for (size_t c = 0; c < nb_chars; c++) {
+            const struct segment_values *v = &effect->values[effect->positions[c]];
+
+            if (mask & VALUE_TRANSFORM) {
+                float *tm = s->effect_transforms + c * 4 * 4;
+                if (!v->in_range) {
+                    static const float id_matrix[] = NGLI_MAT4_IDENTITY;
+                    memcpy(tm, id_matrix, sizeof(id_matrix));
+                } else if (char_anchor) {
+                    const struct ngli_box chr_box = {NGLI_ARG_VEC4(s->data_ptrs.pos_size + c * 4)};
+                    const struct char_info *chr = &chars[i];
+                    get_anchor(anchor, effect_opts, s->config.box, chr_box, chr);
+                    relocate_transform(tm, v->transform, anchor);
+                } else {
+                    memcpy(tm, v->transform, 4 * 4 * sizeof(*tm));
+                }
+            }
+
+            if (!v->in_range)
+                continue;
+
+            if (mask & VALUE_COLOR)         memcpy(s->data_ptrs.color + c * 4,   v->color,   3 * sizeof(*v->color));
+            if (mask & VALUE_OPACITY)       s->data_ptrs.color[c * 4 + 3] = v->color[3];
+            if (mask & VALUE_OUTLINE_COLOR) memcpy(s->data_ptrs.outline + c * 4, v->outline, 3 * sizeof(*v->outline));
+            if (mask & VALUE_OUTLINE)       s->data_ptrs.outline[c * 4 + 3] = v->outline[3];
+            if (mask & VALUE_GLOW_COLOR)    memcpy(s->data_ptrs.glow + c * 4,    v->glow,    3 * sizeof(*v->glow));
+            if (mask & VALUE_GLOW)          s->data_ptrs.glow[c * 4 + 3] = v->glow[3];
+            if (mask & VALUE_BLUR)          s->data_ptrs.blur[c] = v->blur;
+            if (mask & VALUE_OUTLINE_POS)   s->data_ptrs.outline_pos[c] = v->outline_pos;
+        }
+
+        /* Start from the existing transforms, unless no effect changed them yet */
+        if (mask & VALUE_TRANSFORM) {
+            if (has_transform)
+                ngli_mat4_mul_batch(s->data_ptrs.transform, s->data_ptrs.transform, s->effect_transforms, nb_chars);
+            else
+                memcpy(s->data_ptrs.transform, s->effect_transforms, nb_chars * 4 * 4 * sizeof(*s->effect_transforms));
+        }
+
+        has_transform |= !!(mask & VALUE_TRANSFORM);
     }
 
     return 0;
@@ -130,9 +130,21 @@ struct text_data_pointers {
     float *blur;      // f32[]
 };
 
+/* Effect values evaluated once per segment and shared by all its characters */
+struct segment_values {
+    float transform[4 * 4]; // user transform, already relocated to the anchor if it doesn't depend on the character
+    float color[4];
+    float outline[4];
+    float glow[4];
+    float blur;
+    float outline_pos;
+    int in_range;
+};
+
 struct effect_segmentation {
     size_t *positions;     // character index (in chars darray) to position in "target unit" (char, word, ...)
     size_t total_segments; // total number of segment: all values in positions are between [0,total_segments-1]
+    struct segment_values *values; // total_segments entries
 };
 
 struct text {
@@ -152,6 +164,7 @@ struct text {
     float *chars_data;         // data buffer exposed to the user (through data pointers)
     size_t chars_data_size;    // size of chars_data_default and chars_data
     size_t chars_copy_size;    // actual size needed for copy
+    float *effect_transforms;  // per character transforms of the effect being applied
 
     struct darray chars_internal; // struct char_info_internal
 
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "internal.h"
+#include "ngpu/ctx.h"
+#include "texture_pool.h"
+#include "utils/darray.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
+
+/* Number of frames a recycled texture is kept available before being destroyed */
+#define MAX_IDLE_FRAMES 4
+
+/* Maximum number of recycled textures kept by the pool, the oldest are destroyed first */
+#define MAX_ENTRIES 16
+
+/* Maximum amount of memory held by the recycled textures, the oldest are destroyed first */
+#define MAX_MEMORY (256 << 20)
+
+/* Smallest dimension of a bucket */
+#define MIN_BUCKET_SIZE 64
+
+struct entry {
+    struct ngpu_texture_params params;
+    struct ngpu_texture *texture;
+    uint64_t frame;
+};
+
+struct texture_pool {
+    struct ngl_ctx *ctx;
+    struct darray entries; /* struct entry, from the oldest to the most recently recycled */
+    size_t memory;
+    uint64_t frame;
+};
+
+static void reset_entry(void *user_arg, void *data)
+{
+    struct texture_pool *s = user_arg;
+    struct entry *entry = data;
+    if (entry->texture)
+        s->memory -= entry->texture->memory_size;
+    ngpu_texture_freep(&entry->texture);
+}
+
+struct texture_pool *ngli_texture_pool_create(struct ngl_ctx *ctx)
+{
+    struct texture_pool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    ngli_darray_init(&s->entries, sizeof(struct entry), 0);
+    ngli_darray_set_free_func(&s->entries, reset_entry, s);
+    return s;
+}
+
+void ngli_texture_pool_begin_frame(struct texture_pool *s)
+{
+    s->frame++;
+
+    /* Entries are sorted by recycling time, so the expired ones come first */
+    size_t nb_expired = 0;
+    const struct entry *entries = ngli_darray_data(&s->entries);
+    while (nb_expired < ngli_darray_count(&s->entries) && s->frame - entries[nb_expired].frame > MAX_IDLE_FRAMES)
+        nb_expired++;
+    ngli_darray_remove_range(&s->entries, 0, nb_expired);
+}
+
+/*
+ * Round a dimension up to a multiple of a quarter of the power of two below
+ * it, so that a bucket never wastes more than 25% of the requested size.
+ */
+static int32_t get_bucket_size(int32_t size, int32_t max_size)
+{
+    int32_t bucket_size = MIN_BUCKET_SIZE;
+    if (size > MIN_BUCKET_SIZE) {
+        int32_t pot = MIN_BUCKET_SIZE;
+        while (pot * 2 < size)
+            pot <<= 1;
+        bucket_size = NGLI_ALIGN(size, pot / 4);
+    }
+    return NGLI_MAX(NGLI_MIN(bucket_size, max_size), size);
+}
+
+/*
+ * Only the top-left area of a bucketed texture is meaningful, which restricts
+ * bucketing to 2D textures without mipmaps and never sampled past their edges.
+ */
+static int can_use_bucket(const struct ngpu_texture_params *params)
+{
+    if (params->type != NGPU_TEXTURE_TYPE_2D || params->mipmap_filter != NGPU_MIPMAP_FILTER_NONE)
+        return 0;
+    if (!(params->usage & NGPU_TEXTURE_USAGE_SAMPLED_BIT))
+        return 1;
+    return params->wrap_s == NGPU_WRAP_CLAMP_TO_EDGE && params->wrap_t == NGPU_WRAP_CLAMP_TO_EDGE;
+}
+
+/*
+ * The backends store the texture parameters as requested, except for the depth
+ * which is set to 1 for non 3D textures.
+ */
+static struct ngpu_texture_params get_key(const struct texture_pool *s, const struct ngpu_texture_params *params,
+                                          int bucketed)
+{
+    struct ngpu_texture_params key = *params;
+    if (key.type != NGPU_TEXTURE_TYPE_3D)
+        key.depth = 1;
+    if (bucketed && can_use_bucket(params)) {
+        const int32_t max_size = (int32_t)s->ctx->gpu_ctx->limits.max_texture_dimension_2d;
+        key.width  = get_bucket_size(params->width, max_size);
+        key.height = get_bucket_size(params->height, max_size);
+    }
+    return key;
+}
+
+static int get_texture(struct texture_pool *s, const struct ngpu_texture_params *key,
+                       struct ngpu_texture **texturep)
+{
+    struct ngpu_ctx *gpu_ctx = s->ctx->gpu_ctx;
+
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        if (!memcmp(&entry->params, key, sizeof(*key))) {
+            *texturep = entry->texture;
+            s->memory -= entry->texture->memory_size;
+            entry->texture = NULL;
+            ngli_darray_remove(&s->entries, i);
+            return 0;
+        }
+    }
+
+    struct ngpu_texture *texture = ngpu_texture_create(gpu_ctx);
+    if (!texture)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngpu_texture_init(texture, key);
+    if (ret < 0) {
+        ngpu_texture_freep(&texture);
+        return ret;
+    }
+
+    *texturep = texture;
+    return 0;
+}
+
+int ngli_texture_pool_get(struct texture_pool *s, const struct ngpu_texture_params *params,
+                          struct ngpu_texture **texturep)
+{
+    const struct ngpu_texture_params key = get_key(s, params, 0);
+    return get_texture(s, &key, texturep);
+}
+
+int ngli_texture_pool_get_bucketed(struct texture_pool *s, const struct ngpu_texture_params *params,
+                                   struct ngpu_texture **texturep)
+{
+    const struct ngpu_texture_params key = get_key(s, params, 1);
+    return get_texture(s, &key, texturep);
+}
+
+int ngli_texture_pool_match_bucket(const struct texture_pool *s, const struct ngpu_texture *texture,
+                                   const struct ngpu_texture_params *params)
+{
+    const struct ngpu_texture_params key = get_key(s, params, 1);
+    const struct ngpu_texture_params texture_key = get_key(s, &texture->params, 0);
+    return !memcmp(&texture_key, &key, sizeof(key));
+}
+
+void ngli_texture_pool_recycle(struct texture_pool *s, struct ngpu_texture **texturep)
+{
+    struct ngpu_texture *texture = *texturep;
+    if (!texture)
+        return;
+
+    /*
+     * A texture still referenced elsewhere (bindings, render targets, or
+     * command buffers in flight) cannot be handed to another user: it is
+     * released instead, and destroyed along with its last reference.
+     * Conversely, a texture only referenced by its owner is not retained by
+     * any pending command buffer and can be reused right away.
+     */
+    if (!s || !NGLI_RC_IS_UNIQUE(texture)) {
+        ngpu_texture_freep(texturep);
+        return;
+    }
+
+    if (texture->memory_size > MAX_MEMORY) {
+        ngpu_texture_freep(texturep);
+        return;
+    }
+
+    while (ngli_darray_count(&s->entries) >= MAX_ENTRIES || s->memory + texture->memory_size > MAX_MEMORY)
+        ngli_darray_remove(&s->entries, 0);
+
+    const struct entry entry = {
+        .params  = get_key(s, &texture->params, 0),
+        .texture = texture,
+        .frame   = s->frame,
+    };
+    if (!ngli_darray_push(&s->entries, &entry)) {
+        ngpu_texture_freep(texturep);
+        return;
+    }
+    s->memory += texture->memory_size;
+    *texturep = NULL;
+}
+
+void ngli_texture_pool_freep(struct texture_pool **sp)
+{
+    struct texture_pool *s = *sp;
+    if (!s)
+        return;
+    ngli_darray_reset(&s->entries);
+    ngli_freep(sp);
+}
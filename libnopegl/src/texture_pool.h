@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef TEXTURE_POOL_H
+#define TEXTURE_POOL_H
+
+#include "ngpu/texture.h"
+
+struct ngl_ctx;
+struct texture_pool;
+
+/*
+ * Pool of recycled textures, shared by all the nodes of a rendering context.
+ *
+ * Textures that are reallocated on resize (render targets, blur destinations,
+ * depth and multisample attachments) are handed back to the pool instead of
+ * being destroyed, and are later reused for any request with identical
+ * parameters. Only the textures exclusively owned by the caller are kept:
+ * the others are simply released. Recycled textures are destroyed if they are
+ * not reused within a few frames, and the pool is bounded both in number of
+ * textures and in memory.
+ *
+ * Textures can be recycled into a NULL pool, in which case they are simply
+ * destroyed.
+ */
+
+struct texture_pool *ngli_texture_pool_create(struct ngl_ctx *ctx);
+
+/* Must be called once per frame */
+void ngli_texture_pool_begin_frame(struct texture_pool *s);
+
+int ngli_texture_pool_get(struct texture_pool *s, const struct ngpu_texture_params *params,
+                          struct ngpu_texture **texturep);
+
+/*
+ * Same as ngli_texture_pool_get() but the dimensions are rounded up to a size
+ * bucket, so that close sizes share the same textures. The caller is expected
+ * to only use the top-left area of the texture matching the requested
+ * dimensions. Textures with mipmaps or sampled with a wrapping other than
+ * clamp to edge are not bucketed.
+ */
+int ngli_texture_pool_get_bucketed(struct texture_pool *s, const struct ngpu_texture_params *params,
+                                   struct ngpu_texture **texturep);
+
+/*
+ * Check if a texture matches what ngli_texture_pool_get_bucketed() would
+ * return for the specified parameters, in which case it can be kept as is.
+ */
+int ngli_texture_pool_match_bucket(const struct texture_pool *s, const struct ngpu_texture *texture,
+                                   const struct ngpu_texture_params *params);
+
+void ngli_texture_pool_recycle(struct texture_pool *s, struct ngpu_texture **texturep);
+
+void ngli_texture_pool_freep(struct texture_pool **sp);
+
+#endif
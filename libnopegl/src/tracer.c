@@ -0,0 +1,166 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log.h"
+#include "nopegl.h"
+#include "tracer.h"
+#include "utils/bstr.h"
+#include "utils/memory.h"
+#include "utils/string.h"
+
+#define LABEL_LEN 48
+
+struct event {
+    int64_t ts;
+    int64_t dur;
+    const char *name; /* static string */
+    char label[LABEL_LEN];
+    enum ngli_tracer_track track;
+};
+
+struct tracer {
+    char *filename;
+    struct event *events;
+    uint64_t nb_events; /* total number of events recorded, including the overwritten ones */
+};
+
+static const char * const track_names[] = {
+    [NGLI_TRACER_TRACK_CPU] = "CPU",
+    [NGLI_TRACER_TRACK_GPU] = "GPU",
+};
+
+NGLI_STATIC_ASSERT((NGLI_TRACER_NB_EVENTS & (NGLI_TRACER_NB_EVENTS - 1)) == 0, "power of 2 ring size");
+
+struct tracer *ngli_tracer_create(const char *filename)
+{
+    struct tracer *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->filename = ngli_strdup(filename);
+    s->events = ngli_calloc(NGLI_TRACER_NB_EVENTS, sizeof(*s->events));
+    if (!s->filename || !s->events) {
+        ngli_tracer_freep(&s);
+        return NULL;
+    }
+
+    return s;
+}
+
+void ngli_tracer_add(struct tracer *s, enum ngli_tracer_track track,
+                     const char *name, const char *label, int64_t ts, int64_t dur)
+{
+    if (!s)
+        return;
+
+    struct event *event = &s->events[s->nb_events & (NGLI_TRACER_NB_EVENTS - 1)];
+    event->ts = ts;
+    event->dur = dur;
+    event->name = name;
+    event->track = track;
+    if (label)
+        snprintf(event->label, sizeof(event->label), "%s", label);
+    else
+        event->label[0] = 0;
+    s->nb_events++;
+}
+
+void ngli_tracer_end(struct tracer *s, const char *name, const char *label, int64_t start)
+{
+    if (!s)
+        return;
+    ngli_tracer_add(s, NGLI_TRACER_TRACK_CPU, name, label, start, ngli_gettime_relative() - start);
+}
+
+static void print_json_str(struct bstr *b, const char *s)
+{
+    ngli_bstr_print(b, "\"");
+    for (; *s; s++) {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            ngli_bstr_printf(b, "\\%c", c);
+        else if (c < 0x20)
+            ngli_bstr_printf(b, "\\u%04x", c);
+        else
+            ngli_bstr_printf(b, "%c", c);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
+int ngli_tracer_dump(struct tracer *s)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NGL_ERROR_MEMORY;
+
+    ngli_bstr_print(b, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < NGLI_ARRAY_NB(track_names); i++)
+        ngli_bstr_printf(b, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+                         "\"args\":{\"name\":\"%s\"}},\n", i + 1, track_names[i]);
+
+    const uint64_t start = s->nb_events > NGLI_TRACER_NB_EVENTS ? s->nb_events - NGLI_TRACER_NB_EVENTS : 0;
+    for (uint64_t i = start; i < s->nb_events; i++) {
+        const struct event *event = &s->events[i & (NGLI_TRACER_NB_EVENTS - 1)];
+        ngli_bstr_print(b, "{\"name\":");
+        print_json_str(b, event->label[0] ? event->label : event->name);
+        ngli_bstr_printf(b, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                         "\"ts\":%" PRId64 ",\"dur\":%" PRId64 "}%s\n",
+                         event->name, event->track + 1, event->ts, event->dur,
+                         i + 1 < s->nb_events ? "," : "");
+    }
+    ngli_bstr_print(b, "]}\n");
+
+    int ret = ngli_bstr_check(b);
+    if (ret < 0)
+        goto end;
+
+    FILE *fp = fopen(s->filename, "wb");
+    if (!fp) {
+        LOG(ERROR, "unable to open \"%s\" for writing", s->filename);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    const size_t len = ngli_bstr_len(b);
+    if (fwrite(ngli_bstr_strptr(b), 1, len, fp) != len) {
+        LOG(ERROR, "unable to write trace to \"%s\"", s->filename);
+        ret = NGL_ERROR_IO;
+    }
+    fclose(fp);
+
+end:
+    ngli_bstr_freep(&b);
+    return ret;
+}
+
+void ngli_tracer_freep(struct tracer **sp)
+{
+    struct tracer *s = *sp;
+    if (!s)
+        return;
+    ngli_freep(&s->filename);
+    ngli_freep(&s->events);
+    ngli_freep(sp);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <stdint.h>
+
+#include "utils/time.h"
+
+/*
+ * Timeline tracer recording scoped events into a fixed-size ring buffer, and
+ * dumping them in the Chrome trace event format (JSON), viewable in
+ * chrome://tracing or Perfetto.
+ *
+ * A tracer is owned by a rendering context, and is thus only ever written from
+ * the thread executing this context: recording an event does not require any
+ * locking. When the ring buffer is full, the oldest events are overwritten.
+ */
+
+#define NGLI_TRACER_NB_EVENTS (1 << 16)
+
+enum ngli_tracer_track {
+    NGLI_TRACER_TRACK_CPU,
+    NGLI_TRACER_TRACK_GPU,
+    NGLI_TRACER_TRACK_NB
+};
+
+struct tracer;
+
+struct tracer *ngli_tracer_create(const char *filename);
+
+/*
+ * Return the start time of a scoped event, to be passed to ngli_tracer_end().
+ * The tracer can be NULL, in which case nothing is recorded.
+ */
+static inline int64_t ngli_tracer_begin(const struct tracer *s)
+{
+    return s ? ngli_gettime_relative() : 0;
+}
+
+void ngli_tracer_end(struct tracer *s, const char *name, const char *label, int64_t start);
+
+/* Record an event with an explicit timestamp and duration (in microseconds) */
+void ngli_tracer_add(struct tracer *s, enum ngli_tracer_track track,
+                     const char *name, const char *label, int64_t ts, int64_t dur);
+
+int ngli_tracer_dump(struct tracer *s);
+void ngli_tracer_freep(struct tracer **sp);
+
+#endif
@@ -55,22 +55,90 @@ int ngli_transform_chain_check(const struct ngl_node *node)
     return 0;
 }
 
+void ngli_transform_set_matrix(struct transform *s, const float *matrix)
+{
+    if (s->version && !memcmp(s->matrix, matrix, sizeof(s->matrix)))
+        return;
+    memcpy(s->matrix, matrix, sizeof(s->matrix));
+    s->version++;
+}
+
+/*
+ * Refresh the cached product of the transform chain starting at the specified
+ * node and return its version. Only the links whose matrix (or the chain below
+ * them) changed since the last call are re-multiplied.
+ */
+static uint64_t update_chain(const struct ngl_node *node)
+{
+    struct transform *s = node->priv_data;
+    const struct ngl_node *child = s->child;
+
+    uint64_t child_version = 0;
+    const float *child_matrix = NULL;
+    if (child->cls->category == NGLI_NODE_CATEGORY_TRANSFORM) {
+        const struct transform *child_trf = child->priv_data;
+        child_version = update_chain(child);
+        child_matrix = child_trf->chain_matrix;
+    }
+
+    if (s->chain_version &&
+        s->chain_child == child &&
+        s->chain_matrix_version == s->version &&
+        s->chain_child_version == child_version)
+        return s->chain_version;
+
+    if (child_matrix)
+        ngli_mat4_mul(s->chain_matrix, s->matrix, child_matrix);
+    else
+        memcpy(s->chain_matrix, s->matrix, sizeof(s->matrix));
+
+    s->chain_child = child;
+    s->chain_matrix_version = s->version;
+    s->chain_child_version = child_version;
+    s->chain_version++;
+    return s->chain_version;
+}
+
 void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix)
 {
-    NGLI_ALIGNED_MAT(tmp) = NGLI_MAT4_IDENTITY;
-    while (node && node->cls->category == NGLI_NODE_CATEGORY_TRANSFORM) {
-        const struct transform *transform = node->priv_data;
-        ngli_mat4_mul(tmp, tmp, transform->matrix);
-        node = transform->child;
+    if (!node || node->cls->category != NGLI_NODE_CATEGORY_TRANSFORM) {
+        static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
+        memcpy(matrix, id_matrix, sizeof(id_matrix));
+        return;
     }
-    memcpy(matrix, tmp, sizeof(tmp));
+
+    const struct transform *s = node->priv_data;
+    update_chain(node);
+    memcpy(matrix, s->chain_matrix, sizeof(s->chain_matrix));
+}
+
+/*
+ * Transform children still go through ngli_node_draw() so they remain
+ * accounted for (draw count, tracing, GPU timings), but are flagged so they do
+ * not apply their matrix a second time.
+ */
+static void draw_child(struct ngl_node *child)
+{
+    if (child->cls->category != NGLI_NODE_CATEGORY_TRANSFORM) {
+        ngli_node_draw(child);
+        return;
+    }
+
+    struct transform *child_trf = child->priv_data;
+    child_trf->flattened = 1;
+    ngli_node_draw(child);
+    child_trf->flattened = 0;
 }
 
 void ngli_transform_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct transform *s = node->priv_data;
-    struct ngl_node *child = s->child;
+
+    if (s->flattened) {
+        draw_child(s->child);
+        return;
+    }
 
     float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
     if (!next_matrix)
@@ -81,7 +149,13 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
-    ngli_node_draw(child);
+    /*
+     * The consecutive transform nodes are flattened into a single matrix so
+     * the chain does not have to be multiplied at every level
+     */
+    update_chain(node);
+    ngli_mat4_mul(next_matrix, prev_matrix, s->chain_matrix);
+
+    draw_child(s->child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
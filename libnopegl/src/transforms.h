@@ -23,6 +23,7 @@
 #define TRANSFORMS_H
 
 #include "internal.h"
+#include "node_transform.h"
 
 #define TRANSFORM_TYPES_ARGS                    NGL_NODE_ROTATE,    \
                                                 NGL_NODE_ROTATEQUAT,\
@@ -34,6 +35,7 @@
 #define TRANSFORM_TYPES_LIST (const uint32_t[]){TRANSFORM_TYPES_ARGS, NGL_NODE_IDENTITY, NGLI_NODE_NONE}
 
 const struct ngl_node *ngli_transform_get_leaf_node(const struct ngl_node *node);
+void ngli_transform_set_matrix(struct transform *s, const float *matrix);
 int ngli_transform_chain_check(const struct ngl_node *node);
 void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix);
 void ngli_transform_draw(struct ngl_node *node);
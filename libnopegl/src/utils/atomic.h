@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <stdint.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * Minimal atomic operations on 64-bit counters, without relying on C11
+ * atomics which are not available by default with MSVC. They do not imply any
+ * ordering of the surrounding memory accesses.
+ */
+
+static inline void ngli_atomic_inc64(volatile int64_t *v)
+{
+#ifdef _MSC_VER
+    _InterlockedIncrement64(v);
+#else
+    __atomic_fetch_add(v, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline int64_t ngli_atomic_load64(volatile int64_t *v)
+{
+#ifdef _MSC_VER
+    return _InterlockedCompareExchange64(v, 0, 0);
+#else
+    return __atomic_load_n(v, __ATOMIC_RELAXED);
+#endif
+}
+
+#endif /* ATOMIC_H */
@@ -20,16 +20,22 @@
  * under the License.
  */
 
+/* Required for madvise() */
+#define _DEFAULT_SOURCE
+
 #ifdef _WIN32
 #include <Windows.h>
 #else
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 #endif
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -62,3 +68,98 @@ int ngli_get_filesize(const char *filename, int64_t *size)
 #endif
     return 0;
 }
+
+int ngli_file_map_init(struct file_map *s, const char *filename)
+{
+    memset(s, 0, sizeof(*s));
+
+    int64_t size;
+    int ret = ngli_get_filesize(filename, &size);
+    if (ret < 0)
+        return ret;
+
+    if (size <= 0) {
+        LOG(ERROR, "'%s' is empty", filename);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if ((uint64_t)size > SIZE_MAX) {
+        LOG(ERROR, "'%s' size (%" PRId64 ") exceeds supported limit (%zu)", filename, size, SIZE_MAX);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFile(TEXT(filename), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    /* The mapping object keeps its own reference on the file */
+    HANDLE mapping = CreateFileMapping(file_handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file_handle);
+    if (!mapping) {
+        LOG(ERROR, "could not create a file mapping of '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        LOG(ERROR, "could not map '%s'", filename);
+        CloseHandle(mapping);
+        return NGL_ERROR_IO;
+    }
+    s->handle = mapping;
+#else
+    const int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    /* The mapping remains valid after the file descriptor is closed */
+    void *data = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+#endif
+
+    s->data = data;
+    s->size = (size_t)size;
+
+    return 0;
+}
+
+void ngli_file_map_evict(struct file_map *s, size_t offset, size_t size)
+{
+#ifdef _WIN32
+    /* Resident pages can not be discarded from a copy-on-write view */
+#else
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0)
+        return;
+
+    /* Only evict the pages fully contained in the range */
+    const size_t mask = (size_t)page_size - 1;
+    const size_t start = NGLI_ALIGN(offset, (size_t)page_size);
+    const size_t end = offset + size == s->size ? NGLI_ALIGN(s->size, (size_t)page_size)
+                                                : (offset + size) & ~mask;
+    if (end > start)
+        madvise(s->data + start, end - start, MADV_DONTNEED);
+#endif
+}
+
+void ngli_file_map_reset(struct file_map *s)
+{
+    if (s->data) {
+#ifdef _WIN32
+        UnmapViewOfFile(s->data);
+        CloseHandle(s->handle);
+#else
+        munmap(s->data, s->size);
+#endif
+    }
+    memset(s, 0, sizeof(*s));
+}
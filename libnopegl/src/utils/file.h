@@ -23,8 +23,29 @@
 #ifndef FILE_H
 #define FILE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 int ngli_get_filesize(const char *name, int64_t *size);
 
+/*
+ * Private (copy-on-write) memory mapping of a whole file: the pages are read
+ * from the file on first access instead of at initialization.
+ */
+struct file_map {
+    uint8_t *data;
+    size_t size;
+    void *handle; /* platform specific mapping handle */
+};
+
+int ngli_file_map_init(struct file_map *s, const char *filename);
+
+/*
+ * Drop the resident pages of the given range, which will be read back from
+ * the file if accessed again. Pages modified through the mapping are lost.
+ */
+void ngli_file_map_evict(struct file_map *s, size_t offset, size_t size);
+
+void ngli_file_map_reset(struct file_map *s);
+
 #endif /* FILE_H */
@@ -22,9 +22,11 @@
 
 #include "config.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "atomic.h"
 #include "memory.h"
 #include "utils.h"
 
@@ -62,10 +64,23 @@ static inline int failure_requested(void)
 }
 #endif
 
+static int64_t nb_allocations;
+
+static inline void register_allocation(void)
+{
+    ngli_atomic_inc64(&nb_allocations);
+}
+
+uint64_t ngli_memory_get_nb_allocations(void)
+{
+    return (uint64_t)ngli_atomic_load64(&nb_allocations);
+}
+
 void *ngli_malloc(size_t size)
 {
     if (failure_requested())
         return NULL;
+    register_allocation();
     return malloc(size);
 }
 
@@ -73,6 +88,7 @@ void *ngli_calloc(size_t n, size_t size)
 {
     if (failure_requested())
         return NULL;
+    register_allocation();
     return calloc(n, size);
 }
 
@@ -80,6 +96,7 @@ void *ngli_malloc_aligned(size_t size)
 {
     if (failure_requested())
         return NULL;
+    register_allocation();
 
 #ifdef _WIN32
     return _aligned_malloc(size, NGLI_ALIGN_VAL);
@@ -92,6 +109,7 @@ void *ngli_realloc(void *ptr, size_t n, size_t size)
 {
     if (failure_requested())
         return NULL;
+    register_allocation();
 #if HAVE_BUILTIN_OVERFLOW
     size_t bytes;
     if (__builtin_mul_overflow(n, size, &bytes))
@@ -24,6 +24,7 @@
 #define MEMORY_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 void *ngli_malloc(size_t size);
 void *ngli_calloc(size_t n, size_t size);
@@ -38,4 +39,10 @@ void ngli_freep_aligned(void *ptr);
 
 void *ngli_memdup(const void *src, size_t n);
 
+/*
+ * Number of heap allocations performed through the functions above since the
+ * library has been loaded, all threads and contexts included.
+ */
+uint64_t ngli_memory_get_nb_allocations(void);
+
 #endif
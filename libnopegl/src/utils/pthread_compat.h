@@ -51,6 +51,9 @@ typedef SRWLOCK pthread_mutex_t;
 typedef CONDITION_VARIABLE pthread_cond_t;
 #define PTHREAD_COND_INITIALIZER CONDITION_VARIABLE_INIT
 
+typedef INIT_ONCE pthread_once_t;
+#define PTHREAD_ONCE_INIT INIT_ONCE_STATIC_INIT
+
 static unsigned __stdcall pthread_compat_worker(void *arg)
 {
     pthread_t *thread = (pthread_t *)arg;
@@ -175,5 +178,18 @@ static inline int pthread_cond_destroy(pthread_cond_t *cond)
 {
     return 0;
 }
+
+static BOOL CALLBACK pthread_compat_once_callback(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+    void (**init_routine)(void) = (void (**)(void))param;
+    (*init_routine)();
+    return TRUE;
+}
+
+static inline int pthread_once(pthread_once_t *once_control, void (*init_routine)(void))
+{
+    InitOnceExecuteOnce(once_control, pthread_compat_once_callback, &init_routine, NULL);
+    return 0;
+}
 #endif
 #endif
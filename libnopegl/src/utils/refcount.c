@@ -38,3 +38,8 @@ void ngli_rc_unrefp(struct ngli_rc **sp)
 
     *sp = NULL;
 }
+
+int ngli_rc_is_unique(const struct ngli_rc *s)
+{
+    return s->count == 1;
+}
@@ -38,8 +38,10 @@ struct ngli_rc {
 #define NGLI_RC_CREATE(fn) (struct ngli_rc) { .count=1, .freep=(ngli_freep_func)fn }
 #define NGLI_RC_REF(s) (void *)ngli_rc_ref((struct ngli_rc *)(s))
 #define NGLI_RC_UNREFP(sp) ngli_rc_unrefp((struct ngli_rc **)(sp))
+#define NGLI_RC_IS_UNIQUE(s) ngli_rc_is_unique((const struct ngli_rc *)(s))
 
 struct ngli_rc *ngli_rc_ref(struct ngli_rc *s);
 void ngli_rc_unrefp(struct ngli_rc **sp);
+int ngli_rc_is_unique(const struct ngli_rc *s);
 
 #endif /* REFCOUNT_H */
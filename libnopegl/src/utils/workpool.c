@@ -0,0 +1,207 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "darray.h"
+#include "memory.h"
+#include "pthread_compat.h"
+#include "thread.h"
+#include "utils.h"
+#include "workpool.h"
+
+enum job_state {
+    JOB_STATE_QUEUED,
+    JOB_STATE_RUNNING,
+    JOB_STATE_DONE,
+};
+
+struct workpool_job {
+    workpool_func_type func;
+    void *arg;
+    enum job_state state;
+    int ret;
+};
+
+struct workpool {
+    pthread_t *threads;
+    size_t nb_threads;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_queue;
+    pthread_cond_t cond_done;
+    struct darray queue; /* struct workpool_job * */
+    int stop;
+};
+
+static void *worker_thread(void *arg)
+{
+    struct workpool *s = arg;
+
+    ngli_thread_set_name("ngl-workpool");
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->stop && !ngli_darray_count(&s->queue))
+            pthread_cond_wait(&s->cond_queue, &s->lock);
+        if (s->stop)
+            break;
+
+        struct workpool_job *job = *(struct workpool_job **)ngli_darray_get(&s->queue, 0);
+        ngli_darray_remove(&s->queue, 0);
+        job->state = JOB_STATE_RUNNING;
+        pthread_mutex_unlock(&s->lock);
+
+        const int ret = job->func(job->arg);
+
+        pthread_mutex_lock(&s->lock);
+        job->ret = ret;
+        job->state = JOB_STATE_DONE;
+        pthread_cond_broadcast(&s->cond_done);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+struct workpool *ngli_workpool_create(size_t nb_threads)
+{
+    struct workpool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    ngli_darray_init(&s->queue, sizeof(struct workpool_job *), 0);
+
+    if (pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->cond_queue, NULL) ||
+        pthread_cond_init(&s->cond_done, NULL)) {
+        ngli_darray_reset(&s->queue);
+        ngli_freep(&s);
+        return NULL;
+    }
+
+    s->threads = ngli_calloc(nb_threads, sizeof(*s->threads));
+    if (!s->threads) {
+        ngli_workpool_freep(&s);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < nb_threads; i++) {
+        if (pthread_create(&s->threads[i], NULL, worker_thread, s)) {
+            ngli_workpool_freep(&s);
+            return NULL;
+        }
+        s->nb_threads++;
+    }
+
+    return s;
+}
+
+struct workpool_job *ngli_workpool_submit(struct workpool *s, workpool_func_type func, void *arg)
+{
+    struct workpool_job *job = ngli_calloc(1, sizeof(*job));
+    if (!job)
+        return NULL;
+    job->func = func;
+    job->arg = arg;
+    job->state = JOB_STATE_QUEUED;
+
+    pthread_mutex_lock(&s->lock);
+    if (!ngli_darray_push(&s->queue, &job)) {
+        pthread_mutex_unlock(&s->lock);
+        ngli_freep(&job);
+        return NULL;
+    }
+    pthread_cond_signal(&s->cond_queue);
+    pthread_mutex_unlock(&s->lock);
+
+    return job;
+}
+
+int ngli_workpool_is_done(struct workpool *s, const struct workpool_job *job)
+{
+    pthread_mutex_lock(&s->lock);
+    const int done = job->state == JOB_STATE_DONE;
+    pthread_mutex_unlock(&s->lock);
+    return done;
+}
+
+int ngli_workpool_wait(struct workpool *s, struct workpool_job **jobp)
+{
+    struct workpool_job *job = *jobp;
+    if (!job)
+        return 0;
+
+    pthread_mutex_lock(&s->lock);
+    while (job->state != JOB_STATE_DONE)
+        pthread_cond_wait(&s->cond_done, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+
+    const int ret = job->ret;
+    ngli_freep(jobp);
+    return ret;
+}
+
+int ngli_workpool_cancel(struct workpool *s, struct workpool_job **jobp)
+{
+    struct workpool_job *job = *jobp;
+    if (!job)
+        return 0;
+
+    pthread_mutex_lock(&s->lock);
+    if (job->state == JOB_STATE_QUEUED) {
+        struct workpool_job **jobs = ngli_darray_data(&s->queue);
+        for (size_t i = 0; i < ngli_darray_count(&s->queue); i++) {
+            if (jobs[i] == job) {
+                ngli_darray_remove(&s->queue, i);
+                break;
+            }
+        }
+        pthread_mutex_unlock(&s->lock);
+        ngli_freep(jobp);
+        return 0;
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    ngli_workpool_wait(s, jobp);
+    return 1;
+}
+
+void ngli_workpool_freep(struct workpool **sp)
+{
+    struct workpool *s = *sp;
+    if (!s)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    ngli_assert(!ngli_darray_count(&s->queue));
+    s->stop = 1;
+    pthread_cond_broadcast(&s->cond_queue);
+    pthread_mutex_unlock(&s->lock);
+
+    for (size_t i = 0; i < s->nb_threads; i++)
+        pthread_join(s->threads[i], NULL);
+    ngli_freep(&s->threads);
+
+    pthread_cond_destroy(&s->cond_done);
+    pthread_cond_destroy(&s->cond_queue);
+    pthread_mutex_destroy(&s->lock);
+    ngli_darray_reset(&s->queue);
+    ngli_freep(sp);
+}
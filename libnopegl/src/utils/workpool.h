@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <stddef.h>
+
+/*
+ * Pool of worker threads executing jobs in their submission order.
+ *
+ * A submitted job is owned by the caller until it is collected with either
+ * ngli_workpool_wait() or ngli_workpool_cancel(), which must be called
+ * exactly once per job.
+ */
+
+struct workpool;
+struct workpool_job;
+
+typedef int (*workpool_func_type)(void *arg);
+
+struct workpool *ngli_workpool_create(size_t nb_threads);
+struct workpool_job *ngli_workpool_submit(struct workpool *s, workpool_func_type func, void *arg);
+
+/* Non-blocking check of the job completion */
+int ngli_workpool_is_done(struct workpool *s, const struct workpool_job *job);
+
+/* Wait for the job completion and return its result */
+int ngli_workpool_wait(struct workpool *s, struct workpool_job **jobp);
+
+/*
+ * Remove the job from the queue if it has not started yet, otherwise wait for
+ * its completion. Return whether the job function has been executed.
+ */
+int ngli_workpool_cancel(struct workpool *s, struct workpool_job **jobp);
+
+/* All the jobs must have been collected before destroying the pool */
+void ngli_workpool_freep(struct workpool **sp);
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "nopegl.h"
+#include "utils/memory.h"
+#include "utils/utils.h"
+#include "vcache.h"
+
+struct tipsify {
+    size_t nb_triangles;
+    size_t nb_vertices;
+    uint32_t *offsets;  // start of the triangles of each vertex in adjacency (nb_vertices + 1)
+    uint32_t *adjacency;// triangles using each vertex
+    uint32_t *live;     // number of triangles not emitted yet, for each vertex
+    uint32_t *stamps;   // cache insertion time of each vertex
+    uint8_t *emitted;   // whether each triangle has been emitted
+    uint32_t *dead_end; // stack of emitted vertices, to restart from when stuck
+    size_t nb_dead_end;
+    uint32_t *candidates;
+    size_t nb_candidates;
+    uint32_t time;
+    size_t cursor;
+};
+
+static void tipsify_reset(struct tipsify *s)
+{
+    ngli_freep(&s->offsets);
+    ngli_freep(&s->adjacency);
+    ngli_freep(&s->live);
+    ngli_freep(&s->stamps);
+    ngli_freep(&s->emitted);
+    ngli_freep(&s->dead_end);
+    ngli_freep(&s->candidates);
+}
+
+static int tipsify_init(struct tipsify *s, const uint32_t *indices, size_t nb_indices, size_t nb_vertices)
+{
+    s->nb_triangles = nb_indices / 3;
+    s->nb_vertices = nb_vertices;
+    s->offsets = ngli_calloc(nb_vertices + 1, sizeof(*s->offsets));
+    s->adjacency = ngli_calloc(NGLI_MAX(nb_indices, 1), sizeof(*s->adjacency));
+    s->live = ngli_calloc(NGLI_MAX(nb_vertices, 1), sizeof(*s->live));
+    s->stamps = ngli_calloc(NGLI_MAX(nb_vertices, 1), sizeof(*s->stamps));
+    s->emitted = ngli_calloc(NGLI_MAX(s->nb_triangles, 1), sizeof(*s->emitted));
+    s->dead_end = ngli_calloc(NGLI_MAX(nb_indices, 1), sizeof(*s->dead_end));
+    if (!s->offsets || !s->adjacency || !s->live || !s->stamps || !s->emitted || !s->dead_end)
+        return NGL_ERROR_MEMORY;
+
+    for (size_t i = 0; i < nb_indices; i++) {
+        if (indices[i] >= nb_vertices)
+            return NGL_ERROR_INVALID_ARG;
+        s->live[indices[i]]++;
+    }
+
+    uint32_t max_live = 0;
+    for (size_t v = 0; v < nb_vertices; v++) {
+        s->offsets[v + 1] = s->offsets[v] + s->live[v];
+        max_live = NGLI_MAX(max_live, s->live[v]);
+    }
+
+    /* Use the stamps as temporary fill counters */
+    for (size_t t = 0; t < s->nb_triangles; t++) {
+        for (size_t k = 0; k < 3; k++) {
+            const uint32_t v = indices[t * 3 + k];
+            s->adjacency[s->offsets[v] + s->stamps[v]++] = (uint32_t)t;
+        }
+    }
+    memset(s->stamps, 0, nb_vertices * sizeof(*s->stamps));
+
+    s->candidates = ngli_calloc(NGLI_MAX(max_live, 1) * 3, sizeof(*s->candidates));
+    if (!s->candidates)
+        return NGL_ERROR_MEMORY;
+
+    /* Every vertex starts out of the cache */
+    s->time = NGLI_VCACHE_SIZE + 1;
+
+    return 0;
+}
+
+static int64_t skip_dead_end(struct tipsify *s)
+{
+    while (s->nb_dead_end) {
+        const uint32_t v = s->dead_end[--s->nb_dead_end];
+        if (s->live[v])
+            return v;
+    }
+    while (s->cursor < s->nb_vertices) {
+        const size_t v = s->cursor++;
+        if (s->live[v])
+            return (int64_t)v;
+    }
+    return -1;
+}
+
+/*
+ * Pick the candidate which will still be in the cache once all its remaining
+ * triangles are emitted, preferring the ones inserted the earliest.
+ */
+static int64_t get_next_vertex(struct tipsify *s)
+{
+    int64_t best = -1;
+    int64_t best_priority = -1;
+    for (size_t i = 0; i < s->nb_candidates; i++) {
+        const uint32_t v = s->candidates[i];
+        if (!s->live[v])
+            continue;
+        int64_t priority = 0;
+        const int64_t age = (int64_t)s->time - (int64_t)s->stamps[v];
+        if (age + 2 * (int64_t)s->live[v] <= NGLI_VCACHE_SIZE)
+            priority = age;
+        if (priority > best_priority) {
+            best = v;
+            best_priority = priority;
+        }
+    }
+    return best >= 0 ? best : skip_dead_end(s);
+}
+
+int ngli_vcache_optimize(uint32_t *dst, const uint32_t *indices, size_t nb_indices, size_t nb_vertices)
+{
+    if (nb_indices % 3 || nb_indices > UINT32_MAX)
+        return NGL_ERROR_INVALID_ARG;
+
+    struct tipsify s = {0};
+    int ret = tipsify_init(&s, indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        goto end;
+
+    size_t nb_out = 0;
+    int64_t vertex = skip_dead_end(&s);
+    while (vertex >= 0) {
+        s.nb_candidates = 0;
+        for (uint32_t i = s.offsets[vertex]; i < s.offsets[vertex + 1]; i++) {
+            const uint32_t t = s.adjacency[i];
+            if (s.emitted[t])
+                continue;
+            for (size_t k = 0; k < 3; k++) {
+                const uint32_t v = indices[t * 3 + k];
+                dst[nb_out++] = v;
+                s.dead_end[s.nb_dead_end++] = v;
+                s.candidates[s.nb_candidates++] = v;
+                s.live[v]--;
+                if (s.time - s.stamps[v] > NGLI_VCACHE_SIZE)
+                    s.stamps[v] = s.time++;
+            }
+            s.emitted[t] = 1;
+        }
+        vertex = get_next_vertex(&s);
+    }
+    ngli_assert(nb_out == nb_indices);
+
+end:
+    tipsify_reset(&s);
+    return ret;
+}
+
+float ngli_vcache_get_acmr(const uint32_t *indices, size_t nb_indices, size_t nb_vertices, size_t cache_size)
+{
+    const size_t nb_triangles = nb_indices / 3;
+    if (!nb_triangles)
+        return 0.f;
+
+    /* Insertion time of each vertex, a vertex being cached if it is among the last cache_size misses */
+    size_t *stamps = ngli_calloc(nb_vertices, sizeof(*stamps));
+    if (!stamps)
+        return -1.f;
+
+    size_t nb_misses = 0;
+    for (size_t i = 0; i < nb_indices; i++) {
+        const uint32_t v = indices[i];
+        if (stamps[v] && nb_misses - stamps[v] < cache_size)
+            continue;
+        stamps[v] = ++nb_misses;
+    }
+
+    ngli_free(stamps);
+    return (float)nb_misses / (float)nb_triangles;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef VCACHE_H
+#define VCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Size of the post-transform vertex cache the triangles are ordered for. The
+ * actual size varies between GPUs, but an order tuned for a small cache still
+ * performs well on larger ones.
+ */
+#define NGLI_VCACHE_SIZE 16
+
+/*
+ * Reorder the triangles of a triangle list so that consecutive triangles share
+ * as many vertices as possible, using the Tipsify algorithm (Sander, Nehab,
+ * Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced
+ * Overdraw", 2007). The vertices of each triangle keep their winding.
+ *
+ * dst and indices must not overlap and contain nb_indices entries, all lower
+ * than nb_vertices.
+ */
+int ngli_vcache_optimize(uint32_t *dst, const uint32_t *indices, size_t nb_indices, size_t nb_vertices);
+
+/*
+ * Average number of vertex shader invocations per triangle (ACMR) with a FIFO
+ * post-transform cache of the specified size: 0.5 is the optimum for large
+ * regular meshes, 3 the worst case.
+ */
+float ngli_vcache_get_acmr(const uint32_t *indices, size_t nb_indices, size_t nb_vertices, size_t cache_size);
+
+#endif
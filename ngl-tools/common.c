@@ -19,7 +19,7 @@
  * under the License.
  */
 
-#define _POSIX_C_SOURCE 199309L // clock_gettime()
+#define _POSIX_C_SOURCE 200112L // clock_gettime(), fseeko(), ftello()
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -135,3 +135,22 @@ end:
         fclose(fp);
     return buf;
 }
+
+/* fseek() and ftell() use a long, which is limited to 2GB on some platforms */
+int fseek64(FILE *fp, int64_t offset, int whence)
+{
+#ifdef _WIN32
+    return _fseeki64(fp, offset, whence);
+#else
+    return fseeko(fp, (off_t)offset, whence);
+#endif
+}
+
+int64_t ftell64(FILE *fp)
+{
+#ifdef _WIN32
+    return _ftelli64(fp);
+#else
+    return (int64_t)ftello(fp);
+#endif
+}
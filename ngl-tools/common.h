@@ -23,6 +23,7 @@
 #define COMMON_H
 
 #include <stdint.h>
+#include <stdio.h>
 
 #define ARRAY_NB(x) (sizeof(x) / sizeof(*(x)))
 
@@ -35,5 +36,7 @@ double clipf64(double v, double min, double max);
 int clipi32(int v, int min, int max);
 int64_t clipi64(int64_t v, int64_t min, int64_t max);
 char *get_text_file_content(const char *filename);
+int fseek64(FILE *fp, int64_t offset, int whence);
+int64_t ftell64(FILE *fp);
 
 #endif
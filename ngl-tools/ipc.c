@@ -41,6 +41,42 @@ static void u32_write(uint8_t *buf, uint32_t v)
     buf[3] = v       & 0xff;
 }
 
+static void u64_write(uint8_t *buf, uint64_t v)
+{
+    u32_write(buf,     (uint32_t)(v >> 32));
+    u32_write(buf + 4, (uint32_t)(v & 0xffffffff));
+}
+
+/* 64-bit FNV-1a */
+uint64_t ipc_hash(uint64_t hash, const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+int ipc_hash_file(FILE *fp, uint64_t *hashp)
+{
+    uint8_t buf[64 * 1024];
+    uint64_t hash = IPC_HASH_INIT;
+
+    rewind(fp);
+    for (;;) {
+        const size_t n = fread(buf, 1, sizeof(buf), fp);
+        hash = ipc_hash(hash, buf, n);
+        if (n < sizeof(buf))
+            break;
+    }
+    if (ferror(fp))
+        return NGL_ERROR_IO;
+    rewind(fp);
+
+    *hashp = hash;
+    return 0;
+}
+
 static void pkt_update_header(struct ipc_pkt *pkt)
 {
     memcpy(pkt->data, "nglp", 4); // 'p' stands for packet
@@ -84,14 +120,37 @@ int ipc_pkt_add_qtag_scene(struct ipc_pkt *pkt, const char *scene)
     return pack(pkt, IPC_SCENE, scene, strlen(scene) + 1);
 }
 
+int ipc_pkt_add_qtag_livectl(struct ipc_pkt *pkt, const char *livectl)
+{
+    return pack(pkt, IPC_LIVECTL, livectl, strlen(livectl) + 1);
+}
+
 int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename)
 {
     return pack(pkt, IPC_FILE, filename, strlen(filename) + 1);
 }
 
-int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, const uint8_t *chunk, size_t chunk_size)
+int ipc_pkt_add_qtag_fileinfo(struct ipc_pkt *pkt, int64_t size, uint64_t hash)
+{
+    int ret = pack(pkt, IPC_FILEINFO, NULL, 16);
+    if (ret < 0)
+        return ret;
+    uint8_t *dst = pkt->data + pkt->size - 16;
+    u64_write(dst, (uint64_t)size);
+    u64_write(dst + 8, hash);
+    return 0;
+}
+
+int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, int64_t offset, const uint8_t *chunk, size_t chunk_size)
 {
-    return pack(pkt, IPC_FILEPART, chunk, chunk_size);
+    int ret = pack(pkt, IPC_FILEPART, NULL, 16 + chunk_size);
+    if (ret < 0)
+        return ret;
+    uint8_t *dst = pkt->data + pkt->size - 16 - chunk_size;
+    u64_write(dst, (uint64_t)offset);
+    u64_write(dst + 8, ipc_hash(IPC_HASH_INIT, chunk, chunk_size));
+    memcpy(dst + 16, chunk, chunk_size);
+    return 0;
 }
 
 int ipc_pkt_add_qtag_clearcolor(struct ipc_pkt *pkt, const float *clearcolor)
@@ -121,18 +180,23 @@ int ipc_pkt_add_qtag_reconfigure(struct ipc_pkt *pkt)
     return pack(pkt, IPC_RECONFIGURE, NULL, 0);
 }
 
+int ipc_pkt_add_qtag_stats(struct ipc_pkt *pkt)
+{
+    return pack(pkt, IPC_STATS, NULL, 0);
+}
+
 int ipc_pkt_add_rtag_info(struct ipc_pkt *pkt, const char *info)
 {
     return pack(pkt, IPC_INFO, info, strlen(info) + 1);
 }
 
-int ipc_pkt_add_rtag_filepart(struct ipc_pkt *pkt, int written)
+int ipc_pkt_add_rtag_fileoffset(struct ipc_pkt *pkt, int64_t offset)
 {
-    int ret = pack(pkt, IPC_FILEPART, NULL, 4);
+    int ret = pack(pkt, IPC_FILEOFFSET, NULL, 8);
     if (ret < 0)
         return ret;
-    uint8_t *dst = pkt->data + pkt->size - 4;
-    u32_write(dst, written);
+    uint8_t *dst = pkt->data + pkt->size - 8;
+    u64_write(dst, (uint64_t)offset);
     return 0;
 }
 
@@ -141,6 +205,11 @@ int ipc_pkt_add_rtag_fileend(struct ipc_pkt *pkt, const char *dest_filename)
     return pack(pkt, IPC_FILEEND, dest_filename, strlen(dest_filename) + 1);
 }
 
+int ipc_pkt_add_rtag_stats(struct ipc_pkt *pkt, const char *stats)
+{
+    return pack(pkt, IPC_STATS, stats, strlen(stats) + 1);
+}
+
 void ipc_pkt_freep(struct ipc_pkt **pktp)
 {
     struct ipc_pkt *pkt = *pktp;
@@ -156,15 +225,15 @@ int ipc_send(int fd, const struct ipc_pkt *pkt)
     if (pkt->size > INT_MAX)
         return NGL_ERROR_LIMIT_EXCEEDED;
 
-    const int n = (int)send(fd, (void *)pkt->data, (int)pkt->size, 0);
-    if (n < 0) {
-        perror("send");
-        return NGL_ERROR_IO;
-    }
-    // XXX: should we loop instead?
-    if (n != pkt->size) {
-        fprintf(stderr, "unable write packet (%d/%zu sent)\n", n, pkt->size);
-        return NGL_ERROR_IO;
+    /* Large packets (such as file parts) may only be partially sent */
+    size_t nw = 0;
+    while (nw != pkt->size) {
+        const int n = (int)send(fd, (void *)(pkt->data + nw), (int)(pkt->size - nw), 0);
+        if (n <= 0) {
+            perror("send");
+            return NGL_ERROR_IO;
+        }
+        nw += n;
     }
     return 0;
 }
@@ -204,7 +273,7 @@ int ipc_recv(int fd, struct ipc_pkt *pkt)
 
     const int size = IPC_U32_READ(pkt->data + 4);
     if (size == 0) // valid but empty packet
-        return 0;
+        return 1;
 
     if (size < 0)
         return NGL_ERROR_INVALID_DATA;
@@ -221,3 +290,39 @@ int ipc_recv(int fd, struct ipc_pkt *pkt)
     pkt->size += size;
     return ret;
 }
+
+int ipc_recv_partial(int fd, struct ipc_pkt *pkt, size_t *nb_readp)
+{
+    size_t nb_read = *nb_readp;
+    const size_t target = nb_read < 8 ? 8 : pkt->size;
+
+    const int n = (int)recv(fd, (void *)(pkt->data + nb_read), (int)(target - nb_read), 0);
+    if (n < 0) {
+        perror("recv");
+        return NGL_ERROR_IO;
+    }
+    if (n == 0)
+        return NGL_ERROR_IO;
+    nb_read += n;
+    *nb_readp = nb_read;
+
+    if (nb_read < 8)
+        return 0;
+
+    if (nb_read == 8) {
+        if (memcmp(pkt->data, "nglp", 4))
+            return NGL_ERROR_INVALID_DATA;
+
+        const int size = IPC_U32_READ(pkt->data + 4);
+        if (size < 0)
+            return NGL_ERROR_INVALID_DATA;
+
+        uint8_t *dst = realloc(pkt->data, 8 + size);
+        if (!dst)
+            return NGL_ERROR_MEMORY;
+        pkt->data = dst;
+        pkt->size = 8 + size;
+    }
+
+    return nb_read == pkt->size;
+}
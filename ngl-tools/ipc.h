@@ -23,23 +23,56 @@
 #define IPC_H
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #define IPC_U32(a,b,c,d) (((uint32_t)(a))<<24 | (b)<<16 | (c)<<8 | (d))
 #define IPC_U32_READ(buf) IPC_U32((buf)[0], (buf)[1], (buf)[2], (buf)[3])
 #define IPC_U32_FMT(tag) (tag)>>24, (tag)>>16&0xff, (tag)>>8&0xff, (tag)&0xff
+#define IPC_U64_READ(buf) ((uint64_t)IPC_U32_READ(buf) << 32 | IPC_U32_READ((buf) + 4))
 
 enum ipc_tag {
     IPC_SCENE        = IPC_U32('s','c','n','e'),
+    /*
+     * Contrary to IPC_SCENE which replaces the whole scene, IPC_LIVECTL
+     * changes the value of a live control of the current scene in place. Its
+     * payload is an "id=value" string where id is the live_id of the node, and
+     * value the new components separated by commas (or the string itself for
+     * text nodes).
+     */
+    IPC_LIVECTL      = IPC_U32('l','c','t','l'),
     IPC_FILE         = IPC_U32('f','i','l','e'),
+    IPC_FILEINFO     = IPC_U32('f','i','n','f'),
+    IPC_FILEOFFSET   = IPC_U32('f','o','f','f'),
     IPC_FILEPART     = IPC_U32('f','p','r','t'),
     IPC_FILEEND      = IPC_U32('f','e','n','d'),
     IPC_CLEARCOLOR   = IPC_U32('c','c','l','r'),
     IPC_SAMPLES      = IPC_U32('m','s','a','a'),
     IPC_INFO         = IPC_U32('i','n','f','o'),
     IPC_RECONFIGURE  = IPC_U32('r','c','f','g'),
+    /*
+     * A client sending IPC_STATS subscribes to the frame statistics of the
+     * player: they are then periodically pushed to it, outside of any query,
+     * as a packet containing a single IPC_STATS tag of "key=value" lines.
+     */
+    IPC_STATS        = IPC_U32('s','t','a','t'),
 };
 
+/*
+ * File uploads are content addressed: the client sends the name of the file
+ * (IPC_FILE) along with its size and hash (IPC_FILEINFO). The server replies
+ * with the final path if it already has the content (IPC_FILEEND), or with
+ * the offset from which the upload must start (IPC_FILEOFFSET), which allows
+ * resuming an interrupted upload. The client then streams all the remaining
+ * parts (IPC_FILEPART, each with its offset and checksum) without waiting for
+ * any acknowledgement; the server only replies once the last part is received
+ * and the whole content is verified (IPC_FILEEND).
+ */
+#define IPC_HASH_INIT 0xcbf29ce484222325ULL
+
+uint64_t ipc_hash(uint64_t hash, const uint8_t *data, size_t size);
+int ipc_hash_file(FILE *fp, uint64_t *hashp);
+
 struct ipc_pkt {
     uint8_t *data;
     size_t size;
@@ -51,19 +84,36 @@ void ipc_pkt_freep(struct ipc_pkt **pktp);
 
 /* Query tags */
 int ipc_pkt_add_qtag_scene(struct ipc_pkt *pkt, const char *scene);
+int ipc_pkt_add_qtag_livectl(struct ipc_pkt *pkt, const char *livectl);
 int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename);
-int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, const uint8_t *chunk, size_t chunk_size);
+int ipc_pkt_add_qtag_fileinfo(struct ipc_pkt *pkt, int64_t size, uint64_t hash);
+int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, int64_t offset, const uint8_t *chunk, size_t chunk_size);
 int ipc_pkt_add_qtag_clearcolor(struct ipc_pkt *pkt, const float *clearcolor);
 int ipc_pkt_add_qtag_samples(struct ipc_pkt *pkt, int32_t samples);
 int ipc_pkt_add_qtag_info(struct ipc_pkt *pkt);
 int ipc_pkt_add_qtag_reconfigure(struct ipc_pkt *pkt);
+int ipc_pkt_add_qtag_stats(struct ipc_pkt *pkt);
 
 /* Response tags */
 int ipc_pkt_add_rtag_info(struct ipc_pkt *pkt, const char *info);
-int ipc_pkt_add_rtag_filepart(struct ipc_pkt *pkt, int written);
+int ipc_pkt_add_rtag_fileoffset(struct ipc_pkt *pkt, int64_t offset);
 int ipc_pkt_add_rtag_fileend(struct ipc_pkt *pkt, const char *dest_filename);
+int ipc_pkt_add_rtag_stats(struct ipc_pkt *pkt, const char *stats);
 
 int ipc_send(int fd, const struct ipc_pkt *pkt);
 int ipc_recv(int fd, struct ipc_pkt *pkt);
 
+/*
+ * Receive the data currently available on fd without waiting for the whole
+ * packet, which allows serving several connections from a single thread.
+ * nb_readp holds the number of bytes of the packet received so far and must
+ * be reset to 0 before receiving a new packet. Only one read is done on the
+ * socket per call, so it does not block if the socket is reported readable.
+ *
+ * Return 1 if the packet is complete, 0 if more data is needed, and a
+ * negative NGL_ERROR_* code otherwise (NGL_ERROR_IO if the connection was
+ * closed).
+ */
+int ipc_recv_partial(int fd, struct ipc_pkt *pkt, size_t *nb_readp);
+
 #endif
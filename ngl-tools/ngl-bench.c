@@ -0,0 +1,683 @@
+/*
+ * Copyright 2025 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nopegl/nopegl.h>
+
+#include "common.h"
+#include "opts.h"
+
+#define DURATION 10.0 /* duration of the animations of the scenes, in seconds */
+
+/*
+ * Scene construction helpers: the node references given to add_node() and
+ * set_node() are consumed, and a NULL node (resulting from a failure of a
+ * previous helper) is reported as an error.
+ */
+static int add_node(struct ngl_node *node, const char *key, struct ngl_node *child)
+{
+    if (!child)
+        return NGL_ERROR_MEMORY;
+    int ret = ngl_node_param_add_nodes(node, key, 1, &child);
+    ngl_node_unrefp(&child);
+    return ret;
+}
+
+static int set_node(struct ngl_node *node, const char *key, struct ngl_node *value)
+{
+    if (!value)
+        return NGL_ERROR_MEMORY;
+    int ret = ngl_node_param_set_node(node, key, value);
+    ngl_node_unrefp(&value);
+    return ret;
+}
+
+static uint32_t lcg_state;
+
+static float random_float(void)
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return (float)(lcg_state >> 8) / (float)(1 << 24);
+}
+
+static float *random_data(size_t count)
+{
+    float *data = malloc(count * sizeof(*data));
+    if (!data)
+        return NULL;
+    for (size_t i = 0; i < count; i++)
+        data[i] = random_float() * 2.f - 1.f;
+    return data;
+}
+
+static struct ngl_node *keyframe_float(double t, double v)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT);
+    if (!node)
+        return NULL;
+    if (ngl_node_param_set_f64(node, "time", t) < 0 ||
+        ngl_node_param_set_f64(node, "value", v) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *animated_float(double v0, double v1)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    if (!node)
+        return NULL;
+    if (add_node(node, "keyframes", keyframe_float(0.0, v0)) < 0 ||
+        add_node(node, "keyframes", keyframe_float(DURATION, v1)) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *quad(float x, float y, float w, float h)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_QUAD);
+    if (!node)
+        return NULL;
+    const float corner[3] = {x, y, 0.f};
+    const float width[3]  = {w, 0.f, 0.f};
+    const float height[3] = {0.f, h, 0.f};
+    if (ngl_node_param_set_vec3(node, "corner", corner) < 0 ||
+        ngl_node_param_set_vec3(node, "width", width) < 0 ||
+        ngl_node_param_set_vec3(node, "height", height) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *draw_color(struct ngl_node *geometry, const float *color)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_DRAWCOLOR);
+    if (!node) {
+        ngl_node_unrefp(&geometry);
+        return NULL;
+    }
+    if (set_node(node, "geometry", geometry) < 0 ||
+        ngl_node_param_set_vec3(node, "color", color) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *translate(struct ngl_node *child, float x, float y)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_TRANSLATE);
+    if (!node) {
+        ngl_node_unrefp(&child);
+        return NULL;
+    }
+    const float vector[3] = {x, y, 0.f};
+    if (set_node(node, "child", child) < 0 ||
+        ngl_node_param_set_vec3(node, "vector", vector) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *rotate(struct ngl_node *child, struct ngl_node *angle)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_ROTATE);
+    if (!node) {
+        ngl_node_unrefp(&child);
+        ngl_node_unrefp(&angle);
+        return NULL;
+    }
+    const int ret_child = set_node(node, "child", child);
+    const int ret_angle = set_node(node, "angle", angle);
+    if (ret_child < 0 || ret_angle < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *texture2d(int32_t width, int32_t height)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_TEXTURE2D);
+    if (!node)
+        return NULL;
+    if (ngl_node_param_set_i32(node, "width", width) < 0 ||
+        ngl_node_param_set_i32(node, "height", height) < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *buffer_vec3(size_t count)
+{
+    float *data = random_data(count * 3);
+    if (!data)
+        return NULL;
+    struct ngl_node *node = ngl_node_create(NGL_NODE_BUFFERVEC3);
+    if (node && ngl_node_param_set_data(node, "data", count * 3 * sizeof(*data), data) < 0)
+        ngl_node_unrefp(&node);
+    free(data);
+    return node;
+}
+
+static struct ngl_node *keyframe_buffer(double t, size_t count)
+{
+    float *data = random_data(count * 3);
+    if (!data)
+        return NULL;
+    struct ngl_node *node = ngl_node_create(NGL_NODE_ANIMKEYFRAMEBUFFER);
+    if (node && (ngl_node_param_set_f64(node, "time", t) < 0 ||
+                 ngl_node_param_set_data(node, "data", count * 3 * sizeof(*data), data) < 0))
+        ngl_node_unrefp(&node);
+    free(data);
+    return node;
+}
+
+static struct ngl_node *buffer_vec2(size_t count)
+{
+    float *data = random_data(count * 2);
+    if (!data)
+        return NULL;
+    struct ngl_node *node = ngl_node_create(NGL_NODE_BUFFERVEC2);
+    if (node && ngl_node_param_set_data(node, "data", count * 2 * sizeof(*data), data) < 0)
+        ngl_node_unrefp(&node);
+    free(data);
+    return node;
+}
+
+static struct ngl_node *points(struct ngl_node *vertices, size_t count)
+{
+    struct ngl_node *node = ngl_node_create(NGL_NODE_GEOMETRY);
+    if (!node) {
+        ngl_node_unrefp(&vertices);
+        return NULL;
+    }
+    if (set_node(node, "vertices", vertices) < 0 ||
+        set_node(node, "uvcoords", buffer_vec2(count)) < 0 ||
+        ngl_node_param_set_select(node, "topology", "point_list") < 0)
+        ngl_node_unrefp(&node);
+    return node;
+}
+
+static struct ngl_node *eval_color(struct ngl_node *time, int index)
+{
+    static const char * const names[] = {"a", "b", "c"};
+
+    struct ngl_node *node = ngl_node_create(NGL_NODE_EVALVEC3);
+    if (!node)
+        return NULL;
+    if (ngl_node_param_set_str(node, "expr0", "mix(a, b, c)") < 0 ||
+        ngl_node_param_set_str(node, "expr1", "a * b") < 0 ||
+        ngl_node_param_set_str(node, "expr2", "sqrt(b * c)") < 0) {
+        ngl_node_unrefp(&node);
+        return NULL;
+    }
+
+    char expr[64];
+    for (size_t i = 0; i < ARRAY_NB(names); i++) {
+        snprintf(expr, sizeof(expr), "sin(t * %d.0 + %d.0) * 0.5 + 0.5", (int)i + 1, index);
+        struct ngl_node *eval = ngl_node_create(NGL_NODE_EVALFLOAT);
+        if (!eval ||
+            ngl_node_param_set_str(eval, "expr0", expr) < 0 ||
+            ngl_node_param_set_dict(eval, "resources", "t", time) < 0 ||
+            ngl_node_param_set_dict(node, "resources", names[i], eval) < 0) {
+            ngl_node_unrefp(&eval);
+            ngl_node_unrefp(&node);
+            return NULL;
+        }
+        ngl_node_unrefp(&eval);
+    }
+    return node;
+}
+
+/* 10000 draw calls, each with its own color and translation */
+static int build_draws(struct ngl_node *group)
+{
+    const int n = 100;
+    const float size = 2.f / (float)n;
+
+    struct ngl_node *geometry = quad(-1.f, -1.f, size, size);
+    if (!geometry)
+        return NGL_ERROR_MEMORY;
+
+    int ret = 0;
+    for (int i = 0; i < n * n && ret >= 0; i++) {
+        const float color[3] = {random_float(), random_float(), random_float()};
+        struct ngl_node *draw = draw_color(ngl_node_ref(geometry), color);
+        ret = add_node(group, "children", translate(draw, (float)(i % n) * size, (float)(i / n) * size));
+    }
+    ngl_node_unrefp(&geometry);
+    return ret;
+}
+
+/* Deep chains of animated transforms above a few draws */
+static int build_transforms(struct ngl_node *group)
+{
+    const int nb_chains = 16;
+    const int depth = 256;
+    const double angle = 360.0 / (double)depth;
+
+    for (int i = 0; i < nb_chains; i++) {
+        const float color[3] = {random_float(), random_float(), random_float()};
+        struct ngl_node *node = draw_color(quad(-.05f, -.05f, .1f, .1f), color);
+        for (int j = 0; j < depth; j++) {
+            node = rotate(node, animated_float(0.0, (j & 1) ? angle : -angle));
+            node = translate(node, (random_float() - .5f) * .01f, (random_float() - .5f) * .01f);
+        }
+        int ret = add_node(group, "children", node);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+/* Long paragraphs laid out with an animated per character effect */
+static int build_text(struct ngl_node *group)
+{
+    static const char sentence[] = "The quick brown fox jumps over the lazy dog. ";
+    const int nb_texts = 16;
+    const int nb_sentences = 24;
+
+    char *str = malloc(sizeof(sentence) * (size_t)nb_sentences);
+    if (!str)
+        return NGL_ERROR_MEMORY;
+    str[0] = 0;
+    for (int i = 0; i < nb_sentences; i++)
+        strcat(str, sentence);
+
+    int ret = 0;
+    for (int i = 0; i < nb_texts && ret >= 0; i++) {
+        struct ngl_node *effect = ngl_node_create(NGL_NODE_TEXTEFFECT);
+        if (effect && (ngl_node_param_set_select(effect, "target", "char") < 0 ||
+                       ngl_node_param_set_f64(effect, "end", DURATION) < 0 ||
+                       set_node(effect, "opacity", animated_float(0.0, 1.0)) < 0))
+            ngl_node_unrefp(&effect);
+
+        const float box[4] = {-1.f, -1.f + (float)i / 8.f, 2.f, 1.f / 8.f};
+        struct ngl_node *text = ngl_node_create(NGL_NODE_TEXT);
+        if (text && (ngl_node_param_set_str(text, "text", str) < 0 ||
+                     ngl_node_param_set_vec4(text, "box", box) < 0))
+            ngl_node_unrefp(&text);
+        if (!text) {
+            ngl_node_unrefp(&effect);
+            ret = NGL_ERROR_MEMORY;
+            break;
+        }
+
+        if (add_node(text, "effects", effect) < 0)
+            ngl_node_unrefp(&text);
+        ret = add_node(group, "children", text);
+    }
+    free(str);
+    return ret;
+}
+
+/* Animated gaussian blurs of a shared render target */
+static int build_blurs(struct ngl_node *group)
+{
+    const int n = 4;
+    const int32_t size = 512;
+    const float cell = 2.f / (float)n;
+    const float color[3] = {1.f, .5f, 0.f};
+
+    struct ngl_node *source = texture2d(size, size);
+    if (!source)
+        return NGL_ERROR_MEMORY;
+
+    struct ngl_node *rtt = ngl_node_create(NGL_NODE_RENDERTOTEXTURE);
+    if (rtt && (set_node(rtt, "child", rotate(draw_color(quad(-.5f, -.5f, 1.f, 1.f), color),
+                                              animated_float(0.0, 360.0))) < 0 ||
+                add_node(rtt, "color_textures", ngl_node_ref(source)) < 0))
+        ngl_node_unrefp(&rtt);
+    int ret = add_node(group, "children", rtt);
+
+    for (int i = 0; i < n * n && ret >= 0; i++) {
+        struct ngl_node *destination = texture2d(size, size);
+        if (!destination) {
+            ret = NGL_ERROR_MEMORY;
+            break;
+        }
+
+        const double blurriness = (double)(i + 1) / (double)(n * n);
+        struct ngl_node *blur = ngl_node_create(NGL_NODE_GAUSSIANBLUR);
+        if (blur && (ngl_node_param_set_node(blur, "source", source) < 0 ||
+                     ngl_node_param_set_node(blur, "destination", destination) < 0 ||
+                     set_node(blur, "blurriness", animated_float(0.0, blurriness)) < 0))
+            ngl_node_unrefp(&blur);
+
+        const float x = -1.f + (float)(i % n) * cell;
+        const float y = -1.f + (float)(i / n) * cell;
+        struct ngl_node *draw = ngl_node_create(NGL_NODE_DRAWTEXTURE);
+        if (draw && (ngl_node_param_set_node(draw, "texture", destination) < 0 ||
+                     set_node(draw, "geometry", quad(x, y, cell, cell)) < 0))
+            ngl_node_unrefp(&draw);
+        ngl_node_unrefp(&destination);
+
+        ret = add_node(group, "children", blur);
+        if (ret < 0) {
+            ngl_node_unrefp(&draw);
+            break;
+        }
+        ret = add_node(group, "children", draw);
+    }
+    ngl_node_unrefp(&source);
+    return ret;
+}
+
+/* Draw colors computed by a large number of expression evaluations */
+static int build_evals(struct ngl_node *group)
+{
+    const int n = 16;
+    const float size = 2.f / (float)n;
+    const float black[3] = {0.f, 0.f, 0.f};
+
+    struct ngl_node *time = ngl_node_create(NGL_NODE_TIME);
+    struct ngl_node *geometry = quad(-1.f, -1.f, size, size);
+    if (!time || !geometry) {
+        ngl_node_unrefp(&time);
+        ngl_node_unrefp(&geometry);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = 0;
+    for (int i = 0; i < n * n && ret >= 0; i++) {
+        struct ngl_node *draw = draw_color(ngl_node_ref(geometry), black);
+        if (draw && set_node(draw, "color", eval_color(time, i)) < 0)
+            ngl_node_unrefp(&draw);
+        ret = add_node(group, "children", translate(draw, (float)(i % n) * size, (float)(i / n) * size));
+    }
+    ngl_node_unrefp(&time);
+    ngl_node_unrefp(&geometry);
+    return ret;
+}
+
+/* A large static vertex buffer and an animated one uploaded at every frame */
+static int build_buffers(struct ngl_node *group)
+{
+    const size_t static_count = 1 << 20;
+    const size_t animated_count = 1 << 18;
+    const float white[3] = {1.f, 1.f, 1.f};
+    const float blue[3] = {0.f, .5f, 1.f};
+
+    int ret = add_node(group, "children", draw_color(points(buffer_vec3(static_count), static_count), white));
+    if (ret < 0)
+        return ret;
+
+    struct ngl_node *animated = ngl_node_create(NGL_NODE_ANIMATEDBUFFERVEC3);
+    if (animated && (add_node(animated, "keyframes", keyframe_buffer(0.0, animated_count)) < 0 ||
+                     add_node(animated, "keyframes", keyframe_buffer(DURATION, animated_count)) < 0))
+        ngl_node_unrefp(&animated);
+    return add_node(group, "children", draw_color(points(animated, animated_count), blue));
+}
+
+static const struct bench_scene {
+    const char *name;
+    int (*build)(struct ngl_node *group);
+} bench_scenes[] = {
+    {"draws",      build_draws},
+    {"transforms", build_transforms},
+    {"text",       build_text},
+    {"blurs",      build_blurs},
+    {"evals",      build_evals},
+    {"buffers",    build_buffers},
+};
+
+struct ctx {
+    /* options */
+    int log_level;
+    struct ngl_config cfg;
+    const char *scene;
+    const char *output;
+    int nb_frames;
+    int nb_warmup_frames;
+    int framerate;
+};
+
+#define OFFSET(x) offsetof(struct ctx, x)
+static const struct opt options[] = {
+    {"-l", "--loglevel",  OPT_TYPE_LOGLEVEL, .offset=OFFSET(log_level)},
+    {"-b", "--backend",   OPT_TYPE_BACKEND,  .offset=OFFSET(cfg.backend)},
+    {"-s", "--size",      OPT_TYPE_RATIONAL, .offset=OFFSET(cfg.width)},
+    {"-m", "--samples",   OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-n", "--frames",    OPT_TYPE_INT,      .offset=OFFSET(nb_frames)},
+    {"-w", "--warmup",    OPT_TYPE_INT,      .offset=OFFSET(nb_warmup_frames)},
+    {"-r", "--framerate", OPT_TYPE_INT,      .offset=OFFSET(framerate)},
+    {"-S", "--scene",     OPT_TYPE_STR,      .offset=OFFSET(scene)},
+    {"-o", "--output",    OPT_TYPE_STR,      .offset=OFFSET(output)},
+    {NULL, "--debug",     OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
+};
+
+enum {
+    MEASURE_UPDATE_CPU,
+    MEASURE_DRAW_CPU,
+    MEASURE_DRAW_GPU,
+    MEASURE_ALLOCATIONS,
+    NB_MEASURES
+};
+
+static const char * const measure_names[NB_MEASURES] = {
+    [MEASURE_UPDATE_CPU]  = "update_cpu_us",
+    [MEASURE_DRAW_CPU]    = "draw_cpu_us",
+    [MEASURE_DRAW_GPU]    = "draw_gpu_us",
+    [MEASURE_ALLOCATIONS] = "allocations",
+};
+
+static int cmp_i64(const void *a, const void *b)
+{
+    const int64_t va = *(const int64_t *)a;
+    const int64_t vb = *(const int64_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static int64_t get_percentile(const int64_t *values, int nb_values, int p)
+{
+    const int rank = (p * nb_values + 99) / 100;
+    return values[clipi32(rank - 1, 0, nb_values - 1)];
+}
+
+static void print_measure(FILE *fp, const char *name, int64_t *values, int nb_values, int64_t unit)
+{
+    static const int percentiles[] = {50, 90, 99};
+
+    qsort(values, nb_values, sizeof(*values), cmp_i64);
+    fprintf(fp, "      \"%s\": {\"min\": %g", name, (double)values[0] / (double)unit);
+    for (size_t i = 0; i < ARRAY_NB(percentiles); i++)
+        fprintf(fp, ", \"p%d\": %g", percentiles[i],
+                (double)get_percentile(values, nb_values, percentiles[i]) / (double)unit);
+    fprintf(fp, ", \"max\": %g},\n", (double)values[nb_values - 1] / (double)unit);
+}
+
+static struct ngl_scene *get_scene(const struct bench_scene *bench_scene, const struct ctx *s)
+{
+    struct ngl_node *group = ngl_node_create(NGL_NODE_GROUP);
+    if (!group)
+        return NULL;
+
+    /* Every scene gets the same random sequence regardless of the selection */
+    lcg_state = 0x5eed;
+
+    struct ngl_scene *scene = NULL;
+    int ret = bench_scene->build(group);
+    if (ret < 0) {
+        fprintf(stderr, "unable to build scene %s\n", bench_scene->name);
+        goto end;
+    }
+
+    scene = ngl_scene_create();
+    if (!scene)
+        goto end;
+
+    struct ngl_scene_params params = ngl_scene_default_params(group);
+    params.duration = DURATION;
+    params.framerate[0] = s->framerate;
+    params.framerate[1] = 1;
+    ret = ngl_scene_init(scene, &params);
+    if (ret < 0)
+        ngl_scene_unrefp(&scene);
+
+end:
+    ngl_node_unrefp(&group);
+    return scene;
+}
+
+static int run_scene(const struct bench_scene *bench_scene, const struct ctx *s, FILE *fp, int *first)
+{
+    int64_t *measures[NB_MEASURES] = {0};
+    for (size_t i = 0; i < NB_MEASURES; i++) {
+        measures[i] = calloc(s->nb_frames, sizeof(*measures[i]));
+        if (!measures[i]) {
+            for (size_t j = 0; j < i; j++)
+                free(measures[j]);
+            return NGL_ERROR_MEMORY;
+        }
+    }
+
+    int ret = NGL_ERROR_MEMORY;
+    struct ngl_ctx *ctx = ngl_create();
+    struct ngl_scene *scene = get_scene(bench_scene, s);
+    if (!ctx || !scene)
+        goto end;
+
+    ret = ngl_configure(ctx, &s->cfg);
+    if (ret < 0)
+        goto end;
+
+    if (*first) {
+        struct ngl_backend backend;
+        ret = ngl_get_backend(ctx, &backend);
+        if (ret < 0)
+            goto end;
+        fprintf(fp, "{\n  \"backend\": \"%s\",\n  \"name\": \"%s\",\n", backend.string_id, backend.name);
+        fprintf(fp, "  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %d,\n  \"framerate\": %d,\n",
+                s->cfg.width, s->cfg.height, s->nb_frames, s->framerate);
+        fprintf(fp, "  \"scenes\": [\n");
+        ngl_reset_backend(&backend);
+    }
+
+    const int64_t load_start = gettime_relative();
+    ret = ngl_set_scene(ctx, scene);
+    if (ret < 0)
+        goto end;
+    const int64_t load_time = gettime_relative() - load_start;
+
+    for (int i = 0; i < s->nb_warmup_frames; i++) {
+        ret = ngl_draw(ctx, 0.0);
+        if (ret < 0)
+            goto end;
+    }
+
+    struct ngl_stats stats = {0};
+    for (int i = 0; i < s->nb_frames; i++) {
+        ret = ngl_stats_get(ctx, &stats);
+        if (ret < 0)
+            goto end;
+        const uint64_t nb_allocations = stats.nb_allocations;
+
+        const double t = (double)i / (double)s->framerate;
+        ret = ngl_draw(ctx, t);
+        if (ret < 0) {
+            fprintf(stderr, "unable to draw scene %s @ t=%g\n", bench_scene->name, t);
+            goto end;
+        }
+
+        ret = ngl_stats_get(ctx, &stats);
+        if (ret < 0)
+            goto end;
+        measures[MEASURE_UPDATE_CPU][i]  = stats.cpu_update_time;
+        measures[MEASURE_DRAW_CPU][i]    = stats.cpu_draw_time;
+        measures[MEASURE_DRAW_GPU][i]    = stats.gpu_draw_time;
+        measures[MEASURE_ALLOCATIONS][i] = (int64_t)(stats.nb_allocations - nb_allocations);
+    }
+
+    fprintf(fp, "%s    {\n      \"name\": \"%s\",\n", *first ? "" : ",\n", bench_scene->name);
+    fprintf(fp, "      \"load_ms\": %g,\n", (double)load_time / 1000.);
+    for (size_t i = 0; i < NB_MEASURES; i++)
+        print_measure(fp, measure_names[i], measures[i], s->nb_frames, i == MEASURE_ALLOCATIONS ? 1 : 1000);
+    fprintf(fp, "      \"pipelines\": %zu,\n", stats.nb_pipelines);
+    fprintf(fp, "      \"buffer_memory\": %zu,\n", stats.buffer_memory);
+    fprintf(fp, "      \"texture_memory\": %zu\n    }", stats.texture_memory);
+    *first = 0;
+
+end:
+    ngl_scene_unrefp(&scene);
+    ngl_freep(&ctx);
+    for (size_t i = 0; i < NB_MEASURES; i++)
+        free(measures[i]);
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    struct ctx s = {
+        .log_level          = NGL_LOG_WARNING,
+        .cfg.width          = DEFAULT_WIDTH,
+        .cfg.height         = DEFAULT_HEIGHT,
+        .cfg.offscreen      = 1,
+        .cfg.swap_interval  = -1,
+        .cfg.clear_color[3] = 1.f,
+        .cfg.stats          = 1,
+        .nb_frames          = 120,
+        .nb_warmup_frames   = 5,
+        .framerate          = 60,
+    };
+
+    int ret = opts_parse(argc, argc, argv, options, ARRAY_NB(options), &s);
+    if (ret < 0 || ret == OPT_HELP) {
+        opts_print_usage(argv[0], options, ARRAY_NB(options), NULL);
+        return ret == OPT_HELP ? 0 : EXIT_FAILURE;
+    }
+
+    ngl_log_set_min_level(s.log_level);
+
+    if (s.nb_frames <= 0 || s.nb_warmup_frames < 0 || s.framerate <= 0) {
+        fprintf(stderr, "the number of frames and the frame rate must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE *fp = stdout;
+    if (s.output && strcmp(s.output, "-")) {
+        fp = fopen(s.output, "w");
+        if (!fp) {
+            fprintf(stderr, "unable to open %s\n", s.output);
+            return EXIT_FAILURE;
+        }
+    }
+
+    int first = 1;
+    for (size_t i = 0; i < ARRAY_NB(bench_scenes); i++) {
+        const struct bench_scene *bench_scene = &bench_scenes[i];
+        if (s.scene && strcmp(s.scene, bench_scene->name))
+            continue;
+        fprintf(stderr, "running %s\n", bench_scene->name);
+        ret = run_scene(bench_scene, &s, fp, &first);
+        if (ret < 0)
+            break;
+    }
+
+    if (ret >= 0 && first) {
+        fprintf(stderr, "scene %s not found\n", s.scene);
+        ret = NGL_ERROR_NOT_FOUND;
+    }
+
+    if (!first)
+        fprintf(fp, "\n  ]\n}\n");
+
+    if (fp != stdout)
+        fclose(fp);
+
+    return ret < 0 ? EXIT_FAILURE : 0;
+}
@@ -33,19 +33,23 @@
 #define _POSIX_C_SOURCE 200112L // for struct addrinfo with glibc
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <direct.h>
 #define SHUT_RDWR SD_BOTH
+#define poll WSAPoll
 #else
 #include <sys/socket.h>
 #include <sys/utsname.h>
 #include <netdb.h>
+#include <poll.h>
 #include <unistd.h>
 #endif
 #include <sys/stat.h>
@@ -60,6 +64,34 @@
 #include "player.h"
 #include "pthread_compat.h"
 
+#define MAX_CLIENTS 32
+#define POLL_TIMEOUT 100 /* in milliseconds */
+#define STATS_PERIOD 500000 /* in microseconds */
+
+struct client {
+    int fd;
+    struct ipc_pkt *send_pkt;
+    struct ipc_pkt *recv_pkt;
+    size_t recv_size;
+    int stats;
+    char upload_ext[32];
+    FILE *upload_fp;
+    char upload_path[1024];
+    char upload_part_path[1024 + 8];
+    int64_t upload_size;
+    int64_t upload_offset;
+    uint64_t upload_hash;
+    uint64_t upload_cur_hash;
+};
+
+/* Accumulated by the player thread, protected by ctx.lock */
+struct frame_stats {
+    int64_t nb_frames;
+    int64_t draw_time;
+    int64_t max_draw_time;
+    double t;
+};
+
 struct ctx {
     /* options */
     const char *host;
@@ -81,10 +113,12 @@ struct ctx {
     pthread_t thread;
     int stop_order;
     int own_session_file;
-    struct ipc_pkt *send_pkt;
-    struct ipc_pkt *recv_pkt;
-    FILE *upload_fp;
-    char upload_path[1024];
+    struct frame_stats stats;
+
+    /* only accessed by the server thread */
+    struct client clients[MAX_CLIENTS];
+    size_t nb_clients;
+    int64_t stats_time;
 };
 
 #define OFFSET(x) offsetof(struct ctx, x)
@@ -134,6 +168,8 @@ static int send_player_signal(enum player_signal sig, const void *data, int data
     void *p = NULL;
     if (data_size) {
         p = malloc(data_size);
+        if (!p)
+            return NGL_ERROR_MEMORY;
         memcpy(p, data, data_size);
     }
 
@@ -144,8 +180,10 @@ static int send_player_signal(enum player_signal sig, const void *data, int data
             .data1 = p,
         },
     };
-    if (SDL_PushEvent(&event) != 1)
+    if (SDL_PushEvent(&event) != 1) {
         free(p);
+        return NGL_ERROR_EXTERNAL;
+    }
     return 0;
 }
 
@@ -153,8 +191,37 @@ static int handle_tag_scene(const uint8_t *data, int size)
 {
     if (size < 1 || data[size - 1] != 0) // check if string is nul-terminated
         return NGL_ERROR_INVALID_DATA;
-    const char *scene = (const char *)data;
-    return send_player_signal(PLAYER_SIGNAL_SCENE, scene, size);
+
+    /*
+     * The scene is deserialized by the server thread so that the player
+     * thread only has to switch to it; scenes sent in a row are queued
+     */
+    struct ngl_scene *scene = ngl_scene_create();
+    if (!scene)
+        return NGL_ERROR_MEMORY;
+    int ret = ngl_scene_init_from_str(scene, (const char *)data);
+    if (ret < 0)
+        goto fail;
+    ret = send_player_signal(PLAYER_SIGNAL_SCENE, &scene, sizeof(scene));
+    if (ret < 0)
+        goto fail;
+    return 0;
+
+fail:
+    ngl_scene_unrefp(&scene);
+    return ret;
+}
+
+static int handle_tag_livectl(const uint8_t *data, int size)
+{
+    if (size < 1 || data[size - 1] != 0) // check if string is nul-terminated
+        return NGL_ERROR_INVALID_DATA;
+    const char *livectl = (const char *)data;
+    if (!strchr(livectl, '=')) {
+        fprintf(stderr, "live control does not match \"id=value\" format\n");
+        return NGL_ERROR_INVALID_ARG;
+    }
+    return send_player_signal(PLAYER_SIGNAL_LIVECTL, livectl, size);
 }
 
 static int file_exists(const char *filename)
@@ -166,12 +233,12 @@ static int file_exists(const char *filename)
     return 1;
 }
 
-static int handle_tag_file(struct ctx *s, const uint8_t *data, int size)
+static int handle_tag_file(struct ctx *s, struct client *c, const uint8_t *data, int size)
 {
     if (size < 1 || data[size - 1] != 0) // check if string is nul-terminated
         return NGL_ERROR_INVALID_DATA;
 
-    if (s->upload_fp) {
+    if (c->upload_fp) {
         fprintf(stderr, "a file is already uploading");
         return NGL_ERROR_INVALID_USAGE;
     }
@@ -190,56 +257,173 @@ static int handle_tag_file(struct ctx *s, const uint8_t *data, int size)
         return NGL_ERROR_INVALID_ARG;
     }
 
-    int ret = snprintf(s->upload_path, sizeof(s->upload_path), "%s%s", s->files_dir, filename);
-    if (ret < 0 || ret >= sizeof(s->upload_path))
+    /*
+     * Files are stored according to their content (see IPC_FILEINFO), but
+     * the extension is preserved as it may be used to probe the file format
+     */
+    const char *ext = strrchr(filename, '.');
+    int ret = snprintf(c->upload_ext, sizeof(c->upload_ext), "%s", ext ? ext : "");
+    if (ret < 0 || ret >= sizeof(c->upload_ext))
         return NGL_ERROR_MEMORY;
 
-    const int exists = file_exists(s->upload_path);
-    if (exists)
-        return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
+    return 0;
+}
+
+static void close_upload_file(struct client *c)
+{
+    if (c->upload_fp)
+        fclose(c->upload_fp);
+    c->upload_fp = NULL;
+}
 
-    s->upload_fp = fopen(s->upload_path, "wb");
-    if (!s->upload_fp) {
-        perror(s->upload_path);
+static int finalize_upload(struct client *c)
+{
+    close_upload_file(c);
+
+    /* The hash is updated along with the parts, the file is not read again */
+    if (c->upload_cur_hash != c->upload_hash) {
+        fprintf(stderr, "checksum mismatch for %s, discarding it\n", c->upload_part_path);
+        remove(c->upload_part_path);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if (rename(c->upload_part_path, c->upload_path) < 0) {
+        perror("rename");
         return NGL_ERROR_IO;
     }
 
+    return ipc_pkt_add_rtag_fileend(c->send_pkt, c->upload_path);
+}
+
+static int is_uploading(const struct ctx *s, const char *path)
+{
+    for (size_t i = 0; i < s->nb_clients; i++) {
+        const struct client *c = &s->clients[i];
+        if (c->upload_fp && !strcmp(c->upload_path, path))
+            return 1;
+    }
     return 0;
 }
 
-static void close_upload_file(struct ctx *s)
+static int handle_tag_fileinfo(struct ctx *s, struct client *c, const uint8_t *data, int size)
 {
-    if (s->upload_fp)
-        fclose(s->upload_fp);
-    s->upload_fp = NULL;
+    if (size != 16)
+        return NGL_ERROR_INVALID_DATA;
+
+    if (c->upload_fp) {
+        fprintf(stderr, "a file is already uploading");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    c->upload_size = (int64_t)IPC_U64_READ(data);
+    c->upload_hash = IPC_U64_READ(data + 8);
+    if (c->upload_size < 0)
+        return NGL_ERROR_INVALID_DATA;
+
+    int ret = snprintf(c->upload_path, sizeof(c->upload_path), "%s%016" PRIx64 "%s",
+                       s->files_dir, c->upload_hash, c->upload_ext);
+    if (ret < 0 || ret >= sizeof(c->upload_path))
+        return NGL_ERROR_MEMORY;
+    ret = snprintf(c->upload_part_path, sizeof(c->upload_part_path), "%s.part", c->upload_path);
+    if (ret < 0 || ret >= sizeof(c->upload_part_path))
+        return NGL_ERROR_MEMORY;
+
+    /* The content is already available, possibly from a previous session */
+    if (file_exists(c->upload_path))
+        return ipc_pkt_add_rtag_fileend(c->send_pkt, c->upload_path);
+
+    if (is_uploading(s, c->upload_path)) {
+        fprintf(stderr, "%s is already being uploaded by another client\n", c->upload_path);
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    /*
+     * Parts are only written once verified, so any partial file left by an
+     * interrupted upload is a valid prefix of the content to resume from
+     */
+    c->upload_fp = fopen(c->upload_part_path, "a+b");
+    if (!c->upload_fp) {
+        perror(c->upload_part_path);
+        return NGL_ERROR_IO;
+    }
+    if (fseek64(c->upload_fp, 0, SEEK_END) < 0) {
+        perror("fseek64");
+        close_upload_file(c);
+        return NGL_ERROR_IO;
+    }
+    c->upload_offset = ftell64(c->upload_fp);
+    c->upload_cur_hash = IPC_HASH_INIT;
+    if (c->upload_offset < 0 || c->upload_offset > c->upload_size) {
+        close_upload_file(c);
+        c->upload_fp = fopen(c->upload_part_path, "w+b");
+        if (!c->upload_fp) {
+            perror(c->upload_part_path);
+            return NGL_ERROR_IO;
+        }
+        c->upload_offset = 0;
+    } else if (c->upload_offset) {
+        ret = ipc_hash_file(c->upload_fp, &c->upload_cur_hash);
+        if (ret < 0) {
+            close_upload_file(c);
+            return ret;
+        }
+    }
+
+    if (c->upload_offset == c->upload_size)
+        return finalize_upload(c);
+
+    if (c->upload_offset)
+        fprintf(stderr, "resuming upload of %s at offset %" PRId64 "\n", c->upload_path, c->upload_offset);
+    return ipc_pkt_add_rtag_fileoffset(c->send_pkt, c->upload_offset);
 }
 
-static int handle_tag_filepart(struct ctx *s, const uint8_t *data, int size)
+static int handle_tag_filepart(struct client *c, const uint8_t *data, int size)
 {
-    if (!s->upload_fp) {
+    if (!c->upload_fp) {
         fprintf(stderr, "file is not opened\n");
         return NGL_ERROR_INVALID_USAGE;
     }
 
-    if (!size) {
-        close_upload_file(s);
-        return ipc_pkt_add_rtag_fileend(s->send_pkt, s->upload_path);
+    if (size < 16)
+        return NGL_ERROR_INVALID_DATA;
+
+    const int64_t offset = (int64_t)IPC_U64_READ(data);
+    const uint64_t checksum = IPC_U64_READ(data + 8);
+    const uint8_t *chunk = data + 16;
+    const int chunk_size = size - 16;
+
+    if (offset != c->upload_offset || chunk_size > c->upload_size - c->upload_offset) {
+        fprintf(stderr, "unexpected file part at offset %" PRId64 " (expected %" PRId64 ")\n",
+                offset, c->upload_offset);
+        close_upload_file(c);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if (ipc_hash(IPC_HASH_INIT, chunk, chunk_size) != checksum) {
+        fprintf(stderr, "checksum mismatch for file part at offset %" PRId64 "\n", offset);
+        close_upload_file(c);
+        return NGL_ERROR_INVALID_DATA;
     }
 
-    const size_t n = fwrite(data, 1, size, s->upload_fp);
-    if (ferror(s->upload_fp)) {
+    const size_t n = fwrite(chunk, 1, chunk_size, c->upload_fp);
+    if (ferror(c->upload_fp)) {
         perror("fwrite");
-        close_upload_file(s);
+        close_upload_file(c);
         return NGL_ERROR_IO;
     }
     // XXX: should we loop instead?
-    if (n != size) {
-        fprintf(stderr, "unable to write file part: %zu/%d written\n", n, size);
-        close_upload_file(s);
+    if (n != chunk_size) {
+        fprintf(stderr, "unable to write file part: %zu/%d written\n", n, chunk_size);
+        close_upload_file(c);
         return NGL_ERROR_IO;
     }
+    c->upload_offset += chunk_size;
+    c->upload_cur_hash = ipc_hash(c->upload_cur_hash, chunk, chunk_size);
+
+    if (c->upload_offset == c->upload_size)
+        return finalize_upload(c);
 
-    return ipc_pkt_add_rtag_filepart(s->send_pkt, size);
+    return 0;
 }
 
 static int handle_tag_clearcolor(const uint8_t *data, int size)
@@ -264,7 +448,7 @@ static int handle_tag_reconfigure(const uint8_t *data, int size)
     return 0;
 }
 
-static int handle_tag_info(const uint8_t *data, int size, int fd, struct ctx *s)
+static int handle_tag_info(struct ctx *s, struct client *c, const uint8_t *data, int size)
 {
     if (size != 0)
         return NGL_ERROR_INVALID_DATA;
@@ -286,73 +470,96 @@ static int handle_tag_info(const uint8_t *data, int size, int fd, struct ctx *s)
 
     char info[256];
     snprintf(info, sizeof(info), "backend=%s\nsystem=%s\n", backend.string_id, sysname);
-    ret = ipc_pkt_add_rtag_info(s->send_pkt, info);
+    ret = ipc_pkt_add_rtag_info(c->send_pkt, info);
 
 end:
     ngl_reset_backend(&backend);
     return ret;
 }
 
-static int handle_commands(struct ctx *s, int fd)
+static int handle_tag_stats(struct client *c, const uint8_t *data, int size)
 {
-    for (;;) {
-        ipc_pkt_reset(s->send_pkt);
+    if (size != 0)
+        return NGL_ERROR_INVALID_DATA;
+    c->stats = 1;
+    return 0;
+}
 
-        int ret = ipc_recv(fd, s->recv_pkt);
-        if (ret <= 0)
-            return ret;
+static int handle_packet(struct ctx *s, struct client *c)
+{
+    ipc_pkt_reset(c->send_pkt);
+
+    int ret = 0;
+    int need_reconfigure = 0;
+    int has_filepart = 0;
+    const uint8_t *data = c->recv_pkt->data + 8;
+    size_t data_size = c->recv_pkt->size - 8;
+    while (data_size) {
+        if (data_size < 8)
+            return NGL_ERROR_INVALID_DATA;
+
+        const enum ipc_tag tag = IPC_U32_READ(data);
+        const int size         = IPC_U32_READ(data + 4);
 
-        if (s->recv_pkt->size < 8)
+        data += 8;
+        data_size -= 8;
+
+        if (size < 0 || size > data_size)
             return NGL_ERROR_INVALID_DATA;
 
-        int need_reconfigure = 0;
-        const uint8_t *data = s->recv_pkt->data + 8;
-        size_t data_size = s->recv_pkt->size - 8;
-        while (data_size) {
-            if (data_size < 8)
-                return NGL_ERROR_INVALID_DATA;
-
-            const enum ipc_tag tag = IPC_U32_READ(data);
-            const int size         = IPC_U32_READ(data + 4);
-
-            data += 8;
-            data_size -= 8;
-
-            if (size < 0 || size > data_size)
-                return NGL_ERROR_INVALID_DATA;
-
-            need_reconfigure |= tag == IPC_CLEARCOLOR || tag == IPC_SAMPLES || tag == IPC_RECONFIGURE;
-
-            switch (tag) {
-            case IPC_SCENE:        ret = handle_tag_scene(data, size);        break;
-            case IPC_FILE:         ret = handle_tag_file(s, data, size);      break;
-            case IPC_FILEPART:     ret = handle_tag_filepart(s, data, size);  break;
-            case IPC_CLEARCOLOR:   ret = handle_tag_clearcolor(data, size);   break;
-            case IPC_SAMPLES:      ret = handle_tag_samples(data, size);      break;
-            case IPC_RECONFIGURE:  ret = handle_tag_reconfigure(data, size);  break;
-            case IPC_INFO:         ret = handle_tag_info(data, size, fd, s);  break;
-            default:
-                fprintf(stderr, "unrecognized query tag %c%c%c%c\n", IPC_U32_FMT(tag));
-                return NGL_ERROR_INVALID_DATA;
-            }
-            if (ret < 0) {
-                fprintf(stderr, "failed to handle query tag %c%c%c%c of size %d\n", IPC_U32_FMT(tag), size);
-                return ret;
-            }
-            data += size;
-            data_size -= size;
+        need_reconfigure |= tag == IPC_CLEARCOLOR || tag == IPC_SAMPLES || tag == IPC_RECONFIGURE;
+        has_filepart |= tag == IPC_FILEPART;
+
+        switch (tag) {
+        case IPC_SCENE:        ret = handle_tag_scene(data, size);          break;
+        case IPC_LIVECTL:      ret = handle_tag_livectl(data, size);        break;
+        case IPC_FILE:         ret = handle_tag_file(s, c, data, size);     break;
+        case IPC_FILEINFO:     ret = handle_tag_fileinfo(s, c, data, size); break;
+        case IPC_FILEPART:     ret = handle_tag_filepart(c, data, size);    break;
+        case IPC_CLEARCOLOR:   ret = handle_tag_clearcolor(data, size);     break;
+        case IPC_SAMPLES:      ret = handle_tag_samples(data, size);        break;
+        case IPC_RECONFIGURE:  ret = handle_tag_reconfigure(data, size);    break;
+        case IPC_INFO:         ret = handle_tag_info(s, c, data, size);     break;
+        case IPC_STATS:        ret = handle_tag_stats(c, data, size);       break;
+        default:
+            fprintf(stderr, "unrecognized query tag %c%c%c%c\n", IPC_U32_FMT(tag));
+            return NGL_ERROR_INVALID_DATA;
         }
-
-        if (need_reconfigure) {
-            ret = send_player_signal(PLAYER_SIGNAL_RECONFIGURE, NULL, 0);
-            if (ret < 0)
-                return ret;
+        if (ret < 0) {
+            fprintf(stderr, "failed to handle query tag %c%c%c%c of size %d\n", IPC_U32_FMT(tag), size);
+            return ret;
         }
+        data += size;
+        data_size -= size;
+    }
 
-        ret = ipc_send(fd, s->send_pkt);
+    if (need_reconfigure) {
+        ret = send_player_signal(PLAYER_SIGNAL_RECONFIGURE, NULL, 0);
         if (ret < 0)
             return ret;
     }
+
+    /*
+     * File parts are streamed by the client without waiting for any
+     * acknowledgement, only the last one gets a response
+     */
+    if (has_filepart && c->send_pkt->size == 8)
+        return 0;
+
+    return ipc_send(c->fd, c->send_pkt);
+}
+
+/*
+ * Only the data available on the socket is read, so that a client in the
+ * middle of a large transfer does not hold the other ones
+ */
+static int handle_client_data(struct ctx *s, struct client *c)
+{
+    int ret = ipc_recv_partial(c->fd, c->recv_pkt, &c->recv_size);
+    if (ret <= 0)
+        return ret;
+    c->recv_size = 0;
+    return handle_packet(s, c);
 }
 
 static void close_socket(int socket)
@@ -382,41 +589,171 @@ static void close_socket(int socket)
 #endif
 }
 
-static void close_conn(struct ctx *s, int conn_fd)
+static void close_conn(struct client *c)
 {
-    close_socket(conn_fd);
-    fprintf(stderr, "<< client %d disconnected\n", conn_fd);
+    close_socket(c->fd);
+    fprintf(stderr, "<< client %d disconnected\n", c->fd);
+
+    /*
+     * Close the uploading file when the connection ends; the partial file is
+     * kept so that the upload can be resumed by a later connection
+     */
+    close_upload_file(c);
 
-    /* close uploading file when the connection ends */
-    close_upload_file(s);
+    ipc_pkt_freep(&c->send_pkt);
+    ipc_pkt_freep(&c->recv_pkt);
 }
 
+static void remove_client(struct ctx *s, size_t index)
+{
+    close_conn(&s->clients[index]);
+    s->clients[index] = s->clients[--s->nb_clients];
+}
+
+static void accept_client(struct ctx *s)
+{
+    const int conn_fd = accept(s->sock_fd, NULL, NULL);
+    if (conn_fd < 0) {
+        perror("accept");
+        return;
+    }
+
+    if (s->nb_clients == MAX_CLIENTS) {
+        fprintf(stderr, "unable to accept client %d: too many clients\n", conn_fd);
+        close_socket(conn_fd);
+        return;
+    }
+
+    struct client *c = &s->clients[s->nb_clients];
+    *c = (struct client){
+        .fd       = conn_fd,
+        .send_pkt = ipc_pkt_create(),
+        .recv_pkt = ipc_pkt_create(),
+    };
+    if (!c->send_pkt || !c->recv_pkt) {
+        fprintf(stderr, "unable to accept client %d\n", conn_fd);
+        close_conn(c);
+        return;
+    }
+    s->nb_clients++;
+    fprintf(stderr, ">> accepted client %d\n", conn_fd);
+}
+
+static void draw_callback(void *user_arg, double t, int64_t draw_time)
+{
+    struct ctx *s = user_arg;
+    pthread_mutex_lock(&s->lock);
+    struct frame_stats *stats = &s->stats;
+    stats->nb_frames++;
+    stats->draw_time += draw_time;
+    if (draw_time > stats->max_draw_time)
+        stats->max_draw_time = draw_time;
+    stats->t = t;
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void push_stats(struct ctx *s)
+{
+    const int64_t now = gettime_relative();
+    const int64_t elapsed = now - s->stats_time;
+    if (elapsed < STATS_PERIOD)
+        return;
+    s->stats_time = now;
+
+    pthread_mutex_lock(&s->lock);
+    const struct frame_stats stats = s->stats;
+    memset(&s->stats, 0, sizeof(s->stats));
+    pthread_mutex_unlock(&s->lock);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "time=%f\nfps=%.2f\ndraw_avg_ms=%.3f\ndraw_max_ms=%.3f\n",
+             stats.t, stats.nb_frames * 1000000.0 / elapsed,
+             stats.nb_frames ? stats.draw_time / 1000.0 / stats.nb_frames : 0.0,
+             stats.max_draw_time / 1000.0);
+
+    for (size_t i = s->nb_clients; i > 0; i--) {
+        struct client *c = &s->clients[i - 1];
+        if (!c->stats)
+            continue;
+
+        ipc_pkt_reset(c->send_pkt);
+        int ret = ipc_pkt_add_rtag_stats(c->send_pkt, buf);
+        if (ret >= 0)
+            ret = ipc_send(c->fd, c->send_pkt);
+        if (ret < 0)
+            remove_client(s, i - 1);
+    }
+}
+
+static int should_stop(struct ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    int stop = s->stop_order;
+    pthread_mutex_unlock(&s->lock);
+    return stop;
+}
+
+/*
+ * All the clients are served by this thread, waiting for any of them (or a
+ * new connection) to have data available. The wait is bounded so that the
+ * stop order and the statistics push are honored in time.
+ */
 static void *server_start(void *arg)
 {
     struct ctx *s = arg;
 
-    for (;;) {
-        const int conn_fd = accept(s->sock_fd, NULL, NULL);
-        if (conn_fd < 0) {
-            perror("accept");
+    s->stats_time = gettime_relative();
+
+    while (!should_stop(s)) {
+        struct pollfd fds[1 + MAX_CLIENTS] = {
+            {.fd = s->sock_fd, .events = POLLIN},
+        };
+        for (size_t i = 0; i < s->nb_clients; i++)
+            fds[1 + i] = (struct pollfd){.fd = s->clients[i].fd, .events = POLLIN};
+
+        const int n = poll(fds, (unsigned)(1 + s->nb_clients), POLL_TIMEOUT);
+        if (n < 0) {
+#ifndef _WIN32
+            if (errno == EINTR)
+                continue;
+#endif
+            perror("poll");
             break;
         }
-        fprintf(stderr, ">> accepted client %d\n", conn_fd);
 
-        pthread_mutex_lock(&s->lock);
-        int stop = s->stop_order;
-        pthread_mutex_unlock(&s->lock);
-        if (stop) {
-            close_conn(s, conn_fd);
+        if (should_stop(s))
             break;
+
+        /*
+         * Backward iteration because a removed client is replaced by the
+         * last one, which has then already been handled
+         */
+        for (size_t i = s->nb_clients; i > 0; i--) {
+            struct client *c = &s->clients[i - 1];
+            const short revents = fds[i].revents;
+            if (!revents)
+                continue;
+
+            int ret = handle_client_data(s, c);
+            if (ret < 0) {
+                if (ret != NGL_ERROR_IO)
+                    fprintf(stderr, "client %d: error %d\n", c->fd, ret);
+                remove_client(s, i - 1);
+            }
         }
 
-        int ret = handle_commands(s, conn_fd);
-        if (ret < 0)
-            fprintf(stderr, "client %d: error %d\n", conn_fd, ret);
-        close_conn(s, conn_fd);
+        if (fds[0].revents & POLLIN)
+            accept_client(s);
+        else if (fds[0].revents)
+            break;
+
+        push_stats(s);
     }
 
+    while (s->nb_clients)
+        remove_client(s, s->nb_clients - 1);
+
     return NULL;
 }
 
@@ -637,12 +974,10 @@ int main(int argc, char *argv[])
         return ret == OPT_HELP ? 0 : EXIT_FAILURE;
     }
 
-    s.send_pkt = ipc_pkt_create();
-    s.recv_pkt = ipc_pkt_create();
-    if (!s.send_pkt || !s.recv_pkt) {
-        ret = EXIT_FAILURE;
-        goto end;
-    }
+#ifndef _WIN32
+    /* A client disconnecting must not kill the server while sending to it */
+    signal(SIGPIPE, SIG_IGN);
+#endif
 
     ngl_log_set_min_level(s.log_level);
 
@@ -667,6 +1002,9 @@ int main(int argc, char *argv[])
     if (ret < 0)
         goto end;
 
+    s.p.draw_callback = draw_callback;
+    s.p.draw_callback_arg = &s;
+
     player_main_loop(&s.p);
 
 end:
@@ -688,9 +1026,6 @@ end:
 
     pthread_mutex_destroy(&s.lock);
 
-    ipc_pkt_freep(&s.send_pkt);
-    ipc_pkt_freep(&s.recv_pkt);
-
     player_uninit(&s.p);
 
     return ret;
@@ -35,6 +35,7 @@
 #include <netdb.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <signal.h>
 #endif
 
 #include <nopegl/nopegl.h>
@@ -44,36 +45,60 @@
 #include "opts.h"
 
 #define UPLOAD_CHUNK_SIZE (1024 * 1024)
+#define MAX_RECONNECTS 3
 
 struct ctx {
     /* options */
     const char *host;
     const char *port;
     const char *scene;
+    const char **livectls;
+    size_t nb_livectls;
     int show_info;
     const char *uploadfile;
     float clear_color[4];
     int32_t samples;
     int reconfigure;
+    int stats;
 
+    struct ipc_pkt *query_pkt;
     struct ipc_pkt *send_pkt;
     struct ipc_pkt *recv_pkt;
     FILE *upload_fp;
     uint8_t *upload_buffer;
     int64_t upload_size;
-    int64_t uploaded_size;
+    int64_t upload_offset;
+    int upload_started;
 };
 
+static int opt_livectl(const char *arg, void *dst)
+{
+    uint8_t *cur_livectls_p = dst;
+    uint8_t *nb_cur_livectls_p = cur_livectls_p + sizeof(const char **);
+    const char **cur_livectls = *(const char ***)cur_livectls_p;
+    const size_t nb_cur_livectls = *(size_t *)nb_cur_livectls_p;
+    const size_t nb_new_livectls = nb_cur_livectls + 1;
+    const char **new_livectls = realloc(cur_livectls, nb_new_livectls * sizeof(*new_livectls));
+    if (!new_livectls)
+        return NGL_ERROR_MEMORY;
+    new_livectls[nb_cur_livectls] = arg;
+    memcpy(dst, &new_livectls, sizeof(new_livectls));
+    *(size_t *)nb_cur_livectls_p = nb_new_livectls;
+    return 0;
+}
+
 #define OFFSET(x) offsetof(struct ctx, x)
 static const struct opt options[] = {
     {"-x", "--host",          OPT_TYPE_STR,      .offset=OFFSET(host)},
     {"-p", "--port",          OPT_TYPE_STR,      .offset=OFFSET(port)},
     {"-f", "--scene",         OPT_TYPE_STR,      .offset=OFFSET(scene)},
+    {"-l", "--livectl",       OPT_TYPE_CUSTOM,   .offset=OFFSET(livectls), .func=opt_livectl},
     {"-?", "--info",          OPT_TYPE_TOGGLE,   .offset=OFFSET(show_info)},
     {"-u", "--uploadfile",    OPT_TYPE_STR,      .offset=OFFSET(uploadfile)},
     {"-c", "--clearcolor",    OPT_TYPE_COLOR,    .offset=OFFSET(clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(samples)},
     {"-g", "--reconfigure",   OPT_TYPE_TOGGLE,   .offset=OFFSET(reconfigure)},
+    {"-s", "--stats",         OPT_TYPE_TOGGLE,   .offset=OFFSET(stats)},
 };
 
 static int get_filesize(const char *filename, int64_t *size)
@@ -114,6 +139,17 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
             return ret;
     }
 
+    for (size_t i = 0; i < s->nb_livectls; i++) {
+        const char *livectl = s->livectls[i];
+        if (!strchr(livectl, '=')) {
+            fprintf(stderr, "live control does not match \"id=value\" format\n");
+            return NGL_ERROR_INVALID_ARG;
+        }
+        int ret = ipc_pkt_add_qtag_livectl(pkt, livectl);
+        if (ret < 0)
+            return ret;
+    }
+
     if (s->uploadfile) {
         char name[512];
         const size_t name_len = strcspn(s->uploadfile, "=");
@@ -145,9 +181,14 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
         if (!s->upload_buffer)
             return NGL_ERROR_MEMORY;
 
-        ret = ipc_pkt_add_qtag_file(pkt, name);
+        uint64_t hash;
+        ret = ipc_hash_file(s->upload_fp, &hash);
         if (ret < 0)
             return ret;
+
+        if ((ret = ipc_pkt_add_qtag_file(pkt, name)) < 0 ||
+            (ret = ipc_pkt_add_qtag_fileinfo(pkt, s->upload_size, hash)) < 0)
+            return ret;
     }
 
     if (s->clear_color[0] >= 0.) {
@@ -174,6 +215,12 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
             return ret;
     }
 
+    if (s->stats) {
+        int ret = ipc_pkt_add_qtag_stats(pkt);
+        if (ret < 0)
+            return ret;
+    }
+
     return 0;
 }
 
@@ -195,14 +242,26 @@ static int handle_info(const uint8_t *data, int size)
     return 0;
 }
 
-static int handle_filepart(struct ctx *s, const uint8_t *data, int size)
+static void print_upload_progress(const struct ctx *s)
 {
-    if (size != 4)
-        return NGL_ERROR_INVALID_DATA;
-    const int written = IPC_U32_READ(data);
-    s->uploaded_size += written;
-    const int progress = s->upload_size ? (int)(s->uploaded_size * 100LL / s->upload_size) : 100;
+    const int progress = s->upload_size ? (int)(s->upload_offset * 100LL / s->upload_size) : 100;
     fprintf(stderr, "\ruploading %s... %d%%", s->uploadfile, progress);
+}
+
+static int handle_fileoffset(struct ctx *s, const uint8_t *data, int size)
+{
+    if (size != 8 || !s->upload_fp)
+        return NGL_ERROR_INVALID_DATA;
+    const int64_t offset = (int64_t)IPC_U64_READ(data);
+    if (offset < 0 || offset > s->upload_size)
+        return NGL_ERROR_INVALID_DATA;
+    if (fseek64(s->upload_fp, offset, SEEK_SET) < 0) {
+        perror("fseek64");
+        return NGL_ERROR_IO;
+    }
+    s->upload_offset = offset;
+    s->upload_started = 1;
+    print_upload_progress(s);
     return 0;
 }
 
@@ -239,9 +298,10 @@ static int handle_response(struct ctx *s, const struct ipc_pkt *pkt)
 
         int ret;
         switch (tag) {
-        case IPC_INFO:      ret = handle_info(data, size);        break;
-        case IPC_FILEPART:  ret = handle_filepart(s, data, size); break;
-        case IPC_FILEEND:   ret = handle_fileend(s, data, size);  break;
+        case IPC_INFO:       ret = handle_info(data, size);          break;
+        case IPC_FILEOFFSET: ret = handle_fileoffset(s, data, size); break;
+        case IPC_FILEEND:    ret = handle_fileend(s, data, size);    break;
+        case IPC_STATS:      ret = handle_info(data, size);          break;
         default:
             fprintf(stderr, "unrecognized response tag %c%c%c%c\n", IPC_U32_FMT(tag));
             return NGL_ERROR_INVALID_DATA;
@@ -254,13 +314,78 @@ static int handle_response(struct ctx *s, const struct ipc_pkt *pkt)
         data_size -= size;
     }
 
-    if (s->upload_fp) {
-        ipc_pkt_reset(s->send_pkt);
+    return 0;
+}
+
+static int recv_response(struct ctx *s, int fd)
+{
+    int ret = ipc_recv(fd, s->recv_pkt);
+    if (ret < 0)
+        return ret;
+    if (ret == 0) {
+        fprintf(stderr, "connection closed by the server\n");
+        return NGL_ERROR_IO;
+    }
+    return handle_response(s, s->recv_pkt);
+}
 
+/*
+ * Stream all the remaining file parts without waiting for any
+ * acknowledgement, the server only replies once the upload is complete
+ */
+static int upload_file(struct ctx *s, int fd)
+{
+    while (s->upload_offset < s->upload_size) {
         const size_t n = fread(s->upload_buffer, 1, UPLOAD_CHUNK_SIZE, s->upload_fp);
         if (ferror(s->upload_fp))
             return NGL_ERROR_IO;
-        int ret = ipc_pkt_add_qtag_filepart(s->send_pkt, s->upload_buffer, n);
+        if (!n) {
+            fprintf(stderr, "%s: unexpected end of file\n", s->uploadfile);
+            return NGL_ERROR_INVALID_DATA;
+        }
+
+        ipc_pkt_reset(s->send_pkt);
+        int ret = ipc_pkt_add_qtag_filepart(s->send_pkt, s->upload_offset, s->upload_buffer, n);
+        if (ret < 0)
+            return ret;
+        ret = ipc_send(fd, s->send_pkt);
+        if (ret < 0)
+            return ret;
+
+        s->upload_offset += n;
+        print_upload_progress(s);
+    }
+
+    return recv_response(s, fd);
+}
+
+static int run_session(struct ctx *s, int fd)
+{
+    int ret = ipc_send(fd, s->query_pkt);
+    if (ret < 0)
+        return ret;
+
+    ret = recv_response(s, fd);
+    if (ret < 0)
+        return ret;
+
+    if (s->upload_fp) {
+        if (!s->upload_started) {
+            fprintf(stderr, "no upload offset received\n");
+            return NGL_ERROR_INVALID_DATA;
+        }
+        ret = upload_file(s, fd);
+        if (ret < 0)
+            return ret;
+        if (s->upload_fp) {
+            fprintf(stderr, "upload did not complete\n");
+            return NGL_ERROR_INVALID_DATA;
+        }
+    }
+
+    /* The statistics are pushed by the server until the connection is closed */
+    while (s->stats) {
+        ret = recv_response(s, fd);
         if (ret < 0)
             return ret;
     }
@@ -268,6 +393,34 @@ static int handle_response(struct ctx *s, const struct ipc_pkt *pkt)
     return 0;
 }
 
+static void close_fd(int fd)
+{
+#ifdef _WIN32
+    closesocket(fd);
+#else
+    close(fd);
+#endif
+}
+
+static int connect_to_host(const struct ctx *s, const struct addrinfo *addr_info, int *fdp)
+{
+    for (const struct addrinfo *rp = addr_info; rp; rp = rp->ai_next) {
+        const int fd = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        if (fd < 0)
+            continue;
+
+        if (connect(fd, rp->ai_addr, rp->ai_addrlen) != -1) {
+            *fdp = fd;
+            return 0;
+        }
+
+        close_fd(fd);
+    }
+
+    fprintf(stderr, "unable to connect to %s\n", s->host);
+    return NGL_ERROR_IO;
+}
+
 int main(int argc, char *argv[])
 {
     struct ctx s = {
@@ -290,19 +443,22 @@ int main(int argc, char *argv[])
         fprintf(stderr, "WSAStartup: failed with %d\n", sret);
         return NGL_ERROR_IO;
     }
+#else
+    /* A server dropping the connection must not kill us before resuming the upload */
+    signal(SIGPIPE, SIG_IGN);
 #endif
 
     struct addrinfo *addr_info = NULL;
-    int fd = -1;
 
+    s.query_pkt = ipc_pkt_create();
     s.send_pkt = ipc_pkt_create();
     s.recv_pkt = ipc_pkt_create();
-    if (!s.send_pkt || !s.recv_pkt) {
+    if (!s.query_pkt || !s.send_pkt || !s.recv_pkt) {
         ret = NGL_ERROR_MEMORY;
         goto end;
     }
 
-    ret = craft_packet(&s, s.send_pkt);
+    ret = craft_packet(&s, s.query_pkt);
     if (ret < 0)
         goto end;
 
@@ -318,56 +474,35 @@ int main(int argc, char *argv[])
         goto end;
     }
 
-    struct addrinfo *rp;
-    for (rp = addr_info; rp; rp = rp->ai_next) {
-        fd = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
-        if (fd < 0)
-            continue;
+    /*
+     * If the connection is lost during an upload, the same query is sent
+     * again: the server replies with the offset it has reached so far and
+     * the upload resumes from there
+     */
+    for (int i = 0; i <= MAX_RECONNECTS; i++) {
+        int fd = -1;
+        ret = connect_to_host(&s, addr_info, &fd);
+        if (ret < 0) {
+            ret = EXIT_FAILURE;
+            goto end;
+        }
 
-        ret = connect(fd, rp->ai_addr, rp->ai_addrlen);
-        if (ret != -1)
+        ret = run_session(&s, fd);
+        close_fd(fd);
+        if (ret != NGL_ERROR_IO || !s.upload_started || !s.upload_fp)
             break;
 
-#ifdef _WIN32
-        closesocket(fd);
-#else
-        close(fd);
-#endif
-        fd = -1;
-    }
-
-    if (!rp) {
-        fprintf(stderr, "unable to connect to %s\n", s.host);
-        ret = EXIT_FAILURE;
-        goto end;
+        fprintf(stderr, "\nconnection lost, resuming upload of %s\n", s.uploadfile);
+        s.upload_started = 0;
     }
 
-    do {
-        ret = ipc_send(fd, s.send_pkt);
-        if (ret < 0)
-            goto end;
-
-        ret = ipc_recv(fd, s.recv_pkt);
-        if (ret < 0)
-            goto end;
-
-        ret = handle_response(&s, s.recv_pkt);
-        if (ret < 0)
-            goto end;
-
-    } while (s.upload_fp);
-
 end:
     if (addr_info)
         freeaddrinfo(addr_info);
     close_upload_file(&s);
+    free(s.livectls);
+    ipc_pkt_freep(&s.query_pkt);
     ipc_pkt_freep(&s.send_pkt);
     ipc_pkt_freep(&s.recv_pkt);
-    if (fd != -1)
-#ifdef _WIN32
-        closesocket(fd);
-#else
-        close(fd);
-#endif
     return ret;
 }
@@ -57,6 +57,7 @@ static const struct opt options[] = {
     {NULL, "--hwaccel",          OPT_TYPE_INT,      .offset=OFFSET(hwaccel)},
     {NULL, "--mipmap",           OPT_TYPE_INT,      .offset=OFFSET(mipmap)},
     {NULL, "--debug",            OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
+    {NULL, "--trace",            OPT_TYPE_STR,      .offset=OFFSET(cfg.trace_filename)},
 };
 
 static struct ngl_scene *get_scene(const struct ctx *s, const char *filename)
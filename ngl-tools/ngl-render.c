@@ -113,6 +113,7 @@ static const struct opt options[] = {
     {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
     {NULL, "--debug",         OPT_TYPE_TOGGLE,   .offset=OFFSET(cfg.debug)},
+    {NULL, "--trace",         OPT_TYPE_STR,      .offset=OFFSET(cfg.trace_filename)},
 };
 
 int main(int argc, char *argv[])
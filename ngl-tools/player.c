@@ -114,8 +114,15 @@ end:
     return ret;
 }
 
+static void reset_livectls(struct player *p)
+{
+    ngl_livectls_freep(&p->livectls);
+    p->nb_livectls = 0;
+}
+
 static void kill_scene(struct player *p)
 {
+    reset_livectls(p);
     ngl_set_scene(p->ngl, NULL);
     p->pgbar_opacity_node  = NULL;
     p->pgbar_duration_node = NULL;
@@ -423,11 +430,16 @@ static int set_scene(struct player *p, struct ngl_scene *scene)
         if (ret < 0)
             return ret;
     }
+    reset_livectls(p);
     ret = ngl_set_scene(p->ngl, scene);
     if (ret < 0) {
         p->pgbar_opacity_node  = NULL;
         p->pgbar_duration_node = NULL;
         p->pgbar_text_node     = NULL;
+    } else {
+        ret = ngl_livectls_get(scene, &p->nb_livectls, &p->livectls);
+        if (ret < 0)
+            return ret;
     }
 
     const struct ngl_scene_params *params = ngl_scene_get_params(scene);
@@ -507,10 +519,15 @@ void player_uninit(struct player *p)
         return;
 
     SDL_Event event;
-    while (SDL_PollEvent(&event))
-        if (event.type == SDL_USEREVENT)
-            free(event.user.data1);
+    while (SDL_PollEvent(&event)) {
+        if (event.type != SDL_USEREVENT)
+            continue;
+        if (event.user.code == PLAYER_SIGNAL_SCENE)
+            ngl_scene_unrefp(event.user.data1);
+        free(event.user.data1);
+    }
 
+    reset_livectls(p);
     ngl_freep(&p->ngl);
     SDL_DestroyWindow(p->window);
     SDL_Quit();
@@ -518,14 +535,8 @@ void player_uninit(struct player *p)
 
 static int handle_scene(struct player *p, const void *data)
 {
-    struct ngl_scene *scene = ngl_scene_create();
-    if (!scene)
-        return NGL_ERROR_MEMORY;
-    int ret = ngl_scene_init_from_str(scene, data);
-    if (ret < 0)
-        goto end;
-    ret = set_scene(p, scene);
-end:
+    struct ngl_scene *scene = *(struct ngl_scene **)data;
+    int ret = set_scene(p, scene);
     ngl_scene_unrefp(&scene);
     return ret;
 }
@@ -558,6 +569,151 @@ static int handle_reconfigure(struct player *p, const void *data)
     return ngl_configure(p->ngl, &p->ngl_config);
 }
 
+enum livectl_type {
+    LIVECTL_TYPE_F32,
+    LIVECTL_TYPE_I32,
+    LIVECTL_TYPE_U32,
+    LIVECTL_TYPE_BOOL,
+    LIVECTL_TYPE_STR,
+};
+
+static const struct livectl_spec {
+    uint32_t node_type;
+    const char *key;
+    enum livectl_type type;
+    size_t nb_comps;
+} livectl_specs[] = {
+    {NGL_NODE_TEXT,          "text",   LIVECTL_TYPE_STR,   1},
+    {NGL_NODE_UNIFORMBOOL,   "value",  LIVECTL_TYPE_BOOL,  1},
+    {NGL_NODE_UNIFORMCOLOR,  "value",  LIVECTL_TYPE_F32,   3},
+    {NGL_NODE_UNIFORMFLOAT,  "value",  LIVECTL_TYPE_F32,   1},
+    {NGL_NODE_UNIFORMINT,    "value",  LIVECTL_TYPE_I32,   1},
+    {NGL_NODE_UNIFORMIVEC2,  "value",  LIVECTL_TYPE_I32,   2},
+    {NGL_NODE_UNIFORMIVEC3,  "value",  LIVECTL_TYPE_I32,   3},
+    {NGL_NODE_UNIFORMIVEC4,  "value",  LIVECTL_TYPE_I32,   4},
+    {NGL_NODE_UNIFORMMAT4,   "value",  LIVECTL_TYPE_F32,   16},
+    {NGL_NODE_UNIFORMQUAT,   "value",  LIVECTL_TYPE_F32,   4},
+    {NGL_NODE_UNIFORMUINT,   "value",  LIVECTL_TYPE_U32,   1},
+    {NGL_NODE_UNIFORMUIVEC2, "value",  LIVECTL_TYPE_U32,   2},
+    {NGL_NODE_UNIFORMUIVEC3, "value",  LIVECTL_TYPE_U32,   3},
+    {NGL_NODE_UNIFORMUIVEC4, "value",  LIVECTL_TYPE_U32,   4},
+    {NGL_NODE_UNIFORMVEC2,   "value",  LIVECTL_TYPE_F32,   2},
+    {NGL_NODE_UNIFORMVEC3,   "value",  LIVECTL_TYPE_F32,   3},
+    {NGL_NODE_UNIFORMVEC4,   "value",  LIVECTL_TYPE_F32,   4},
+    {NGL_NODE_USERSELECT,    "branch", LIVECTL_TYPE_I32,   1},
+    {NGL_NODE_USERSWITCH,    "enabled",LIVECTL_TYPE_BOOL,  1},
+};
+
+static const struct livectl_spec *get_livectl_spec(uint32_t node_type)
+{
+    for (size_t i = 0; i < ARRAY_NB(livectl_specs); i++)
+        if (livectl_specs[i].node_type == node_type)
+            return &livectl_specs[i];
+    return NULL;
+}
+
+/* Parse a list of numbers separated by commas and/or spaces */
+static int parse_livectl_data(const char *str, const struct livectl_spec *spec,
+                              union ngl_livectl_data *data)
+{
+    const char *p = str;
+    for (size_t i = 0; i < spec->nb_comps; i++) {
+        char *end;
+        p += strspn(p, ", ");
+        switch (spec->type) {
+        /* f only holds 4 components, m covers the mat4 and aliases f */
+        case LIVECTL_TYPE_F32:  data->m[i] = strtof(p, &end);                    break;
+        case LIVECTL_TYPE_I32:
+        case LIVECTL_TYPE_BOOL: data->i[i] = (int32_t)strtol(p, &end, 0);        break;
+        case LIVECTL_TYPE_U32:  data->u[i] = (uint32_t)strtoul(p, &end, 0);      break;
+        default:                return -1;
+        }
+        if (end == p)
+            return -1;
+        p = end;
+    }
+    p += strspn(p, ", ");
+    return *p ? -1 : 0;
+}
+
+static int set_livectl(const struct ngl_livectl *ctl, const struct livectl_spec *spec, const char *value)
+{
+    struct ngl_node *node = ctl->node;
+    const char *key = spec->key;
+
+    if (spec->type == LIVECTL_TYPE_STR)
+        return ngl_node_param_set_str(node, key, value);
+
+    union ngl_livectl_data data = {0};
+    if (parse_livectl_data(value, spec, &data) < 0)
+        return NGL_ERROR_INVALID_ARG;
+
+    switch (spec->type) {
+    case LIVECTL_TYPE_BOOL:
+        return ngl_node_param_set_bool(node, key, data.i[0]);
+    case LIVECTL_TYPE_F32:
+        switch (spec->nb_comps) {
+        case 1:  return ngl_node_param_set_f32(node, key, data.f[0]);
+        case 2:  return ngl_node_param_set_vec2(node, key, data.f);
+        case 3:  return ngl_node_param_set_vec3(node, key, data.f);
+        case 4:  return ngl_node_param_set_vec4(node, key, data.f);
+        default: return ngl_node_param_set_mat4(node, key, data.m);
+        }
+    case LIVECTL_TYPE_I32:
+        switch (spec->nb_comps) {
+        case 1:  return ngl_node_param_set_i32(node, key, data.i[0]);
+        case 2:  return ngl_node_param_set_ivec2(node, key, data.i);
+        case 3:  return ngl_node_param_set_ivec3(node, key, data.i);
+        default: return ngl_node_param_set_ivec4(node, key, data.i);
+        }
+    case LIVECTL_TYPE_U32:
+        switch (spec->nb_comps) {
+        case 1:  return ngl_node_param_set_u32(node, key, data.u[0]);
+        case 2:  return ngl_node_param_set_uvec2(node, key, data.u);
+        case 3:  return ngl_node_param_set_uvec3(node, key, data.u);
+        default: return ngl_node_param_set_uvec4(node, key, data.u);
+        }
+    default:
+        return NGL_ERROR_BUG;
+    }
+}
+
+/*
+ * Live controls are changed in place on the current scene instead of
+ * replacing it: only the targeted nodes are updated, all the other GPU
+ * resources and pipelines are kept as is. A failure is reported but does not
+ * stop the player.
+ */
+static int handle_livectl(struct player *p, const void *data)
+{
+    const char *livectl = data;
+    const char *value = strchr(livectl, '=');
+    if (!value)
+        return 0;
+    const size_t id_len = value - livectl;
+    value++;
+
+    for (size_t i = 0; i < p->nb_livectls; i++) {
+        const struct ngl_livectl *ctl = &p->livectls[i];
+        if (strlen(ctl->id) != id_len || memcmp(ctl->id, livectl, id_len))
+            continue;
+
+        const struct livectl_spec *spec = get_livectl_spec(ctl->node_type);
+        if (!spec) {
+            fprintf(stderr, "Live control '%s' type is not supported\n", ctl->id);
+            return 0;
+        }
+
+        int ret = set_livectl(ctl, spec, value);
+        if (ret < 0)
+            fprintf(stderr, "Unable to set live control '%s' to '%s'\n", ctl->id, value);
+        return 0;
+    }
+
+    fprintf(stderr, "Live control '%.*s' not found in the current scene\n", (int)id_len, livectl);
+    return 0;
+}
+
 typedef int (*handle_func)(struct player *p, const void *data);
 
 static const handle_func handle_map[] = {
@@ -565,6 +721,7 @@ static const handle_func handle_map[] = {
     [PLAYER_SIGNAL_CLEARCOLOR]   = handle_clearcolor,
     [PLAYER_SIGNAL_SAMPLES]      = handle_samples,
     [PLAYER_SIGNAL_RECONFIGURE]  = handle_reconfigure,
+    [PLAYER_SIGNAL_LIVECTL]      = handle_livectl,
 };
 
 void player_main_loop(struct player *p)
@@ -573,7 +730,10 @@ void player_main_loop(struct player *p)
     while (run) {
         update_time(p, -1);
         update_pgbar(p);
+        const int64_t draw_start = gettime_relative();
         ngl_draw(p->ngl, p->frame_time);
+        if (p->draw_callback)
+            p->draw_callback(p->draw_callback_arg, p->frame_time, gettime_relative() - draw_start);
         if (p->seeking) {
             reset_running_time(p);
             p->seeking = 0;
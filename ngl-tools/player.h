@@ -33,10 +33,11 @@
  * have the ability to batch multiple operations before doing a reconfigure.
  */
 enum player_signal {
-    PLAYER_SIGNAL_SCENE,
+    PLAYER_SIGNAL_SCENE, /* the data is a scene reference owned by the player */
     PLAYER_SIGNAL_CLEARCOLOR,
     PLAYER_SIGNAL_SAMPLES,
     PLAYER_SIGNAL_RECONFIGURE,
+    PLAYER_SIGNAL_LIVECTL,
 };
 
 struct player {
@@ -66,6 +67,12 @@ struct player {
     struct ngl_node *pgbar_opacity_node;
     struct ngl_node *pgbar_text_node;
     struct ngl_node *pgbar_duration_node;
+    struct ngl_livectl *livectls;
+    size_t nb_livectls;
+
+    /* optional, called after every draw with its duration in microseconds */
+    void (*draw_callback)(void *user_arg, double t, int64_t draw_time);
+    void *draw_callback_arg;
 };
 
 int player_init(struct player *p, const char *win_title, struct ngl_scene *scene,
@@ -21,7 +21,7 @@
 #
 
 from cpython cimport array
-from libc.stdint cimport int32_t, uint8_t, uint32_t, uintptr_t
+from libc.stdint cimport int32_t, int64_t, uint8_t, uint32_t, uint64_t, uintptr_t
 from libc.stdlib cimport calloc, free
 from libc.string cimport memset
 
@@ -169,6 +169,9 @@ cdef extern from "nopegl/nopegl.h":
         const char *hud_export_filename
         int hud_scale
         int debug
+        int gpu_timings
+        const char *trace_filename
+        int stats
 
     cdef union ngl_livectl_data:
         float f[4]
@@ -185,6 +188,29 @@ cdef extern from "nopegl/nopegl.h":
         ngl_livectl_data min
         ngl_livectl_data max
 
+    cdef struct ngl_gpu_timing:
+        uint32_t node_type
+        ngl_node *node
+        char *label
+        int32_t pass_ "pass"
+        int64_t time
+
+    cdef struct ngl_stats:
+        int64_t cpu_update_time
+        int64_t cpu_draw_time
+        int64_t gpu_draw_time
+        uint64_t nb_allocations
+        size_t nb_pipelines
+        size_t buffer_memory
+        size_t texture_memory
+
+    cdef int NGL_ERROR_NOT_FOUND
+    cdef int NGL_COLORSTATS_DEPTH
+
+    cdef struct ngl_colorstats:
+        double time
+        uint32_t histograms[256][4]
+
     ngl_ctx *ngl_create()
     int ngl_backends_probe(const ngl_config *user_config, size_t *nb_backendsp, ngl_backend **backendsp)
     int ngl_backends_get(const ngl_config *user_config, size_t *nb_backendsp, ngl_backend **backendsp)
@@ -200,6 +226,10 @@ cdef extern from "nopegl/nopegl.h":
     char *ngl_dot(ngl_ctx *s, double t) nogil
     int ngl_livectls_get(ngl_scene *scene, size_t *nb_livectlsp, ngl_livectl **livectlsp)
     void ngl_livectls_freep(ngl_livectl **livectlsp)
+    int ngl_gpu_timings_get(ngl_ctx *s, size_t *nb_timingsp, ngl_gpu_timing **timingsp)
+    void ngl_gpu_timings_freep(ngl_gpu_timing **timingsp)
+    int ngl_stats_get(ngl_ctx *s, ngl_stats *stats)
+    int ngl_colorstats_get(ngl_ctx *s, ngl_node *node, ngl_colorstats *stats)
     void ngl_freep(ngl_ctx **ss)
 
     int ngl_easing_evaluate(const char *name, const double *args, size_t nb_args,
@@ -665,6 +695,9 @@ cdef class Config:
         hud_export_filename,
         hud_scale,
         debug,
+        gpu_timings,
+        trace_filename,
+        stats,
     ):
         self.config.platform = platform.value
         self.config.backend = backend.value
@@ -693,6 +726,10 @@ cdef class Config:
             self.config.hud_export_filename = hud_export_filename
         self.config.hud_scale = hud_scale
         self.config.debug = debug
+        self.config.gpu_timings = gpu_timings
+        if trace_filename is not None:
+            self.config.trace_filename = trace_filename
+        self.config.stats = stats
 
     @property
     def cptr(self):
@@ -769,6 +806,49 @@ cdef class Context:
             s = ngl_dot(self.ctx, t)
         return _ret_pystr(s) if s else None
 
+    def get_gpu_timings(self):
+        cdef size_t nb_timings = 0
+        cdef ngl_gpu_timing *timings = NULL
+        cdef int ret = ngl_gpu_timings_get(self.ctx, &nb_timings, &timings)
+        if ret < 0:
+            raise Exception("Error getting the GPU timings")
+        gpu_timings = []
+        for i in range(nb_timings):
+            gpu_timings.append(
+                dict(
+                    label=timings[i].label,
+                    pass_index=timings[i].pass_,
+                    time=timings[i].time,
+                )
+            )
+        ngl_gpu_timings_freep(&timings)
+        return gpu_timings
+
+    def get_stats(self):
+        cdef ngl_stats stats
+        cdef int ret = ngl_stats_get(self.ctx, &stats)
+        if ret < 0:
+            raise Exception("Error getting the statistics")
+        return dict(
+            cpu_update_time=stats.cpu_update_time,
+            cpu_draw_time=stats.cpu_draw_time,
+            gpu_draw_time=stats.gpu_draw_time,
+            nb_allocations=stats.nb_allocations,
+            nb_pipelines=stats.nb_pipelines,
+            buffer_memory=stats.buffer_memory,
+            texture_memory=stats.texture_memory,
+        )
+
+    def get_colorstats(self, _Node node):
+        cdef ngl_colorstats stats
+        cdef int ret = ngl_colorstats_get(self.ctx, node.ctx, &stats)
+        if ret == NGL_ERROR_NOT_FOUND:
+            return None
+        if ret < 0:
+            raise Exception("Error getting the color stats")
+        histograms = [tuple(stats.histograms[i]) for i in range(NGL_COLORSTATS_DEPTH)]
+        return dict(time=stats.time, histograms=histograms)
+
     def __dealloc__(self):
         ngl_freep(&self.ctx)
 
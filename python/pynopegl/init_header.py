@@ -128,6 +128,9 @@ class Config(_ngl.Config):
         hud_export_filename: Optional[str] = None,
         hud_scale: int = 0,
         debug: bool = False,
+        gpu_timings: bool = False,
+        trace_filename: Optional[str] = None,
+        stats: bool = False,
     ):
         self.capture_buffer = capture_buffer
         super().__init__(
@@ -151,6 +154,9 @@ class Config(_ngl.Config):
             hud_export_filename,
             hud_scale,
             debug,
+            gpu_timings,
+            trace_filename,
+            stats,
         )
 
 
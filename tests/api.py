@@ -516,6 +516,22 @@ def api_shader_init_fail(width=320, height=240):
     assert ctx.draw(0) == 0
 
 
+def api_pipeline_prepare_fail(width=320, height=240):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+
+    # Valid pipelines are submitted for creation before the last draw fails
+    # to prepare, so they get released while potentially still being built
+    draws = [ngl.DrawColor(color=(i / 16, 0.5, 0.5), geometry=ngl.Quad()) for i in range(16)]
+    draws.append(ngl.Draw(ngl.Quad(), ngl.Program(vertex="<bug>", fragment="<bug>")))
+    scene = ngl.Scene.from_params(ngl.Group(children=draws))
+
+    assert ctx.set_scene(scene) != 0
+    assert ctx.set_scene(scene) != 0
+    assert ctx.draw(0) == 0
+
+
 def _create_trf(scene, start, end, prefetch_time=None):
     trf = ngl.TimeRangeFilter(scene, start, end)
     if prefetch_time is not None:
@@ -606,6 +622,112 @@ def api_dot(width=320, height=240):
     assert ctx.dot(1.0) is not None
 
 
+def api_stats(width=16, height=16):
+    """
+    Exercise the ngl.Context.get_stats() API: the scene resources must be
+    accounted while it is set, and released along with it
+    """
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend, stats=True))
+    assert ret == 0
+
+    # The context owns some resources on its own (render target, internal buffers)
+    ctx_stats = ctx.get_stats()
+    assert ctx_stats["nb_pipelines"] == 0
+
+    scene = _get_scene()
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0.0) == 0
+    stats = ctx.get_stats()
+    assert stats["nb_pipelines"] > 0
+    assert stats["buffer_memory"] > ctx_stats["buffer_memory"]
+
+    assert ctx.set_scene(None) == 0
+    assert ctx.draw(0.0) == 0
+    stats = ctx.get_stats()
+    assert stats["nb_pipelines"] == 0
+    assert stats["buffer_memory"] == ctx_stats["buffer_memory"]
+    assert stats["texture_memory"] == ctx_stats["texture_memory"]
+
+
+def api_colorstats(width=16, height=16):
+    """
+    Exercise the ngl.Context.get_colorstats() API with a source texture
+    changing size between frames, and analyzed with a subsampling
+    """
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+
+    # The source texture follows the size of the render target it is drawn into
+    subsample = 3
+    texture = ngl.Texture2D(data_src=ngl.DrawColor(color=(1, 0, 0)))
+    colorstats = ngl.ColorStats(texture=texture, subsample=subsample)
+    sizes = [(64, 32), (25, 10)]
+    switch_time = 4
+    rtt_0 = ngl.RenderToTexture(colorstats, [ngl.Texture2D(width=sizes[0][0], height=sizes[0][1])])
+    rtt_1 = ngl.RenderToTexture(colorstats, [ngl.Texture2D(width=sizes[1][0], height=sizes[1][1])])
+    root = ngl.Group(
+        children=[
+            ngl.TimeRangeFilter(rtt_0, end=switch_time),
+            ngl.TimeRangeFilter(rtt_1, start=switch_time),
+        ]
+    )
+    assert ctx.set_scene(ngl.Scene.from_params(root)) == 0
+    assert ctx.get_colorstats(colorstats) is None
+
+    # The statistics are read back asynchronously, a few frames later
+    stats_times = set()
+    for t in range(2 * switch_time):
+        assert ctx.draw(t) == 0
+        stats = ctx.get_colorstats(colorstats)
+        if stats is None:
+            continue
+        w, h = sizes[0] if stats["time"] < switch_time else sizes[1]
+        count = math.ceil(w / subsample) * math.ceil(h / subsample)
+        histograms = stats["histograms"]
+        assert len(histograms) == 256
+        assert histograms[0] == (0, count, count, 0)
+        assert histograms[255] == (count, 0, 0, 0)
+        assert sum(sum(bins) for bins in histograms) == 4 * count
+        stats_times.add(stats["time"])
+
+    assert any(t < switch_time for t in stats_times)
+    assert any(t >= switch_time for t in stats_times)
+
+
+def api_gpu_timings(width=16, height=16):
+    """
+    Exercise the ngl.Context.get_gpu_timings() API: the timings of the drawn
+    nodes and their render passes are reported a few frames later, and none
+    must remain once nothing is drawn anymore
+    """
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend, gpu_timings=True))
+    assert ret == 0
+
+    end_time = 4
+    draw = ngl.DrawColor(color=(1, 0, 0), label="draw")
+    rtt = ngl.RenderToTexture(draw, [ngl.Texture2D(width=width, height=height)], label="rtt")
+    scene = ngl.Scene.from_params(ngl.TimeRangeFilter(rtt, end=end_time))
+    assert ctx.set_scene(scene) == 0
+    assert ctx.get_gpu_timings() == []
+
+    # The timings are resolved asynchronously, a few frames later
+    timings = []
+    for t in range(end_time):
+        assert ctx.draw(t) == 0
+        timings = ctx.get_gpu_timings() or timings
+    entries = {(timing["label"], timing["pass_index"]) for timing in timings}
+    assert entries == {("rtt", -1), ("rtt", 0), ("draw", -1)}
+    assert all(timing["time"] >= 0 for timing in timings)
+
+    # Frames recording nothing must not report the timings of previous frames
+    for t in range(end_time, 2 * end_time):
+        assert ctx.draw(t) == 0
+    assert ctx.get_gpu_timings() == []
+
+
 def api_probing():
     """
     Exercise the probing APIs; the result is platform/hardware specific so
@@ -225,3 +225,13 @@ def path_open_and_effects(cfg: ngl.SceneCfg):
         glow=0.2,
         glow_color=(1, 0.5, 0),
     )
+
+
+@test_fingerprint(width=640, height=640)
+@ngl.scene()
+def path_multi_tiles(cfg: ngl.SceneCfg):
+    cfg.aspect_ratio = (1, 1)
+    # A large resolution splits the distance map of the shape into many tiles
+    keyframes = _get_overlap_shape0() + _get_overlap_shape1(clockwise=False)
+    path = ngl.Path(keyframes)
+    return ngl.DrawPath(path, viewbox=(0, 0, 10, 10), pt_size=128, outline=0.02, outline_color=(1, 0.5, 0))